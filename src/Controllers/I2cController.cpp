@@ -7,16 +7,22 @@ I2cController::I2cController(
     ITerminalView& terminalView,
     IInput& terminalInput,
     I2cService& i2cService,
+    SdService& sdService,
+    LittleFsService& littleFsService,
     ArgTransformer& argTransformer,
     UserInputManager& userInputManager,
+    I2cRegisterManager& i2cRegisterManager,
     I2cEepromShell& eepromShell,
     HelpShell& helpShell
 )
     : terminalView(terminalView),
       terminalInput(terminalInput),
       i2cService(i2cService),
+      sdService(sdService),
+      littleFsService(littleFsService),
       argTransformer(argTransformer),
       userInputManager(userInputManager),
+      i2cRegisterManager(i2cRegisterManager),
       eepromShell(eepromShell),
       helpShell(helpShell)
 {}
@@ -25,9 +31,9 @@ I2cController::I2cController(
 Entry point to handle I2C command
 */
 void I2cController::handleCommand(const TerminalCommand& cmd) {
-    if (cmd.getRoot() == "scan") handleScan();
+    if (cmd.getRoot() == "scan") handleScan(cmd);
     else if (cmd.getRoot() == "discovery") handleDiscover();
-    else if (cmd.getRoot() == "sniff") handleSniff();
+    else if (cmd.getRoot() == "sniff") handleSniff(cmd);
     else if (cmd.getRoot() == "ping") handlePing(cmd);
     else if (cmd.getRoot() == "identify") handleIdentify(cmd);
     else if (cmd.getRoot() == "write") handleWrite(cmd);
@@ -60,7 +66,16 @@ void I2cController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
 /*
 Scan
 */
-void I2cController::handleScan() {
+void I2cController::handleScan(const TerminalCommand& cmd) {
+    if (cmd.getSubcommand() == "fast") {
+        handleFastScan(cmd);
+        return;
+    }
+    if (!cmd.getSubcommand().empty()) {
+        terminalView.println("Usage: scan [fast [timeout_us] [sda:scl]...]");
+        return;
+    }
+
     terminalView.println("I2C Scan: Scanning I2C bus... Press [ENTER] to stop");
     terminalView.println("");
     bool found = false;
@@ -87,38 +102,264 @@ void I2cController::handleScan() {
     terminalView.println("");
 }
 
+void I2cController::handleFastScan(const TerminalCommand& cmd) {
+    const auto& forbidden = state.getProtectedPins();
+    std::vector<std::pair<uint8_t, uint8_t>> pairs; // sda, scl
+    uint32_t timeoutUs = 200;
+
+    // Optional clock stretch timeout and pin pairs
+    auto args = argTransformer.splitArgs(cmd.getArgs());
+    for (const auto& arg : args) {
+        size_t colon = arg.find(':');
+        if (colon == std::string::npos && argTransformer.isValidNumber(arg)) {
+            timeoutUs = argTransformer.parseHexOrDec32(arg);
+            continue;
+        }
+
+        std::string sdaStr = colon == std::string::npos ? "" : arg.substr(0, colon);
+        std::string sclStr = colon == std::string::npos ? "" : arg.substr(colon + 1);
+        if (!argTransformer.isValidNumber(sdaStr) || !argTransformer.isValidNumber(sclStr)) {
+            terminalView.println("Usage: scan fast [timeout_us] [sda:scl]...");
+            return;
+        }
+
+        uint8_t sda = argTransformer.parseHexOrDec(sdaStr);
+        uint8_t scl = argTransformer.parseHexOrDec(sclStr);
+        bool isProtected = std::find(forbidden.begin(), forbidden.end(), sda) != forbidden.end() ||
+                           std::find(forbidden.begin(), forbidden.end(), scl) != forbidden.end();
+        if (sda == scl || isProtected) {
+            terminalView.println("I2C Scan: Invalid pin pair " + arg + ".");
+            return;
+        }
+        pairs.emplace_back(sda, scl);
+    }
+    if (pairs.empty()) pairs.emplace_back(state.getI2cSdaPin(), state.getI2cSclPin());
+
+    terminalView.println("I2C Scan: Fast survey of " + std::to_string(pairs.size()) +
+                         " pin pair(s)... Press [ENTER] to stop\n");
+
+    bool cancelled = false;
+    for (const auto& pair : pairs) {
+        if (cancelled) break;
+        cancelled = fastScanPair(pair.first, pair.second, timeoutUs);
+    }
+
+    // Wire back on the configured pins
+    i2cService.configure(state.getI2cSdaPin(), state.getI2cSclPin(), state.getI2cFrequency());
+    terminalView.println(cancelled ? "I2C Scan: Cancelled by user.\n" : "");
+}
+
+bool I2cController::fastScanPair(uint8_t sda, uint8_t scl, uint32_t timeoutUs) {
+    terminalView.println("SDA=" + std::to_string(sda) + " SCL=" + std::to_string(scl));
+
+    i2cService.end();
+    i2cService.i2cProbeBegin(scl, sda);
+
+    // Rise time tells the clock the pull-ups can handle (I2C spec: 300 ns fast mode, 1000 ns standard)
+    uint32_t sclRise = i2cService.i2cProbeRiseTimeNs(scl);
+    uint32_t sdaRise = i2cService.i2cProbeRiseTimeNs(sda);
+    uint32_t rise = std::max(sclRise, sdaRise);
+    if (rise == UINT32_MAX) {
+        terminalView.println("  Bus stuck low or no pull-up, skipped.\n");
+        return false;
+    }
+
+    uint32_t halfPeriodUs = rise <= 300 ? 1 : rise <= 1000 ? 5 : 10;
+    terminalView.println("  Rise SCL " + std::to_string(sclRise) + " ns, SDA " + std::to_string(sdaRise) +
+                         " ns, probing at ~" + std::to_string(500 / halfPeriodUs) + " kHz");
+
+    std::vector<uint8_t> found;
+    bool stuck = false;
+    bool cancelled = false;
+    auto probeAll = [&](uint32_t halfUs) {
+        found.clear();
+        for (uint8_t addr = 1; addr < 0x7F && !stuck; ++addr) {
+            // Terminal is polled once per row, not per probe
+            if ((addr & 0x0F) == 0) {
+                char key = terminalInput.readChar();
+                if (key == '\r' || key == '\n') {
+                    cancelled = true;
+                    return;
+                }
+            }
+
+            auto result = i2cService.i2cProbeAddress(scl, sda, addr, halfUs, timeoutUs);
+            if (result == I2cService::ProbeResult::Ack) found.push_back(addr);
+            else if (result == I2cService::ProbeResult::Timeout) {
+                terminalView.println("  0x" + argTransformer.toHex(addr) + " held SCL longer than " +
+                                     std::to_string(timeoutUs) + " us");
+            }
+            else if (result == I2cService::ProbeResult::BusStuck) stuck = true;
+        }
+    };
+
+    probeAll(halfPeriodUs);
+
+    // Nothing at the fast clock, one more pass at standard mode
+    if (found.empty() && !stuck && !cancelled && halfPeriodUs < 5) {
+        terminalView.println("  No ACK, retrying at ~100 kHz");
+        probeAll(5);
+    }
+    if (cancelled) return true;
+    if (stuck) terminalView.println("  Bus stuck low during the scan.");
+
+    if (found.empty()) {
+        terminalView.println("  No I2C devices found.\n");
+        return false;
+    }
+
+    // Annotate with Wire on this pair, ping latency at the configured frequency
+    i2cService.configure(sda, scl, state.getI2cFrequency());
+    for (auto addr : found) {
+        uint32_t dt = 0;
+        (void)i2cService.ping(addr, true, &dt); // warmup
+        bool ok = i2cService.ping(addr, true, &dt);
+
+        terminalView.println("  Found device at 0x" + argTransformer.toHex(addr) +
+                             (ok ? "  ping " + std::to_string(dt) + " us" : "  no ACK with Wire"));
+        terminalView.print(identifyToString(addr, false));
+    }
+    terminalView.println("");
+    return false;
+}
+
 /*
 Sniff
 */    
-void I2cController::handleSniff() {
-    terminalView.println("I2C Sniffer: Listening on SCL/SDA... Press [ENTER] to stop.\n");
+void I2cController::handleSniff(const TerminalCommand& cmd) {
+    // Optional address filter
+    int filter = -1;
+    if (!cmd.getSubcommand().empty()) {
+        if (!argTransformer.isValidNumber(cmd.getSubcommand())) {
+            terminalView.println("Usage: sniff [addr]");
+            return;
+        }
+        filter = argTransformer.parseHexOrDec(cmd.getSubcommand()) & 0x7F;
+    }
+
+    // Records are saved unfiltered, with their timestamps
+    fs::File file;
+    bool onSd = false;
+    std::string path;
+    bool save = userInputManager.readYesNo("Save binary capture?", false);
+    if (save && !openSniffCapture(file, onSd, path)) return;
+
+    I2cCaptureTransformer capture;
+    if (save) {
+        capture.begin(state.getI2cSclPin(), state.getI2cSdaPin(), [&file](const uint8_t* data, size_t length) {
+            return file.write(data, length) == length;
+        });
+    }
+
     i2c_sniffer_begin(state.getI2cSclPin(), state.getI2cSdaPin()); // dont need freq to work
-    i2c_sniffer_setup();
+    if (!i2c_sniffer_setup()) {
+        terminalView.println("I2C Sniffer: Failed to start the sampler task.");
+        if (save) {
+            file.close();
+            if (onSd) sdService.end();
+        }
+        return;
+    }
 
-    std::string line;
+    i2c_sniffer_stats_t startStats;
+    i2c_sniffer_get_stats(&startStats);
+    if (!startStats.interrupts_masked) {
+        terminalView.println("I2C Sniffer: [WARN] WiFi is active, sampling can pause and miss bits at 400kHz.");
+    }
+
+    terminalView.println("I2C Sniffer: Listening on SCL/SDA... Press [ENTER] to stop.\n");
+
+    I2cTransactionTransformer decoder;
+    decoder.reset();
+    i2c_sniffer_record_t records[64];
+    uint32_t shown = 0;
+    uint32_t hidden = 0;
+    bool stopping = false;
 
     while (true) {
-        char key = terminalInput.readChar();
-        if (key == '\r' || key == '\n') break;
+        // After the stop, what is left in the ring is drained
+        if (!stopping) {
+            char key = terminalInput.readChar();
+            if (key == '\r' || key == '\n') {
+                i2c_sniffer_stop();
+                stopping = true;
+            }
+        }
 
-        while (i2c_sniffer_available()) {
-            char c = i2c_sniffer_read();
+        size_t n = i2c_sniffer_read_records(records, 64);
+        if (n == 0) {
+            if (stopping) break;
+            delayMicroseconds(100);
+            continue;
+        }
 
-            if (c == '\n') {
-                line += "  ";
-                terminalView.println(line);
-                line.clear();
-            } else {
-                line += c;
+        if (save) capture.feed(records, n);
+
+        for (size_t i = 0; i < n; ++i) {
+            if (!decoder.feed(records[i])) continue;
+
+            const auto& transaction = decoder.getTransaction();
+            if (filter >= 0 && !transaction.hasAddress(filter)) {
+                hidden++;
+                continue;
             }
+            terminalView.println(decoder.format(transaction));
+            shown++;
         }
-        delayMicroseconds(100);
     }
 
+    i2c_sniffer_stats_t stats;
+    i2c_sniffer_get_stats(&stats);
     i2c_sniffer_reset_buffer();
-    i2c_sniffer_stop();
     i2cService.configure(state.getI2cSdaPin(), state.getI2cSclPin(), state.getI2cFrequency());
     terminalView.println("\n\nI2C Sniffer: Stopped.");
+
+    if (save) {
+        bool written = capture.finish();
+        file.close();
+        if (onSd) sdService.end();
+        terminalView.println(written ? "  " + std::to_string(capture.getRecordCount()) + " records saved to " + path
+                                     : "  [WARN] Write failed, storage full? The capture is incomplete.");
+    }
+
+    // A capture is complete only without drops and stalls
+    terminalView.println("  Transactions: " + std::to_string(shown) +
+                         (filter >= 0 ? "  Filtered out: " + std::to_string(hidden) : std::string()));
+    terminalView.println("  Records: " + std::to_string(stats.records) +
+                         "  Dropped: " + std::to_string(stats.dropped) +
+                         "  Stalls: " + std::to_string(stats.stalls) +
+                         "  Sampling: " + std::to_string(stats.sample_rate_khz / 1000) + "." +
+                         std::to_string(stats.sample_rate_khz % 1000 / 100) + " MHz");
+    if (stats.dropped || stats.stalls) {
+        terminalView.println("  [WARN] Some bus events were missed, the capture is incomplete.");
+    }
+}
+
+bool I2cController::openSniffCapture(fs::File& file, bool& onSd, std::string& path) {
+    std::vector<std::string> targets = { "SD card", "LittleFS" };
+    onSd = userInputManager.readValidatedChoiceIndex("Save to", targets, 0) == 0;
+    path = "/" + userInputManager.readSanitizedString("File name", "i2c_capture") + ".bin";
+
+    if (onSd) {
+        // Open SD with SPI pin
+        auto sdMounted = sdService.configure(state.getSpiCLKPin(), state.getSpiMISOPin(),
+                                             state.getSpiMOSIPin(), state.getSpiCSPin());
+        if (!sdMounted) {
+            terminalView.println("I2C Sniffer: No SD card detected. Check SPI pins");
+            return false;
+        }
+        file = sdService.openFileWrite(path);
+    } else {
+        if (!littleFsService.mounted()) littleFsService.begin();
+        file = littleFsService.openWrite(path);
+    }
+
+    if (!file) {
+        terminalView.println("I2C Sniffer: Could not create " + path + ".");
+        if (onSd) sdService.end();
+        return false;
+    }
+    return true;
 }
 
 /*
@@ -377,14 +618,15 @@ Dump
 void I2cController::handleDump(const TerminalCommand& cmd) {
     // Validate sub
     if (!argTransformer.isValidNumber(cmd.getSubcommand())) {
-        terminalView.println("Usage: dump <addr> [length]");
+        terminalView.println("Usage: dump <addr> [length | ranges]");
+        terminalView.println("       ranges: 0x00-0x0F,0x3B-0x48");
         return;
     }
 
     // Parse addr
     uint8_t addr = argTransformer.parseHexOrDec(cmd.getSubcommand());
-    uint16_t start = 0x00;
-    uint16_t len = 256;
+    std::vector<I2cRegisterManager::Range> ranges = { { 0x00, 256 } };
+    bool masked = false;
 
     // Check I2C device presence
     i2cService.beginTransmission(addr);
@@ -393,137 +635,77 @@ void I2cController::handleDump(const TerminalCommand& cmd) {
         return;
     }
     
-    // Validate and parse arg
+    // Validate and parse arg, a length or register ranges
     auto args = argTransformer.splitArgs(cmd.getArgs());
-    if (args.size() >= 1 && argTransformer.isValidNumber(args[0])) {
-        len = argTransformer.parseHexOrDec16(args[0]);
+    if (!args.empty() && !parseRegisterArg(args[0], ranges, masked)) {
+        terminalView.println("I2C Dump: Invalid length or ranges '" + args[0] + "'.");
+        return;
     }
 
+    uint16_t start = ranges.front().start;
+    uint16_t len = ranges.back().start + ranges.back().length - start;
     std::vector<uint8_t> values(len, 0xFF);
     std::vector<bool> valid(len, false);
 
-    // Device registers are readable
-    if (i2cService.isReadableDevice(addr, start)) {
+    // Access method is probed once, then cached for the address
+    auto access = i2cRegisterManager.getAccess(addr, start);
+    if (access == I2cRegisterManager::Access::Register) {
         terminalView.println("I2C Dump: 0x" + argTransformer.toHex(addr) +
                              " from 0x" + argTransformer.toHex(start) +
                              " for " + std::to_string(len) + " bytes... Press [ENTER] to stop.\n");
-
-        performRegisterRead(addr, start, len, values, valid);
-
-    // Not readable
-    } else {
+    } else if (access == I2cRegisterManager::Access::Raw) {
         terminalView.println("I2C Dump: Device at 0x" + argTransformer.toHex(addr) +
                              " may not use standard register access — trying raw read...");
-
-        performRawRead(addr, start, len, values, valid);
     }
 
+    bool cancelled = false;
+    i2cRegisterManager.readRanges(addr, ranges, start, values, valid, [&]() {
+        char key = terminalInput.readChar();
+        cancelled = cancelled || key == '\r' || key == '\n';
+        return cancelled;
+    });
+    if (cancelled) terminalView.println("I2C Dump: Cancelled by user.");
+
     // Not able to read any data
     if (std::all_of(valid.begin(), valid.end(), [](bool b) { return !b; })) {
         terminalView.println("I2C Dump: Unable to read any data — device NACKed or unsupported protocol.\n");
         return;
     }
 
-    printHexDump(start, len, values, valid);
+    printHexDump(start, len, values, valid, masked);
 }
 
-void I2cController::performRegisterRead(uint8_t addr, uint16_t start, uint16_t len,
-                                        std::vector<uint8_t>& values, std::vector<bool>& valid) {
-    const uint8_t CHUNK_SIZE = 16;
-    const bool use16bitAddr = (start + len - 1) > 0xFF;
-    int consecutiveErrors = 0;
-
-    for (uint16_t offset = 0; offset < len; offset += CHUNK_SIZE) {
-        if (consecutiveErrors >= 3) {
-            terminalView.println("I2C Dump: Aborted after 3 consecutive errors.");
-            return;
-        }
-
-        uint16_t reg = start + offset;
-        uint8_t toRead = (offset + CHUNK_SIZE <= len) ? CHUNK_SIZE : (len - offset);
-
-        // Write register address (1 or 2 bytes)
-        i2cService.beginTransmission(addr);
-        if (use16bitAddr) {
-            i2cService.write((reg >> 8) & 0xFF); // MSB
-            i2cService.write(reg & 0xFF);        // LSB
-        } else {
-            i2cService.write((uint8_t)(reg & 0xFF));
-        }
-        bool writeOk = (i2cService.endTransmission(false) == 0);  // No stop
-        if (!writeOk) {
-            consecutiveErrors++;
-            continue;
-        }
-
-        // Read chunk
-        uint8_t received = i2cService.requestFrom(addr, toRead, true);
-        if (received == toRead) {
-            for (uint8_t i = 0; i < toRead; ++i) {
-                char key = terminalInput.readChar();
-                if (key == '\r' || key == '\n') {
-                    terminalView.println("I2C Dump: Cancelled by user.");
-                    return;
-                }
-
-                if (i2cService.available()) {
-                    values[offset + i] = i2cService.read();
-                    valid[offset + i] = true;
-                }
-            }
-            consecutiveErrors = 0;
-        } else {
-            while (i2cService.available()) i2cService.read();  // Flush
-            consecutiveErrors++;
-        }
-
-        delay(1);
-    }
-}
-
-void I2cController::performRawRead(uint8_t addr, uint16_t start,
-                                   uint16_t len,
-                                   std::vector<uint8_t>& values,
-                                   std::vector<bool>& valid) {
-    values.assign(len, 0xFF);
-    valid.assign(len, false);
-
-    terminalView.println("I2C Dump: Trying read raw...");
-
-    // Write start register
-    i2cService.beginTransmission(addr);
-    i2cService.write(start);
-    if (i2cService.endTransmission(false) != 0) {
-        return;  // NACK
+bool I2cController::parseRegisterArg(const std::string& arg, std::vector<I2cRegisterManager::Range>& ranges, bool& masked) {
+    // A plain number is a length from 0x00
+    if (arg.find_first_of("-,") == std::string::npos) {
+        if (!argTransformer.isValidNumber(arg)) return false;
+        uint16_t len = argTransformer.parseHexOrDec16(arg);
+        if (len == 0) return false;
+        ranges = { { 0x00, len } };
+        masked = false;
+        return true;
     }
 
-    // Read len from register addr
-    uint16_t received = i2cService.requestFrom(addr, (uint8_t)len, true);
-    for (uint16_t i = 0; i < received && i < len; ++i) {
-        auto key = terminalInput.readChar();
-        if (key == '\r' || key == '\n') {
-            terminalView.println("I2C Dump: Cancelled by user.");
-            return;
-        }
-        if (i2cService.available()) {
-            values[i] = i2cService.read();
-            valid[i] = true;
-        }
-    }
-
-    while (i2cService.available()) i2cService.read();
+    masked = true;
+    return I2cRegisterManager::parseRanges(arg, ranges);
 }
 
 void I2cController::printHexDump(uint16_t start, uint16_t len,
-                                 const std::vector<uint8_t>& values, const std::vector<bool>& valid) {
-    for (uint16_t lineStart = 0; lineStart < len; lineStart += 16) {
+                                 const std::vector<uint8_t>& values, const std::vector<bool>& valid, bool skipEmpty) {
+    for (uint32_t lineStart = 0; lineStart < len; lineStart += 16) {
+        // Lines out of the register ranges
+        if (skipEmpty && std::none_of(valid.begin() + lineStart, valid.begin() + std::min<uint32_t>(lineStart + 16, len),
+                                      [](bool b) { return b; })) {
+            continue;
+        }
+
         std::string line;
         char addrStr[8];
         snprintf(addrStr, sizeof(addrStr), "%02X:", start + lineStart);
         line += addrStr;
 
         for (uint8_t i = 0; i < 16; ++i) {
-            uint16_t idx = lineStart + i;
+            uint32_t idx = lineStart + i;
             if (idx < len) {
                 if (valid[idx]) {
                     char hex[4];
@@ -540,7 +722,7 @@ void I2cController::printHexDump(uint16_t start, uint16_t len,
         line += "  ";
 
         for (uint8_t i = 0; i < 16; ++i) {
-            uint16_t idx = lineStart + i;
+            uint32_t idx = lineStart + i;
             if (idx < len && valid[idx]) {
                 char c = values[idx];
                 line += (c >= 32 && c <= 126) ? c : '.';
@@ -725,18 +907,26 @@ Monitor
 */
 void I2cController::handleMonitor(const TerminalCommand& cmd) {
     if (!argTransformer.isValidNumber(cmd.getSubcommand())) {
-        terminalView.println("Usage: monitor <addr> [delay_ms]");
+        terminalView.println("Usage: monitor <addr> [delay_ms] [ranges]");
         return;
     }
 
     uint8_t addr = argTransformer.parseHexOrDec(cmd.getSubcommand());
-    uint16_t len = 256;
+    std::vector<I2cRegisterManager::Range> ranges = { { 0x00, 256 } };
     uint32_t delayMs = 500;
+    bool masked = false;
 
-    // Optional delay
+    // Optional delay and register ranges, in any order
     auto args = argTransformer.splitArgs(cmd.getArgs());
-    if (!args.empty() && argTransformer.isValidNumber(args[0])) {
-        delayMs = argTransformer.parseHexOrDec32(args[0]);
+    for (const auto& arg : args) {
+        if (arg.find_first_of("-,") != std::string::npos) {
+            if (!parseRegisterArg(arg, ranges, masked)) {
+                terminalView.println("I2C Monitor: Invalid ranges '" + arg + "'.");
+                return;
+            }
+        } else if (argTransformer.isValidNumber(arg)) {
+            delayMs = argTransformer.parseHexOrDec32(arg);
+        }
     }
 
     // Check device presence
@@ -746,53 +936,75 @@ void I2cController::handleMonitor(const TerminalCommand& cmd) {
         return;
     }
 
+    uint16_t start = ranges.front().start;
+    uint16_t len = ranges.back().start + ranges.back().length - start;
+    if (i2cRegisterManager.getAccess(addr, start) == I2cRegisterManager::Access::None) {
+        terminalView.println("I2C Monitor: Device at 0x" + argTransformer.toHex(addr) + " does not answer reads.");
+        return;
+    }
+
     terminalView.println("I2C Monitor: Monitoring register changes at 0x" + argTransformer.toHex(addr) + "... Press [ENTER] to stop.\n");
 
     std::vector<uint8_t> prev(len, 0xFF);
     std::vector<uint8_t> curr(len, 0xFF);
-    std::vector<bool> valid(len, false);
+    std::vector<bool> prevValid(len, false);
+    std::vector<bool> currValid(len, false);
+    std::vector<bool> bothValid(len, false);
+
+    // Poll faster while registers change, down to 10 ms, and slower while idle
+    const uint32_t minMs = std::min<uint32_t>(10, delayMs);
+    const uint32_t maxMs = std::max<uint32_t>(delayMs * 4, minMs);
+    uint32_t intervalMs = delayMs;
+    uint32_t polls = 0;
+    uint32_t changes = 0;
 
     // First read to initialize prev
-    if (i2cService.isReadableDevice(addr, 0x00)) {
-        performRegisterRead(addr, 0x00, len, prev, valid);
-    } else {
-        performRawRead(addr, 0x00, len, prev, valid);
-    }
+    i2cRegisterManager.readRanges(addr, ranges, start, prev, prevValid);
 
     while (true) {
-        // Try register read
-        if (i2cService.isReadableDevice(addr, 0x00)) {
-            performRegisterRead(addr, 0x00, len, curr, valid);
-        } else {
-            performRawRead(addr, 0x00, len, curr, valid);
+        std::fill(currValid.begin(), currValid.end(), false);
+        i2cRegisterManager.readRanges(addr, ranges, start, curr, currValid);
+        polls++;
+
+        for (uint16_t i = 0; i < len; ++i) bothValid[i] = prevValid[i] && currValid[i];
+        auto runs = i2cRegisterManager.findChanges(prev, curr, bothValid);
+
+        // One line per run of changed registers
+        for (const auto& run : runs) {
+            std::string before, after;
+            for (uint16_t i = run.start; i < run.start + run.length; ++i) {
+                before += argTransformer.toHex(prev[i]) + " ";
+                after += " " + argTransformer.toHex(curr[i]);
+            }
+
+            std::string regs = "0x" + argTransformer.toHex(start + run.start, start + len > 0x100 ? 4 : 2);
+            if (run.length > 1) {
+                regs += "-0x" + argTransformer.toHex(start + run.start + run.length - 1, start + len > 0x100 ? 4 : 2);
+            }
+            terminalView.println(regs + ": " + before + "->" + after);
+            changes += run.length;
         }
 
-        // Compare and show changes
         for (uint16_t i = 0; i < len; ++i) {
-            if (valid[i] && curr[i] != prev[i]) {
-                std::stringstream ss;
-                ss << "0x" << std::hex << std::uppercase << std::setw(2) << std::setfill('0') << i
-                   << ": 0x" << std::setw(2) << (int)prev[i]
-                   << " -> 0x" << std::setw(2) << (int)curr[i];
-                terminalView.println(ss.str());
-                prev[i] = curr[i];
-            }
+            if (currValid[i]) prev[i] = curr[i];
+            prevValid[i] = prevValid[i] || currValid[i];
         }
+        intervalMs = i2cRegisterManager.adaptInterval(intervalMs, !runs.empty(), minMs, maxMs);
 
         // Check for user input to stop
-        uint32_t elapsed = 0;
-        while (elapsed < delayMs) {
+        unsigned long waitStart = millis();
+        while (millis() - waitStart < intervalMs) {
             char key = terminalInput.readChar();
             if (key == '\r' || key == '\n') {
                 terminalView.println("\nI2C Monitor: Stopped by user.");
+                terminalView.println("  Polls: " + std::to_string(polls) +
+                                     "  Changed registers: " + std::to_string(changes) +
+                                     "  Last interval: " + std::to_string(intervalMs) + " ms");
                 return;
             }
-            delay(10);
-            elapsed += 10;
+            delay(std::min<uint32_t>(5, intervalMs));
         }
     }
-
-    terminalView.println("\nI2C Monitor: Stopped.");
 }
 
 /*
@@ -1079,16 +1291,33 @@ std::string I2cController::identifyToString(uint8_t address, bool includeHeader)
         ss << "\n\r 📟 I2C 0x" + argTransformer.toHex(address) + " Identification Result\n";
     }
 
-    bool matchFound = false;
-    for (size_t i = 0; i < i2cknownAddressesCount; ++i) {
-        if (i2cKnownAddresses[i].address == address) {
-            matchFound = true;
-            ss << "\r  ➤ Could be: - [" << i2cKnownAddresses[i].type << "] "
-               << i2cKnownAddresses[i].component << "\n";
+    // ID registers first, each register is read once for all the parts
+    std::vector<std::pair<uint8_t, int>> reads; // reg, value or -1
+    for (const auto& fp : i2cFingerprints) {
+        if (fp.address != address) continue;
+
+        auto it = std::find_if(reads.begin(), reads.end(), [&](const auto& r) { return r.first == fp.reg; });
+        if (it == reads.end()) {
+            uint8_t value = 0;
+            bool ok = i2cService.readReg(address, fp.reg, &value);
+            reads.emplace_back(fp.reg, ok ? value : -1);
+            it = reads.end() - 1;
         }
+
+        if (it->second >= 0 && ((uint8_t)it->second & fp.mask) == fp.value) {
+            ss << "\r  ➤ Identified: " << fp.component << " (reg 0x" << argTransformer.toHex(fp.reg)
+               << " = 0x" << argTransformer.toHex(it->second) << ")\n";
+            break;
+        }
+    }
+
+    auto devices = i2cKnownDevicesAt(address);
+    for (const auto& device : devices) {
+        ss << "\r  ➤ Could be: - [" << i2cKnownTypes[device.type] << "] "
+           << device.component << "\n";
     }
 
-    if (!matchFound) {
+    if (devices.empty()) {
         ss << "\r  ➤ No match found for address 0x" << argTransformer.toHex(address) << "\n";
     }
 
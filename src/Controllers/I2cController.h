@@ -6,11 +6,16 @@
 #include "Interfaces/ITerminalView.h"
 #include "Interfaces/IInput.h"
 #include "Services/I2cService.h"
+#include "Services/SdService.h"
+#include "Services/LittleFsService.h"
 #include "Models/TerminalCommand.h"
 #include "Models/ByteCode.h"
 #include "States/GlobalState.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/I2cRegisterManager.h"
+#include "Transformers/I2cTransactionTransformer.h"
+#include "Transformers/I2cCaptureTransformer.h"
 #include "Vendors/i2c_sniffer.h"
 #include "Shells/I2cEepromShell.h"
 #include "Shells/HelpShell.h"
@@ -19,7 +24,7 @@
 class I2cController {
 public:
     // Constructor
-    I2cController(ITerminalView& terminalView, IInput& terminalInput, I2cService& i2cService, ArgTransformer& argTransformer, UserInputManager& userInputManager, I2cEepromShell& eepromShell, HelpShell& helpShell);
+    I2cController(ITerminalView& terminalView, IInput& terminalInput, I2cService& i2cService, SdService& sdService, LittleFsService& littleFsService, ArgTransformer& argTransformer, UserInputManager& userInputManager, I2cRegisterManager& i2cRegisterManager, I2cEepromShell& eepromShell, HelpShell& helpShell);
 
     // Entry point for I2C command
     void handleCommand(const TerminalCommand& cmd);
@@ -58,8 +63,11 @@ private:
     ITerminalView& terminalView;
     IInput& terminalInput;
     I2cService& i2cService;
+    SdService& sdService;
+    LittleFsService& littleFsService;
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
+    I2cRegisterManager& i2cRegisterManager;
     I2cEepromShell& eepromShell;
     HelpShell& helpShell;
     GlobalState& state = GlobalState::getInstance();
@@ -69,10 +77,17 @@ private:
     void handlePing(const TerminalCommand& cmd);
 
     // Scan the I2C bus for devices
-    void handleScan();
+    void handleScan(const TerminalCommand& cmd);
 
-    // Start sniffing I2C traffic passively
-    void handleSniff();
+    // Quick address-only probes through bit bang, on one or more pin pairs
+    void handleFastScan(const TerminalCommand& cmd);
+    bool fastScanPair(uint8_t sda, uint8_t scl, uint32_t timeoutUs); // true if cancelled
+
+    // Start sniffing I2C traffic passively, one line per transaction
+    void handleSniff(const TerminalCommand& cmd);
+
+    // Open the binary capture file on SD or LittleFS
+    bool openSniffCapture(fs::File& file, bool& onSd, std::string& path);
 
     // Read data from an I2C device
     void handleRead(const TerminalCommand& cmd);
@@ -121,11 +136,10 @@ private:
 
     // Dump I2C registers content
     void handleDump(const TerminalCommand& cmd);
-    void performRegisterRead(uint8_t addr, uint16_t, uint16_t len,
-                            std::vector<uint8_t>& values, std::vector<bool>& valid);
-    void performRawRead(uint8_t addr, uint16_t, uint16_t len,
-                        std::vector<uint8_t>& values, std::vector<bool>& valid);
     void printHexDump(uint16_t, uint16_t len,
-                    const std::vector<uint8_t>& values, const std::vector<bool>& valid);
+                    const std::vector<uint8_t>& values, const std::vector<bool>& valid, bool skipEmpty = false);
+
+    // Length or register ranges argument of dump and monitor
+    bool parseRegisterArg(const std::string& arg, std::vector<I2cRegisterManager::Range>& ranges, bool& masked);
     std::string identifyToString(uint8_t address, bool includeHeader = false);
 };
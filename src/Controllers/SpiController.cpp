@@ -44,6 +44,13 @@ void SpiController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
         terminalView.println("SPI Read:\n");
         terminalView.println(result);
     }
+
+    // Wire throughput, only meaningful for bigger transfers
+    auto bytes = spiService.getLastByteCodeBytes();
+    if (bytes >= 64) {
+        terminalView.println("SPI Transfer: " + std::to_string(bytes) + " bytes, " +
+                             std::to_string(spiService.getLastByteCodeBytesPerSecond()) + " B/s\n");
+    }
 }
 
 /*
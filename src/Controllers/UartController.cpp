@@ -1,11 +1,11 @@
 #include "UartController.h"
-#include <map>
 
 /*
 Constructor
 */
 UartController::UartController(
     ITerminalView& terminalView,
+    IDeviceView& deviceView,
     IInput& terminalInput,
     IInput& deviceInput,
     UartService& uartService,
@@ -13,11 +13,14 @@ UartController::UartController(
     HdUartService& hdUartService,
     ArgTransformer& argTransformer,
     UserInputManager& userInputManager,
+    UartScanManager& uartScanManager,
+    YmodemManager& ymodemManager,
     UartAtShell& uartAtShell,
     HelpShell& helpShell,
     UartEmulationShell& uartEmulationShell
 )
     : terminalView(terminalView),
+      deviceView(deviceView),
       terminalInput(terminalInput),
       deviceInput(deviceInput),
       uartService(uartService),
@@ -25,6 +28,8 @@ UartController::UartController(
       hdUartService(hdUartService),
       argTransformer(argTransformer),
       userInputManager(userInputManager),
+      uartScanManager(uartScanManager),
+      ymodemManager(ymodemManager),
       uartAtShell(uartAtShell),
       helpShell(helpShell),
       uartEmulationShell(uartEmulationShell)
@@ -46,6 +51,7 @@ void UartController::handleCommand(const TerminalCommand& cmd) {
     else if (cmd.getRoot() == "spam") handleSpam(cmd);
     else if (cmd.getRoot() == "glitch") handleGlitch();
     else if (cmd.getRoot() == "xmodem") handleXmodem(cmd);
+    else if (cmd.getRoot() == "ymodem") handleYmodem(cmd);
     else if (cmd.getRoot() == "swap") handleSwap();
     else if (cmd.getRoot() == "config") handleConfig();
     else handleHelp();
@@ -73,27 +79,16 @@ void UartController::handleInstruction(const std::vector<ByteCode>& bytecodes) {
 Bridge
 */
 void UartController::handleBridge() {
+    bool stamped = userInputManager.readYesNo("Timestamp received lines?", false);
+
     terminalView.println("Uart Bridge: In progress... Press [ANY ESP32 BUTTON] to stop.\n");
-    while (true) {
-        // Read from UART and print to terminal
-        if (uartService.available()) {
-            char c = uartService.read();
-            terminalView.print(std::string(1, c));
-        }
+    unsigned long start = millis();
+    auto stats = runBridge(true, stamped, [this]() {
+        return deviceInput.readChar() != KEY_NONE;
+    });
 
-        // Read from user input and write to UART
-        char c = terminalInput.readChar();
-        if (c != KEY_NONE) {
-            uartService.write(c);
-        }
-        
-        // Read from device input and stop bridge if any
-        c = deviceInput.readChar();
-        if (c != KEY_NONE) {  
-            terminalView.println("\nUart Bridge: Stopped by user.");
-            break;
-        }
-    }
+    terminalView.println("\nUart Bridge: Stopped by user.");
+    printBridgeStats(stats, millis() - start);
 }
 
 /*
@@ -101,23 +96,144 @@ Read
 */
 void UartController::handleRead() {
     terminalView.println("UART Read: Streaming until [ENTER] is pressed...");
-    uartService.flush();
 
-    while (true) {
-        // Stop if ENTER is pressed
+    unsigned long start = millis();
+    auto stats = runBridge(false, false, [this]() {
         char key = terminalInput.readChar();
-        if (key == '\r' || key == '\n') {
-            terminalView.println("");
-            terminalView.println("UART Read: Stopped by user.");
-            break;
+        return key == '\r' || key == '\n';
+    });
+
+    terminalView.println("");
+    terminalView.println("UART Read: Stopped by user.");
+    printBridgeStats(stats, millis() - start);
+}
+
+UartController::BridgeStats UartController::runBridge(bool forwardInput, bool stamped, const std::function<bool()>& shouldStop) {
+    BridgeStats stats;
+
+    if (!startDriver()) return stats;
+
+    uint8_t chunk[512];
+    uint8_t typed[64];
+    bool lineStart = true;
+    unsigned long startMs = millis();
+    unsigned long lastRateMs = startMs;
+    uint32_t rxAtLastRate = 0;
+
+    while (!shouldStop()) {
+        // Blocks on the event queue, the core is free while the line is quiet
+        uart_event_t event;
+        if (uartService.waitEvent(event, 5)) {
+            switch (event.type) {
+                case UART_DATA: {
+                    size_t n;
+                    while ((n = uartService.readBuffered(chunk, sizeof(chunk))) > 0) {
+                        stats.rxBytes += n;
+                        writeReceived(chunk, n, stamped, lineStart, startMs);
+                    }
+                    terminalView.flush();
+                    break;
+                }
+                case UART_FIFO_OVF:
+                case UART_BUFFER_FULL:
+                    stats.overruns++;
+                    uartService.resetInput();
+                    if (stamped) writeMarker("[RX overrun]", lineStart);
+                    break;
+                case UART_BREAK:
+                    stats.breaks++;
+                    if (stamped) writeMarker("[BREAK]", lineStart);
+                    break;
+                case UART_FRAME_ERR:
+                case UART_PARITY_ERR:
+                    stats.errors++;
+                    break;
+                default:
+                    break;
+            }
         }
 
-        // Print UART data as it comes
-        while (uartService.available() > 0) {
-            char c = uartService.read();
-            terminalView.print(std::string(1, c));
+        // Typed keys go out in one write
+        if (forwardInput) {
+            size_t n = 0;
+            char c;
+            while (n < sizeof(typed) && (c = terminalInput.readChar()) != KEY_NONE) {
+                typed[n++] = c;
+            }
+            if (n) stats.txBytes += uartService.writeBuffered(typed, n);
+        }
+
+        // Live rate on the device screen, the terminal carries the data
+        unsigned long now = millis();
+        if (now - lastRateMs >= 1000) {
+            uint32_t rate = (uint64_t)(stats.rxBytes - rxAtLastRate) * 1000 / (now - lastRateMs);
+            std::string rateStr = rate >= 1024 ? std::to_string(rate / 1024) + " kB/s" : std::to_string(rate) + " B/s";
+            deviceView.topBar("RX " + rateStr + " OVF " + std::to_string(stats.overruns), false, false);
+            rxAtLastRate = stats.rxBytes;
+            lastRateMs = now;
         }
     }
+
+    stopDriver();
+    return stats;
+}
+
+bool UartController::startDriver() {
+    // The driver takes over the port, Serial1 comes back after
+    uartService.end();
+    if (!uartService.beginDriver(state.getUartBaudRate(), state.getUartConfig(),
+                                 state.getUartRxPin(), state.getUartTxPin(), state.isUartInverted())) {
+        terminalView.println("UART: Failed to start the UART driver.");
+        ensureConfigured();
+        return false;
+    }
+    return true;
+}
+
+void UartController::stopDriver() {
+    uartService.endDriver();
+    ensureConfigured();
+}
+
+void UartController::writeReceived(const uint8_t* data, size_t length, bool stamped, bool& lineStart, unsigned long startMs) {
+    if (!stamped) {
+        terminalView.writeBytes(data, length);
+        return;
+    }
+
+    // Each received line starts with the time since the bridge started
+    size_t from = 0;
+    for (size_t i = 0; i < length; ++i) {
+        if (lineStart) {
+            if (i > from) terminalView.writeBytes(data + from, i - from);
+            from = i;
+
+            unsigned long ms = millis() - startMs;
+            char stamp[20];
+            snprintf(stamp, sizeof(stamp), "[%6lu.%03lu] ", ms / 1000, ms % 1000);
+            terminalView.print(stamp);
+            lineStart = false;
+        }
+        if (data[i] == '\n') lineStart = true;
+    }
+    if (length > from) terminalView.writeBytes(data + from, length - from);
+}
+
+void UartController::writeMarker(const std::string& marker, bool& lineStart) {
+    if (!lineStart) terminalView.print("\r\n");
+    terminalView.print(marker + "\r\n");
+    lineStart = true;
+}
+
+void UartController::printBridgeStats(const BridgeStats& stats, unsigned long elapsedMs) {
+    if (elapsedMs == 0) elapsedMs = 1;
+    uint32_t rate = (uint64_t)stats.rxBytes * 1000 / elapsedMs;
+
+    terminalView.println("  RX " + std::to_string(stats.rxBytes) + " bytes (" + std::to_string(rate) + " B/s)" +
+                         " | TX " + std::to_string(stats.txBytes) + " bytes");
+    terminalView.println("  Overruns " + std::to_string(stats.overruns) +
+                         " | Breaks " + std::to_string(stats.breaks) +
+                         " | Frame/parity errors " + std::to_string(stats.errors));
 }
 
 /*
@@ -204,14 +320,11 @@ void UartController::handleScan() {
         protectedPins
     );
 
-    // Limit selection to 8 pins max
-    if (selectedPins.size() > 8) {
-        terminalView.println("Too many pins selected, limiting to first 8.");
-        selectedPins.resize(8);
+    // All pins are listened to at the same time
+    if (selectedPins.size() > UartScanManager::MAX_PINS) {
+        terminalView.println("Too many pins selected, limiting to first " + std::to_string(UartScanManager::MAX_PINS) + ".");
+        selectedPins.resize(UartScanManager::MAX_PINS);
     }
-    
-    // Accumulateur for activity
-    std::map<uint8_t, UartService::PinActivity> accum;
 
     terminalView.println("UART Scan: Measuring edges on pins... Press [ENTER] to stop.\n");
     terminalView.println("[INFO]");
@@ -220,8 +333,7 @@ void UartController::handleScan() {
     terminalView.println("  Pins showing activity are potential UART lines.");
     terminalView.println("");
     delay(300); // since the loop below is fast, the message above may not be seen without delay
-    
-    unsigned long lastPrint = millis();
+
     while (true) {
 
         // Stop if ENTER pressed
@@ -231,41 +343,25 @@ void UartController::handleScan() {
             break;
         }
 
-        // Measure activity for selected pins
-        auto results = uartService.scanUartActivity(selectedPins, 30, 10, true);
-
-        // Accumulate
-        for (auto& r : results) {
-            auto& a = accum[r.pin];
-            a.pin = r.pin;
-            a.edges += r.edges;
-            a.edgesPerSec += r.edgesPerSec;   // rough sum
-            if (r.approxBaud != 0)
-                a.approxBaud = r.approxBaud; // keep last valid
+        // One window on every selected pin, transmitting lines first
+        auto results = uartScanManager.scan(selectedPins, 250, true);
+        if (results.empty()) {
+            terminalView.println("UART Scan: Failed to attach pin interrupts.");
+            break;
         }
 
-        // Periodic accumulated report
-        unsigned long now = millis();
-        if (now - lastPrint >= 1000) {
-            lastPrint = now;
-
-            terminalView.println("Active pins:");
-
-            if (accum.empty()) {
-                terminalView.println("  (none)");
-            } else {
-                for (auto& [pin, r] : accum) {
-                    terminalView.println(
-                        "  GPIO " + std::to_string(pin) +
-                        " | edges=" + std::to_string(r.edges) +
-                        " | approxBaud=" + std::to_string(r.approxBaud)
-                    );
-                }
+        terminalView.println("Pins:");
+        for (const auto& r : results) {
+            std::string line = "  GPIO " + std::to_string(r.pin) +
+                               " | " + UartScanManager::stateToStr(r.state);
+            if (r.state == UartScanManager::LineState::Tx) {
+                line += " " + std::to_string(r.baud) + " baud" +
+                        " | confidence=" + std::to_string(r.confidencePct) + "%";
             }
-
-            terminalView.println("");
-            accum.clear();
+            if (r.edges) line += " | edges=" + std::to_string(r.edges);
+            terminalView.println(line);
         }
+        terminalView.println("");
     }
 }
 
@@ -284,11 +380,10 @@ void UartController::handleAutoBaud() {
             return;
         }
 
-        uint32_t baud = uartService.detectBaudByEdge(
+        uint32_t baud = uartScanManager.detectBaud(
             rxPin,
-            30,     // totalMs
-            10,    // windowMs
-            5,     // minEdges
+            250,  // windowMs
+            60,   // minConfidencePct
             true  // pullup
         );
 
@@ -507,6 +602,111 @@ void UartController::handleXmodemReceive(const std::string& path) {
     sdService.end();
 }
 
+/*
+Ymodem
+*/
+void UartController::handleYmodem(const TerminalCommand& cmd) {
+    std::string action = cmd.getSubcommand();
+    auto args = argTransformer.splitArgs(cmd.getArgs());
+
+    // Normalize paths
+    for (auto& path : args) {
+        if (path[0] != '/') path = "/" + path;
+    }
+
+    if (action == "recv") {
+        handleYmodemReceive(args.empty() ? "/" : args[0]);
+    } else if (action == "send" && !args.empty()) {
+        handleYmodemSend(args);
+    } else {
+        terminalView.println("Usage: ymodem recv [dir]");
+        terminalView.println("       ymodem send <path> [path...]");
+    }
+}
+
+void UartController::handleYmodemReceive(const std::string& dir) {
+    // Without ACK per block, only for links without errors
+    bool streaming = userInputManager.readYesNo("Stream (YMODEM-g)?", false);
+
+    auto sdMounted = sdService.configure(state.getSpiCLKPin(), state.getSpiMISOPin(),
+                    state.getSpiMOSIPin(), state.getSpiCSPin());
+    if (!sdMounted) {
+        terminalView.println("UART YMODEM: No SD card detected. Check SPI pins");
+        return;
+    }
+    if (!sdService.isDirectory(dir)) {
+        terminalView.println("UART YMODEM: Directory not found: " + dir);
+        sdService.end();
+        return;
+    }
+    if (!startDriver()) {
+        sdService.end();
+        return;
+    }
+
+    terminalView.println("UART YMODEM: Waiting for the sender for up to 1 minute... Press [ENTER] to stop.");
+    unsigned long start = millis();
+    auto result = ymodemManager.receiveBatch(dir, streaming,
+        [this](const std::string& name, uint32_t done, uint32_t total) {
+            std::string progress = total ? std::to_string((uint64_t)done * 100 / total) + "%" : std::to_string(done / 1024) + " kB";
+            deviceView.topBar("RX " + name + " " + progress, false, false);
+        },
+        [this]() {
+            char key = terminalInput.readChar();
+            return key == '\r' || key == '\n';
+        });
+
+    stopDriver();
+    sdService.end();
+    printYmodemResult(result, millis() - start);
+}
+
+void UartController::handleYmodemSend(const std::vector<std::string>& paths) {
+    auto sdMounted = sdService.configure(state.getSpiCLKPin(), state.getSpiMISOPin(),
+                    state.getSpiMOSIPin(), state.getSpiCSPin());
+    if (!sdMounted) {
+        terminalView.println("UART YMODEM: No SD card detected. Check SPI pins");
+        return;
+    }
+    for (const auto& path : paths) {
+        if (!sdService.isFile(path)) {
+            terminalView.println("UART YMODEM: File not found: " + path);
+            sdService.end();
+            return;
+        }
+    }
+    if (!startDriver()) {
+        sdService.end();
+        return;
+    }
+
+    terminalView.println("UART YMODEM: Waiting for the receiver for up to 1 minute... Press [ENTER] to stop.");
+    unsigned long start = millis();
+    auto result = ymodemManager.sendBatch(paths,
+        [this](const std::string& name, uint32_t done, uint32_t total) {
+            std::string progress = total ? std::to_string((uint64_t)done * 100 / total) + "%" : std::to_string(done / 1024) + " kB";
+            deviceView.topBar("TX " + name + " " + progress, false, false);
+        },
+        [this]() {
+            char key = terminalInput.readChar();
+            return key == '\r' || key == '\n';
+        });
+
+    stopDriver();
+    sdService.end();
+    printYmodemResult(result, millis() - start);
+}
+
+void UartController::printYmodemResult(const YmodemManager::Result& result, unsigned long elapsedMs) {
+    uint32_t rate = elapsedMs ? (uint64_t)result.bytes * 1000 / elapsedMs : 0;
+
+    terminalView.println("");
+    terminalView.println(result.ok ? "UART YMODEM: Batch complete" : "UART YMODEM: Failed, " + result.error);
+    terminalView.println("  Files: " + std::to_string(result.files) +
+                         "  Bytes: " + std::to_string(result.bytes) +
+                         "  Rate: " + std::to_string(rate) + " B/s");
+}
+
 /*
 Config
 */
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <string>
+#include <functional>
 #include "HardwareSerial.h"
 #include "Models/TerminalCommand.h"
 #include "Models/ByteCode.h"
@@ -9,10 +10,13 @@
 #include "Services/HdUartService.h"
 #include "Services/SdService.h"
 #include "Interfaces/ITerminalView.h"
+#include "Interfaces/IDeviceView.h"
 #include "Interfaces/IInput.h"
 #include "States/GlobalState.h"
 #include "Transformers/ArgTransformer.h"
 #include "Managers/UserInputManager.h"
+#include "Managers/UartScanManager.h"
+#include "Managers/YmodemManager.h"
 #include "Shells/UartAtShell.h"
 #include "Shells/HelpShell.h"
 #include "Shells/UartEmulationShell.h"
@@ -21,6 +25,7 @@ class UartController {
 public:
     // Constructor
     UartController(ITerminalView& terminalView, 
+                   IDeviceView& deviceView,
                    IInput& terminalInput,
                    IInput& deviceInput,
                    UartService& uartService, 
@@ -28,6 +33,8 @@ public:
                    HdUartService& hdUartService, 
                    ArgTransformer& argTransformer,
                    UserInputManager& userInputManager,
+                   UartScanManager& uartScanManager,
+                   YmodemManager& ymodemManager,
                    UartAtShell& uartAtShell,
                    HelpShell& helpShell,
                    UartEmulationShell& uartEmulationShell);
@@ -47,6 +54,20 @@ private:
     
     // Perform a simple read
     void handleRead();
+
+    struct BridgeStats {
+        uint32_t rxBytes = 0;
+        uint32_t txBytes = 0;
+        uint32_t overruns = 0;
+        uint32_t breaks = 0;
+        uint32_t errors = 0;
+    };
+
+    // Move UART data in chunks through the driver events until stopped
+    BridgeStats runBridge(bool forwardInput, bool stamped, const std::function<bool()>& shouldStop);
+    void writeReceived(const uint8_t* data, size_t length, bool stamped, bool& lineStart, unsigned long startMs);
+    void writeMarker(const std::string& marker, bool& lineStart);
+    void printBridgeStats(const BridgeStats& stats, unsigned long elapsedMs);
     
     // Send probes to get a response
     void handlePing();
@@ -87,10 +108,21 @@ private:
     // Send file to xmodem
     void handleXmodemSend(const std::string& path);
 
+    // Ymodem batch transfers, through the UART driver
+    void handleYmodem(const TerminalCommand& cmd);
+    void handleYmodemReceive(const std::string& dir);
+    void handleYmodemSend(const std::vector<std::string>& paths);
+    void printYmodemResult(const YmodemManager::Result& result, unsigned long elapsedMs);
+
+    // IDF driver in place of Serial1, with the current config
+    bool startDriver();
+    void stopDriver();
+
     // Handle UART emulation shell
     void handleEmulation();
 
     ITerminalView& terminalView;
+    IDeviceView& deviceView;
     IInput& terminalInput;
     IInput& deviceInput;
     UartService& uartService;
@@ -98,6 +130,8 @@ private:
     HdUartService& hdUartService;
     ArgTransformer& argTransformer;
     UserInputManager& userInputManager;
+    UartScanManager& uartScanManager;
+    YmodemManager& ymodemManager;
     UartAtShell& uartAtShell;
     HelpShell& helpShell;
     UartEmulationShell& uartEmulationShell;
@@ -8,8 +8,14 @@ UtilityController::UtilityController(
     IDeviceView& deviceView,
     IInput& terminalInput,
     PinService& pinService,
+    LogicAnalyzerService& logicAnalyzerService,
+    AnalogCaptureService& analogCaptureService,
+    SdService& sdService,
+    LittleFsService& littleFsService,
+    SumpServer& sumpServer,
     UserInputManager& userInputManager,
     PinAnalyzeManager& pinAnalyzeManager,
+    PinSurveyManager& pinSurveyManager,
     ArgTransformer& argTransformer,
     SysInfoShell& sysInfoShell,
     GuideShell& guideShell,
@@ -19,8 +25,14 @@ UtilityController::UtilityController(
       deviceView(deviceView),
       terminalInput(terminalInput),
       pinService(pinService),
+      logicAnalyzerService(logicAnalyzerService),
+      analogCaptureService(analogCaptureService),
+      sdService(sdService),
+      littleFsService(littleFsService),
+      sumpServer(sumpServer),
       userInputManager(userInputManager),
       pinAnalyzeManager(pinAnalyzeManager),
+      pinSurveyManager(pinSurveyManager),
       argTransformer(argTransformer),
       sysInfoShell(sysInfoShell),
       guideShell(guideShell),
@@ -217,195 +229,687 @@ void UtilityController::handleEnablePullups() {
 Logic
 */
 void UtilityController::handleLogicAnalyzer(const TerminalCommand& cmd) {
+    static constexpr uint8_t maxZoom = 6; // 2^6 samples per column
 
-    uint16_t tDelay = 500;
-    uint16_t inc = 100; // tDelay will be decremented/incremented by inc
-    uint8_t step = 1; // step of the trace display kind of a zoom
-
-    if (cmd.getSubcommand().empty() || !argTransformer.isValidNumber(cmd.getSubcommand())) {
-        terminalView.println("Usage: logic <pin>");
+    if (cmd.getSubcommand() == "sump") {
+        handleLogicSump(cmd);
         return;
     }
 
-    // Verify protected pin
-    uint8_t pin = argTransformer.toUint8(cmd.getSubcommand());
-    /*
-    auto forbidden = state.getProtectedPins();
-    if (std::find(forbidden.begin(), forbidden.end(), pin) != forbidden.end()) {
-        terminalView.println("Logic Analyzer: This pin is protected or reserved.");
+    if (cmd.getSubcommand() == "record") {
+        handleLogicRecord(cmd);
         return;
     }
-*/
-    if (state.isPinProtected(pin)) {
-        terminalView.println("Logic Analyzer: This pin is protected or reserved.");
+
+    if (cmd.getSubcommand().empty() || !argTransformer.isValidNumber(cmd.getSubcommand())) {
+        terminalView.println("Usage: logic <pin> [pin2 ... pin8]");
+        terminalView.println("       logic sump <pin> [pin2 ... pin8]");
+        terminalView.println("       logic record <pin> [pin2 ... pin8]");
         return;
     }
-    terminalView.println("\nLogic Analyzer: Monitoring pin " + std::to_string(pin) + "... Press [ENTER] to stop.");
-    terminalView.println("Displaying waveform on the ESP32 screen...\n");
 
+    // Collect pins, up to 8 channels sampled together
+    std::vector<uint8_t> pins;
+    std::vector<std::string> tokens = argTransformer.splitArgs(cmd.getArgs());
+    tokens.insert(tokens.begin(), cmd.getSubcommand());
+    if (!parseLogicPins(tokens, pins)) return;
 
-    pinService.setInput(pin);
-    std::vector<uint8_t> buffer;
-    buffer.reserve(320); // 320 samples
+    size_t rateIndex = 5; // 1 MHz
+    while (LOGIC_RATES[rateIndex] > LogicAnalyzerService::getMaxSampleRate()) rateIndex--;
+    uint8_t zoom = 0; // samples per column = 1 << zoom
+    uint8_t shown = 0; // channel drawn on the device screen
+
+    if (!logicAnalyzerService.configure(pins, LOGIC_RATES[rateIndex])) {
+        terminalView.println("Logic Analyzer: Not enough memory for the capture buffer.");
+        return;
+    }
+
+    std::string pinList;
+    for (auto pin : pins) pinList += " " + std::to_string(pin);
+    terminalView.println("\nLogic Analyzer: Sampling pins" + pinList + " at " +
+                         std::to_string(LOGIC_RATES[rateIndex] / 1000) + " kHz... Press [ENTER] to stop.");
+    terminalView.println("Buffer: " + std::to_string(logicAnalyzerService.getCapacity() / 1024) + " KB" +
+                         (logicAnalyzerService.isInPsram() ? " (PSRAM)" : "") +
+                         ", [s/S] rate, [z/Z] zoom, [c] screen channel, [t] trigger, [l] long capture.");
+    terminalView.println("Displaying waveform on the ESP32 screen...\n");
 
-    unsigned long lastCheck = millis();
     deviceView.clear();
     deviceView.topBar("Logic Analyzer", false, false);
 
+    bool serialTrace = state.getTerminalMode() == TerminalTypeEnum::Serial;
+    auto moveBelowTrace = [&]() {
+        if (serialTrace) terminalView.print(std::string(pins.size() + 1, '\n') + "\r");
+    };
+
+    CaptureTrigger trigger;
+    bool armed = false;
+    uint8_t prePercent = 25;
+
     while (true) {
-        // Enter press
-        if (millis() - lastCheck > 10) {
-            lastCheck = millis();
-            char c = terminalInput.readChar();
-            if (c == '\r' || c == '\n') {
-                // fdufnews 2025/10/24 added to restore cursor position when leaving
-                if (state.getTerminalMode() == TerminalTypeEnum::Serial)
-                    terminalView.print("\n\n\n\n\r"); // 4 lines down to place cursor just under the logic trace
-                terminalView.println("Logic Analyzer: Stopped by user.");
-                break;
+        char c = terminalInput.readChar();
+        if (c == '\r' || c == '\n') {
+            // Place the cursor just under the traces
+            moveBelowTrace();
+            terminalView.println("Logic Analyzer: Stopped by user.");
+            break;
+        }
+
+        std::string status;
+        if (c == 's' && rateIndex > 0) rateIndex--;
+        if (c == 'S' && rateIndex + 1 < LOGIC_RATE_COUNT && LOGIC_RATES[rateIndex + 1] <= LogicAnalyzerService::getMaxSampleRate()) rateIndex++;
+        if (c == 's' || c == 'S') {
+            logicAnalyzerService.setSampleRate(LOGIC_RATES[rateIndex]);
+            status = "rate : " + std::to_string(LOGIC_RATES[rateIndex] / 1000) + " kHz";
+        }
+        if (c == 'z' && zoom < maxZoom) zoom++;
+        if (c == 'Z' && zoom > 0) zoom--;
+        if (c == 'z' || c == 'Z') status = "zoom : " + std::to_string(1 << zoom) + " samples/px";
+        if (c == 'c') {
+            shown = (shown + 1) % pins.size();
+            status = "screen : pin " + std::to_string(pins[shown]);
+        }
+        if (!status.empty()) {
+            moveBelowTrace();
+            terminalView.println(status + "\n");
+        }
+        if (c == 't') {
+            moveBelowTrace();
+            armed = readLogicTrigger(pins, LOGIC_RATES[rateIndex], trigger, prePercent);
+        }
+        if (c == 'l') {
+            moveBelowTrace();
+            browseLogicLong(pins, shown);
+        }
+
+        size_t perColumn = 1u << zoom;
+        size_t frame = LOGIC_SCREEN_COLUMNS * perColumn;
+
+        // Free run, one frame worth of samples captured in parallel for all pins
+        if (!armed) {
+            logicAnalyzerService.clear();
+            logicAnalyzerService.capture(frame);
+            drawLogicCapture(pins, shown, 0, perColumn, 0, SIZE_MAX, true);
+            continue;
+        }
+
+        // Triggered, sampling runs alone until the capture is frozen
+        size_t pre = frame * prePercent / 100;
+        terminalView.println("Armed: " + CaptureTriggerEnumMapper::toString(trigger.getType()) +
+                             ", " + std::to_string(prePercent) + "% pre-trigger. Press any key to cancel.");
+        terminalView.flush();
+
+        bool fired = logicAnalyzerService.captureTriggered(trigger, pre, frame - pre - 1, [&]() {
+            return terminalInput.readChar() != KEY_NONE;
+        });
+        if (!fired) {
+            armed = false;
+            terminalView.println("Trigger cancelled, free running.\n");
+            continue;
+        }
+
+        // Render only once the capture is frozen
+        drawLogicCapture(pins, shown, 0, perColumn, logicAnalyzerService.getTriggerIndex(), logicAnalyzerService.getTriggerIndex(), false);
+        terminalView.println("Triggered. [t] re-arm, [f] free run, [w] save, [ENTER] exit, any other key same trigger.");
+
+        char next;
+        while (true) {
+            while ((next = terminalInput.readChar()) == KEY_NONE) delay(10);
+            if (next != 'w') break;
+            saveLogicCapture();
+            terminalView.println("[t] re-arm, [f] free run, [ENTER] exit, any other key same trigger.");
+        }
+        if (next == '\r' || next == '\n') {
+            terminalView.println("Logic Analyzer: Stopped by user.");
+            break;
+        }
+        if (next == 'f') armed = false;
+        if (next == 't') armed = readLogicTrigger(pins, LOGIC_RATES[rateIndex], trigger, prePercent);
+    }
+
+    logicAnalyzerService.end();
+}
+
+void UtilityController::drawLogicCapture(const std::vector<uint8_t>& pins, uint8_t shown, size_t origin, size_t perColumn,
+                                         size_t center, size_t triggerIndex, bool live, const RleCaptureStore* store) {
+    std::vector<uint8_t> columns;
+    columns.reserve(LOGIC_SCREEN_COLUMNS);
+
+    auto decimate = [&](uint8_t channel, size_t start, size_t length, size_t width) {
+        if (store) store->decimate(channel, start, length, width, columns);
+        else logicAnalyzerService.decimate(channel, start, length, width, columns);
+    };
+
+    // Device screen, one channel over the whole frame
+    decimate(shown, origin, LOGIC_SCREEN_COLUMNS * perColumn, LOGIC_SCREEN_COLUMNS);
+    deviceView.drawLogicTrace(pins[shown], columns, 1);
+
+    // The poor man's drawLogicTrace() on terminal, one line per pin
+    if (state.getTerminalMode() != TerminalTypeEnum::Serial) return;
+
+    // Window keeps the trigger at the same relative place as on the screen
+    size_t visible = LOGIC_TERMINAL_COLUMNS * perColumn;
+    size_t offset = (center - origin) * LOGIC_TERMINAL_COLUMNS / LOGIC_SCREEN_COLUMNS;
+    size_t start = center > offset ? center - offset : 0;
+
+    std::string out = "\r\n";
+    for (size_t ch = 0; ch < pins.size(); ++ch) {
+        decimate(ch, start, visible, LOGIC_TERMINAL_COLUMNS);
+        std::string line = (pins[ch] < 10 ? "GPIO " : "GPIO") + std::to_string(pins[ch]) + " ";
+        for (auto level : columns) line += level ? '-' : '_';
+        out += line + "\r\n";
+    }
+
+    if (live) {
+        out += "\x1b[" + std::to_string(pins.size() + 1) + "A"; // back up for the next draw
+    } else if (triggerIndex != SIZE_MAX && triggerIndex >= start && triggerIndex - start < visible) {
+        out += std::string(7 + (triggerIndex - start) / perColumn, ' ') + "^ trigger\r\n";
+    }
+    terminalView.print(out);
+}
+
+bool UtilityController::readLogicTrigger(const std::vector<uint8_t>& pins, uint32_t sampleRate,
+                                         CaptureTrigger& trigger, uint8_t& prePercent) {
+    static const std::vector<std::string> types = {
+        "None (free run)", "Rising edge", "Falling edge", "Any edge", "Level", "Pattern", "Pulse width"
+    };
+
+    terminalView.println("");
+    int type = userInputManager.readValidatedChoiceIndex("Trigger type", types, 1);
+    if (type <= 0) {
+        trigger = CaptureTrigger();
+        terminalView.println("Trigger off, free running.\n");
+        return false;
+    }
+
+    // Single channel triggers
+    uint8_t channel = 0;
+    if (type != 5 && pins.size() > 1) {
+        std::vector<std::string> names;
+        for (auto pin : pins) names.push_back("GPIO " + std::to_string(pin));
+        channel = userInputManager.readValidatedChoiceIndex("Trigger pin", names, 0);
+    }
+    uint16_t mask = 1u << channel;
+
+    switch (type) {
+        case 1: trigger = CaptureTrigger(CaptureTriggerEnum::Rising, mask); break;
+        case 2: trigger = CaptureTrigger(CaptureTriggerEnum::Falling, mask); break;
+        case 3: trigger = CaptureTrigger(CaptureTriggerEnum::AnyEdge, mask); break;
+        case 4: {
+            uint8_t level = userInputManager.readValidatedUint8("Level (0/1)", 1, 0, 1);
+            trigger = CaptureTrigger(CaptureTriggerEnum::Level, mask, level ? mask : 0);
+            break;
+        }
+        case 5: {
+            // One character per pin, in the order given to the command
+            std::string pattern = userInputManager.readSanitizedString(
+                "Pattern, one of 0/1/x per pin", std::string(pins.size(), 'x'));
+            uint16_t patternMask = 0, patternValue = 0;
+            for (size_t i = 0; i < pins.size() && i < pattern.size(); ++i) {
+                if (pattern[i] == '0' || pattern[i] == '1') patternMask |= 1u << i;
+                if (pattern[i] == '1') patternValue |= 1u << i;
             }
-            if (c == 's'){
-                if (tDelay > inc){
-                    tDelay -= inc;
-                    terminalView.println("delay : " + std::to_string(tDelay) + "\n");
-                }
-            };
-            if (c == 'S'){
-                if (tDelay < 10000){
-                    tDelay += inc;
-                    terminalView.println("delay : " + std::to_string(tDelay) + "\n");
-                }
-            };
-            if (c == 'z'){
-                if (step > 1){
-                    step--;
-                    terminalView.println("step : " + std::to_string(step) + "\n");
-                }
-            };
-            if (c == 'Z'){
-                if (step < 4){
-                    step++;
-                    terminalView.println("step : " + std::to_string(step) + "\n");
-                }
-            };
-        }
-
-        // Draw
-        if (buffer.size() >= 320) {
-            buffer.resize(320);
-            deviceView.drawLogicTrace(pin, buffer, step);
-
-            // The poor man's drawLogicTrace() on terminal
-            // draws a 132 samples sub part of the buffer to speed up the things
-            if (state.getTerminalMode() == TerminalTypeEnum::Serial){
-                terminalView.println("");
-                uint8_t pos = 0;
-                for(size_t i = 0; i < 132; i++, pos++){
-                     terminalView.print(buffer[i]?"-":"_");
-                }
-                terminalView.print("\r\x1b[A");  // Up 1 line to put cursor at the correct place for the next draw
+            if (!patternMask) {
+                terminalView.println("Pattern has no 0/1, trigger off.\n");
+                return false;
             }
-            buffer.clear();
+            trigger = CaptureTrigger(CaptureTriggerEnum::Pattern, patternMask, patternValue);
+            break;
         }
+        case 6: {
+            uint8_t level = userInputManager.readValidatedUint8("Pulse level (0/1)", 1, 0, 1);
+            uint32_t minUs = userInputManager.readValidatedUint32("Min width (us)", 1);
+            uint32_t maxUs = userInputManager.readValidatedUint32("Max width (us, 0 = no limit)", 0);
 
-        buffer.push_back(pinService.read(pin));
-        delayMicroseconds(tDelay);
+            // Widths are counted in samples by the trigger
+            uint32_t minSamples = std::max<uint64_t>(1, (uint64_t)minUs * sampleRate / 1000000ULL);
+            uint32_t maxSamples = maxUs ? std::max<uint64_t>(minSamples, (uint64_t)maxUs * sampleRate / 1000000ULL) : UINT32_MAX;
+            trigger = CaptureTrigger(CaptureTriggerEnum::PulseWidth, mask, level ? mask : 0, minSamples, maxSamples);
+            break;
+        }
     }
+
+    prePercent = userInputManager.readValidatedUint8("Pre-trigger %", prePercent, 0, 99);
+    return true;
+}
+
+void UtilityController::browseLogicLong(const std::vector<uint8_t>& pins, uint8_t shown) {
+    uint32_t rate = logicAnalyzerService.getSampleRate();
+    uint32_t ms = userInputManager.readValidatedUint32("Duration in ms", 2000);
+    size_t total = std::max<size_t>(1, (uint64_t)rate * ms / 1000);
+
+    terminalView.println("\nLong capture: " + std::to_string(total) + " samples, only transitions are kept. Press any key to stop.");
+    terminalView.flush();
+
+    size_t taken = logicAnalyzerService.captureRle(total, [&]() {
+        return terminalInput.readChar() != KEY_NONE;
+    });
+    const RleCaptureStore& store = logicAnalyzerService.getRleStore();
+    if (taken == 0) return;
+
+    terminalView.println("Long capture: " + std::to_string(taken) + " samples in " + std::to_string(store.getRunCount()) +
+                         " runs (" + std::to_string(store.getRunCount() * 100 / store.getCapacity()) + "% of the store)" +
+                         (store.isFull() ? ", store full, capture truncated." : "."));
+
+    // Start zoomed out on the whole capture
+    size_t perColumn = std::max<size_t>(1, (taken + LOGIC_SCREEN_COLUMNS - 1) / LOGIC_SCREEN_COLUMNS);
+    const size_t maxPerColumn = perColumn;
+    size_t origin = 0;
+
+    while (true) {
+        size_t span = LOGIC_SCREEN_COLUMNS * perColumn;
+        if (origin + span > taken) origin = taken > span ? taken - span : 0;
+
+        drawLogicCapture(pins, shown, origin, perColumn, origin + span / 2, SIZE_MAX, false, &store);
+        terminalView.println("At " + argTransformer.formatFloat(origin * 1000.0 / rate, 3) + " ms, " +
+                             argTransformer.formatFloat(perColumn * 1000000.0 / rate, 2) + " us/px. " +
+                             "[z/Z] zoom, [a/d] pan, [c] channel, [w] save, [ENTER] back.");
+
+        char c;
+        while ((c = terminalInput.readChar()) == KEY_NONE) delay(10);
+        if (c == '\r' || c == '\n') break;
+
+        // Zoom around the middle of the screen
+        size_t middle = origin + span / 2;
+        if (c == 'z' && perColumn > 1) perColumn /= 2;
+        if (c == 'Z' && perColumn < maxPerColumn) perColumn = std::min(perColumn * 2, maxPerColumn);
+        if (c == 'z' || c == 'Z') {
+            size_t half = LOGIC_SCREEN_COLUMNS * perColumn / 2;
+            origin = middle > half ? middle - half : 0;
+        }
+        if (c == 'a') origin = origin > span / 2 ? origin - span / 2 : 0;
+        if (c == 'd') origin += span / 2;
+        if (c == 'c') shown = (shown + 1) % pins.size();
+        if (c == 'w') saveLogicCapture();
+    }
+
+    terminalView.println("Back to live capture.\n");
+}
+
+/*
+Logic SUMP
+*/
+void UtilityController::handleLogicSump(const TerminalCommand& cmd) {
+    std::vector<std::string> tokens = argTransformer.splitArgs(cmd.getArgs());
+    if (tokens.empty()) {
+        terminalView.println("Usage: logic sump <pin> [pin2 ... pin8]");
+        return;
+    }
+
+    if (state.getTerminalMode() != TerminalTypeEnum::Serial) {
+        terminalView.println("Logic Analyzer: SUMP mode is only available with the USB Serial terminal.");
+        return;
+    }
+
+    std::vector<uint8_t> pins;
+    if (!parseLogicPins(tokens, pins)) return;
+
+    std::string channels;
+    for (size_t i = 0; i < pins.size(); ++i) {
+        channels += " D" + std::to_string(i) + "=GPIO" + std::to_string(pins[i]);
+    }
+    terminalView.println("\nLogic Analyzer: SUMP mode," + channels + ".");
+    terminalView.println("Close the terminal and connect PulseView (Openbench Logic Sniffer driver).");
+    terminalView.println("Reopen the terminal and press [ENTER] to return.");
+    terminalView.flush();
+
+    sumpServer.run(pins);
+
+    terminalView.println("\nLogic Analyzer: SUMP mode exited.");
+}
+
+void UtilityController::handleLogicRecord(const TerminalCommand& cmd) {
+    std::vector<std::string> tokens = argTransformer.splitArgs(cmd.getArgs());
+    if (tokens.empty()) {
+        terminalView.println("Usage: logic record <pin> [pin2 ... pin8]");
+        return;
+    }
+
+    std::vector<uint8_t> pins;
+    if (!parseLogicPins(tokens, pins)) return;
+
+    // Sample rate
+    std::vector<std::string> rateLabels;
+    for (size_t i = 0; i < LOGIC_RATE_COUNT && LOGIC_RATES[i] <= LogicAnalyzerService::getMaxSampleRate(); ++i) {
+        rateLabels.push_back(std::to_string(LOGIC_RATES[i] / 1000) + " kHz");
+    }
+    int rateIndex = userInputManager.readValidatedChoiceIndex("Sample rate", rateLabels, std::min<int>(5, rateLabels.size() - 1));
+    uint32_t rate = LOGIC_RATES[rateIndex];
+
+    // Depth
+    uint32_t total = userInputManager.readValidatedUint32("Samples to record", 1000000);
+    if (total == 0) return;
+
+    if (!logicAnalyzerService.configure(pins, rate)) {
+        terminalView.println("Logic Analyzer: Not enough memory for the capture buffer.");
+        return;
+    }
+
+    fs::File file;
+    bool onSd = false;
+    std::string path;
+    if (!openLogicExport(file, onSd, path)) {
+        logicAnalyzerService.end();
+        return;
+    }
+
+    // Changes are encoded and written from the other core while sampling goes on
+    VcdTransformer vcd;
+    vcd.begin(pins, rate, state.getVersion(), [&file](const uint8_t* data, size_t length) {
+        return file.write(data, length) == length;
+    });
+
+    terminalView.println("\nLogic Analyzer: Recording " + std::to_string(total) + " samples to " + path +
+                         "... Press any key to stop.");
+    terminalView.flush();
+
+    size_t recorded = logicAnalyzerService.captureStream(total, [&vcd](const uint8_t* samples, size_t count) {
+        return vcd.feed(samples, count);
+    }, [&]() {
+        return terminalInput.readChar() != KEY_NONE;
+    });
+    bool written = vcd.finish();
+
+    file.close();
+    if (onSd) sdService.end();
+
+    if (!written) {
+        terminalView.println("Logic Analyzer: Write failed after " + std::to_string(recorded) + " samples, storage full?");
+    } else if (logicAnalyzerService.hasOverrun()) {
+        terminalView.println("Logic Analyzer: Storage too slow for this rate, stopped after " +
+                             std::to_string(recorded) + " samples.");
+    }
+    terminalView.println("Logic Analyzer: " + std::to_string(vcd.getSampleCount()) + " samples, " +
+                         std::to_string(vcd.getBytesWritten() / 1024) + " KB written to " + path + ".");
+
+    logicAnalyzerService.end();
+}
+
+void UtilityController::saveLogicCapture() {
+    fs::File file;
+    bool onSd = false;
+    std::string path;
+    if (!openLogicExport(file, onSd, path)) return;
+
+    VcdTransformer vcd;
+    bool ok = vcd.begin(logicAnalyzerService.getCapturePins(), logicAnalyzerService.getEffectiveSampleRate(), state.getVersion(),
+                        [&file](const uint8_t* data, size_t length) {
+                            return file.write(data, length) == length;
+                        }) &&
+              logicAnalyzerService.readRuns([&vcd](uint8_t value, size_t length) {
+                  return vcd.feedRun(value, length);
+              }) &&
+              vcd.finish();
+
+    file.close();
+    if (onSd) sdService.end();
+
+    terminalView.println(ok ? "Logic Analyzer: Capture saved to " + path + "."
+                            : "Logic Analyzer: Write failed, storage full?");
+}
+
+bool UtilityController::openLogicExport(fs::File& file, bool& onSd, std::string& path) {
+    std::vector<std::string> targets = { "SD card", "LittleFS" };
+    onSd = userInputManager.readValidatedChoiceIndex("Save to", targets, 0) == 0;
+    path = "/" + userInputManager.readSanitizedString("File name", "capture") + ".vcd";
+
+    if (onSd) {
+        // Open SD with SPI pin
+        auto sdMounted = sdService.configure(state.getSpiCLKPin(), state.getSpiMISOPin(),
+                                             state.getSpiMOSIPin(), state.getSpiCSPin());
+        if (!sdMounted) {
+            terminalView.println("Logic Analyzer: No SD card detected. Check SPI pins");
+            return false;
+        }
+        file = sdService.openFileWrite(path);
+    } else {
+        if (!littleFsService.mounted()) littleFsService.begin();
+        file = littleFsService.openWrite(path);
+    }
+
+    if (!file) {
+        terminalView.println("Logic Analyzer: Could not create " + path + ".");
+        if (onSd) sdService.end();
+        return false;
+    }
+    return true;
+}
+
+bool UtilityController::parseLogicPins(const std::vector<std::string>& tokens, std::vector<uint8_t>& pins) {
+    pins.clear();
+    for (const auto& token : tokens) {
+        if (!argTransformer.isValidNumber(token)) {
+            terminalView.println("Logic Analyzer: Invalid pin '" + token + "'.");
+            return false;
+        }
+        // Parsed wide so 300 is not truncated to 44, longer tokens would overflow
+        uint32_t value = token.size() > 3 ? 256 : argTransformer.toUint32(token);
+        if (value > 255 || !GPIO_IS_VALID_GPIO(value)) {
+            terminalView.println("Logic Analyzer: Pin " + token + " is not a valid GPIO.");
+            return false;
+        }
+        uint8_t pin = static_cast<uint8_t>(value);
+        if (state.isPinProtected(pin)) {
+            terminalView.println("Logic Analyzer: Pin " + std::to_string(pin) + " is protected or reserved.");
+            return false;
+        }
+        if (std::find(pins.begin(), pins.end(), pin) == pins.end()) pins.push_back(pin);
+    }
+
+    if (pins.size() > LogicAnalyzerService::MAX_CHANNELS) {
+        terminalView.println("Logic Analyzer: 8 pins maximum.");
+        return false;
+    }
+    return true;
 }
 
 /*
 Analogic
 */
 void UtilityController::handleAnalogic(const TerminalCommand& cmd) {
-    uint16_t tDelay = 500;
-    uint16_t inc = 100; // tDelay will be decremented/incremented by inc
-    uint8_t step = 1; // step of the trace display kind of a zoom
+    static const uint32_t rates[] = { 1000, 2000, 5000, 10000, 20000, 40000, 83333 };
+    static const size_t rateCount = sizeof(rates) / sizeof(rates[0]);
+    static constexpr size_t columns = 320;
+    static constexpr uint8_t maxZoom = 6; // 2^6 samples per column
 
     if (cmd.getSubcommand().empty() || !argTransformer.isValidNumber(cmd.getSubcommand())) {
-        terminalView.println("Usage: analogic <pin>");
+        terminalView.println("Usage: analogic <pin> [pin2 ... pin4]");
         return;
     }
 
-    // Verify protected pin
-    uint8_t pin = argTransformer.toUint8(cmd.getSubcommand());
-    if (state.isPinProtected(pin)) {
-        terminalView.println("Analogic: This pin is protected or reserved.");
-        return;
+    // Verify pins, up to 4 channels interleaved by the ADC
+    std::vector<std::string> tokens = argTransformer.splitArgs(cmd.getArgs());
+    tokens.insert(tokens.begin(), cmd.getSubcommand());
+    std::vector<uint8_t> pins;
+    for (const auto& token : tokens) {
+        if (!argTransformer.isValidNumber(token)) {
+            terminalView.println("Analogic: Invalid pin '" + token + "'.");
+            return;
+        }
+        uint8_t pin = argTransformer.toUint8(token);
+        if (state.isPinProtected(pin)) {
+            terminalView.println("Analogic: Pin " + std::to_string(pin) + " is protected or reserved.");
+            return;
+        }
+        if (!state.isPinAnalog(pin)){
+            terminalView.println("Analogic: Pin " + std::to_string(pin) + " is not an analog one");
+            return;
+        };
+        if (std::find(pins.begin(), pins.end(), pin) == pins.end()) pins.push_back(pin);
     }
-    if (!state.isPinAnalog(pin)){
-        terminalView.println("Analogic: This pin is not an analog one");
+    if (pins.size() > AnalogCaptureService::MAX_CHANNELS) {
+        terminalView.println("Analogic: 4 pins maximum.");
         return;
-    };
+    }
 
-    terminalView.println("\nAnalogic: Monitoring pin " + std::to_string(pin) + "... Press [ENTER] to stop.");
-    terminalView.println("Displaying waveform on the ESP32 screen...\n");
+    size_t rateIndex = 3; // 10 kHz
+    uint8_t zoom = 0;     // samples per column = 1 << zoom
+    uint8_t shown = 0;    // channel drawn on the device screen
+
+    for (auto pin : pins) pinService.setInput(pin);
+    analogCaptureService.configure(pins, rates[rateIndex]);
 
+    std::string pinList;
+    for (auto pin : pins) pinList += " " + std::to_string(pin);
+    terminalView.println("\nAnalogic: Monitoring pins" + pinList + " at " +
+                         std::to_string(analogCaptureService.getSampleRate()) + " S/s" +
+                         (analogCaptureService.isDma() ? " (ADC DMA)" : "") + "... Press [ENTER] to stop.");
+    terminalView.println("[s/S] rate, [z/Z] zoom, [c] screen channel, [t] threshold trigger.");
+    terminalView.println("Displaying waveform on the ESP32 screen...\n");
 
-    pinService.setInput(pin);
-    std::vector<uint8_t> buffer;
-    buffer.reserve(320); // 320 samples
+    std::vector<uint16_t> mins, maxs;
+    std::vector<uint8_t> low, high;
 
-    unsigned long lastCheck = millis();
+    unsigned long lastReport = millis();
     deviceView.clear();
     deviceView.topBar("Analog plotter", false, false);
-    int count = 0;
+
+    CaptureTrigger trigger;
+    bool armed = false;
+    uint8_t prePercent = 25;
+
     while (true) {
-        // Enter press
-        if (millis() - lastCheck > 10) {
-            lastCheck = millis();
-            char c = terminalInput.readChar();
-            if (c == '\r' || c == '\n') {
-                terminalView.println("\nAnalogic: Stopped by user.");
+        char c = terminalInput.readChar();
+        if (c == '\r' || c == '\n') {
+            terminalView.println("\nAnalogic: Stopped by user.");
+            break;
+        }
+
+        std::string status;
+        if (c == 's' && rateIndex > 0) rateIndex--;
+        if (c == 'S' && rateIndex + 1 < rateCount) rateIndex++;
+        if (c == 's' || c == 'S') {
+            analogCaptureService.setSampleRate(rates[rateIndex]);
+            status = "rate : " + std::to_string(analogCaptureService.getSampleRate()) + " S/s";
+        }
+        if (c == 'z' && zoom < maxZoom) zoom++;
+        if (c == 'Z' && zoom > 0) zoom--;
+        if (c == 'z' || c == 'Z') status = "zoom : " + std::to_string(1 << zoom) + " samples/px";
+        if (c == 'c') {
+            shown = (shown + 1) % pins.size();
+            status = "screen : pin " + std::to_string(pins[shown]);
+        }
+        if (!status.empty()) terminalView.println("\n" + status + "\n");
+        if (c == 't') {
+            armed = readAnalogTrigger(trigger, prePercent);
+        }
+
+        // Capture first, draw after, the display never runs between samples
+        size_t frame = columns << zoom;
+        if (armed) {
+            size_t pre = frame * prePercent / 100;
+            terminalView.println("Armed: " + CaptureTriggerEnumMapper::toString(trigger.getType()) +
+                                 " on pin " + std::to_string(pins[0]) + ", press any key to cancel.");
+            terminalView.flush();
+
+            bool fired = analogCaptureService.captureTriggered(trigger, pre, frame - pre - 1, [&]() {
+                return terminalInput.readChar() != KEY_NONE;
+            });
+            if (!fired) {
+                armed = false;
+                terminalView.println("Trigger cancelled, free running.\n");
+                continue;
+            }
+        } else {
+            analogCaptureService.clear();
+            analogCaptureService.capture(frame);
+        }
+
+        // Min/max per column, convert the 12 bits values to uint8_t (4096 ==> 256)
+        analogCaptureService.decimateMinMax(shown, 0, frame, columns, mins, maxs);
+        low.resize(mins.size());
+        high.resize(maxs.size());
+        for (size_t i = 0; i < mins.size(); ++i) {
+            low[i] = mins[i] >> 4;
+            high[i] = maxs[i] >> 4;
+        }
+        deviceView.drawAnalogicEnvelope(pins[shown], low, high);
+
+        if (armed) {
+            uint16_t raw = analogCaptureService.sampleAt(analogCaptureService.getTriggerIndex());
+            terminalView.println("Triggered at " + argTransformer.formatFloat((raw / 4095.0f) * 3.3f, 2) +
+                                 " V. [t] re-arm, [f] free run, [ENTER] exit, any other key same trigger.");
+            reportAnalogCapture();
+
+            char next;
+            while ((next = terminalInput.readChar()) == KEY_NONE) delay(10);
+            if (next == '\r' || next == '\n') {
+                terminalView.println("Analogic: Stopped by user.");
                 break;
             }
-            if (c == 's'){
-                if (tDelay > inc){
-                    tDelay -= inc;
-                    terminalView.println("\ndelay : " + std::to_string(tDelay) + "\n");
-                }
-            };
-            if (c == 'S'){
-                if (tDelay < 10000){
-                    tDelay += inc;
-                    terminalView.println("\ndelay : " + std::to_string(tDelay) + "\n");
-                }
-            };
-            if (c == 'z'){
-                if (step > 1){
-                    step--;
-                    terminalView.println("\nstep : " + std::to_string(step) + "\n");
-                }
-            };
-            if (c == 'Z'){
-                if (step < 4){
-                    step++;
-                    terminalView.println("\nstep : " + std::to_string(step) + "\n");
-                }
-            };
-            count++;
-            if ((count > 50) && (state.getTerminalMode() != TerminalTypeEnum::Standalone)){
-                int raw = pinService.readAnalog(pin);
-                float voltage = (raw / 4095.0f) * 3.3f;
-
-                std::ostringstream oss;
-                oss << "   Analog pin " << static_cast<int>(pin)
-                    << ": " << raw
-                    << " (" << voltage << " V)";
-                terminalView.println(oss.str());
-                count = 0;
+            if (next == 'f') armed = false;
+            if (next == 't') armed = readAnalogTrigger(trigger, prePercent);
+            continue;
+        }
+
+        if ((millis() - lastReport > 500) && (state.getTerminalMode() != TerminalTypeEnum::Standalone)){
+            lastReport = millis();
+            reportAnalogCapture();
+        }
+    }
+
+    analogCaptureService.end();
+}
+
+void UtilityController::reportAnalogCapture() {
+    const auto& pins = analogCaptureService.getPins();
+    size_t count = analogCaptureService.getSampleCount();
+    if (count == 0) return;
+
+    for (size_t ch = 0; ch < pins.size(); ++ch) {
+        uint16_t low = 0xFFFF, high = 0;
+        uint32_t sum = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint16_t v = analogCaptureService.sampleAt(i, ch);
+            low = std::min(low, v);
+            high = std::max(high, v);
+            sum += v;
+        }
+
+        // Frequency from the rising crossings of the mid level, with some hysteresis
+        uint16_t mid = (low + high) / 2;
+        uint16_t band = (high - low) / 8;
+        size_t first = 0, last = 0, crossings = 0;
+        bool above = analogCaptureService.sampleAt(0, ch) > mid;
+        for (size_t i = 1; i < count; ++i) {
+            uint16_t v = analogCaptureService.sampleAt(i, ch);
+            if (!above && v > mid + band) {
+                above = true;
+                if (crossings++ == 0) first = i;
+                last = i;
+            } else if (above && v < mid - band) {
+                above = false;
             }
         }
 
-        // Draw
-        if (buffer.size() >= 320) {
-            buffer.resize(320);
-            deviceView.drawAnalogicTrace(pin, buffer, step);
-            buffer.clear();
+        std::string line = "   Analog pin " + std::to_string(pins[ch]) +
+                           ": min " + argTransformer.formatFloat(low * 3.3f / 4095.0f, 2) +
+                           " V, max " + argTransformer.formatFloat(high * 3.3f / 4095.0f, 2) +
+                           " V, avg " + argTransformer.formatFloat((float)sum / count * 3.3f / 4095.0f, 2) + " V";
+        if (crossings >= 2 && high - low > 40) {
+            float hz = (float)(crossings - 1) * analogCaptureService.getSampleRate() / (last - first);
+            line += ", ~" + argTransformer.formatFloat(hz, 1) + " Hz";
         }
+        terminalView.println(line);
+    }
+}
+
+bool UtilityController::readAnalogTrigger(CaptureTrigger& trigger, uint8_t& prePercent) {
+    static const std::vector<std::string> types = { "None (free run)", "Threshold rising", "Threshold falling" };
 
-        buffer.push_back(pinService.readAnalog(pin) >> 4); // convert the readAnalog() value to a uint8_t (4096 ==> 256)
-        delayMicroseconds(tDelay);
+    terminalView.println("");
+    int type = userInputManager.readValidatedChoiceIndex("Trigger type", types, 1);
+    if (type <= 0) {
+        trigger = CaptureTrigger();
+        terminalView.println("Trigger off, free running.\n");
+        return false;
     }
+
+    float volts = userInputManager.readValidatedFloat("Threshold (V)", 1.65f, 0.0f, 3.3f);
+    uint16_t raw = static_cast<uint16_t>(volts / 3.3f * 4095.0f);
+    trigger = CaptureTrigger(type == 1 ? CaptureTriggerEnum::AnalogRising : CaptureTriggerEnum::AnalogFalling, 0, raw);
+
+    prePercent = userInputManager.readValidatedUint8("Pre-trigger %", prePercent, 0, 99);
+    return true;
 }
 
 /*
@@ -426,9 +930,46 @@ void UtilityController::handleGuide() {
 Wizard
 */
 void UtilityController::handleWizard(const TerminalCommand& cmd) {
+    // Every usable GPIO at once
+    if (cmd.getSubcommand() == "all") {
+        std::vector<uint8_t> pins;
+        for (uint8_t pin = 0; pin < SOC_GPIO_PIN_COUNT && pins.size() < EdgeCaptureService::MAX_CHANNELS; ++pin) {
+            if (GPIO_IS_VALID_GPIO(pin) && !state.isPinProtected(pin)) pins.push_back(pin);
+        }
+        handleWizardSurvey(pins);
+        return;
+    }
+
     // Validate pin argument
     if (cmd.getSubcommand().empty() || !argTransformer.isValidNumber(cmd.getSubcommand())) {
-        terminalView.println("Usage: wizard <pin>");
+        terminalView.println("Usage: wizard <pin> [pin2 ...]");
+        terminalView.println("       wizard all");
+        return;
+    }
+
+    // Several pins, surveyed in parallel
+    if (!cmd.getArgs().empty()) {
+        std::vector<std::string> tokens = argTransformer.splitArgs(cmd.getArgs());
+        tokens.insert(tokens.begin(), cmd.getSubcommand());
+        std::vector<uint8_t> pins;
+        for (const auto& token : tokens) {
+            if (!argTransformer.isValidNumber(token)) {
+                terminalView.println("Wizard: Invalid pin '" + token + "'.");
+                return;
+            }
+            // Interrupts are attached on every pin, only real GPIOs
+            uint8_t pin = argTransformer.toUint8(token);
+            if (!GPIO_IS_VALID_GPIO(pin)) {
+                terminalView.println("Wizard: Pin " + std::to_string(pin) + " is not a valid GPIO.");
+                return;
+            }
+            if (state.isPinProtected(pin)) {
+                terminalView.println("Wizard: Pin " + std::to_string(pin) + " is protected or reserved.");
+                return;
+            }
+            if (std::find(pins.begin(), pins.end(), pin) == pins.end()) pins.push_back(pin);
+        }
+        handleWizardSurvey(pins);
         return;
     }
 
@@ -469,6 +1010,44 @@ void UtilityController::handleWizard(const TerminalCommand& cmd) {
     pinAnalyzeManager.end();
 }
 
+void UtilityController::handleWizardSurvey(const std::vector<uint8_t>& pins) {
+    if (pins.empty()) {
+        terminalView.println("Wizard: No pin to analyze.");
+        return;
+    }
+
+    if (!pinSurveyManager.begin(pins)) {
+        terminalView.println("Wizard: Could not attach the pin interrupts.");
+        return;
+    }
+
+    std::string pinList;
+    for (auto pin : pins) pinList += " " + std::to_string(pin);
+    terminalView.println("\nWizard: Please wait, analyzing pins" + pinList + "... Press [ENTER] to stop.\n");
+
+    while (true) {
+        // Check for ENTER press to stop
+        char key = terminalInput.readChar();
+        if (key == '\r' || key == '\n') {
+            terminalView.println("\nWizard: Stopped by user.");
+            break;
+        }
+
+        pinSurveyManager.sample();
+
+        // One table for all pins per window
+        if (pinSurveyManager.shouldReport(millis())) {
+            auto rows = pinSurveyManager.buildReports();
+            terminalView.print(pinSurveyManager.formatSurveyTable(rows));
+            pinSurveyManager.resetWindow();
+            terminalView.println("Wizard: Analyzing " + std::to_string(pins.size()) + " pins... Press [ENTER] to stop.\n");
+        }
+    }
+
+    // Release the interrupts and buffers
+    pinSurveyManager.end();
+}
+
 /*
 Help
 */
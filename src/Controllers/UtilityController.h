@@ -12,9 +12,19 @@
 #include "States/GlobalState.h"
 #include "Enums/ModeEnum.h"
 #include "Services/PinService.h"
+#include "Services/LogicAnalyzerService.h"
+#include "Services/AnalogCaptureService.h"
+#include "Services/SdService.h"
+#include "Services/LittleFsService.h"
+#include "Servers/SumpServer.h"
+#include "Models/CaptureTrigger.h"
+#include "Models/RleCaptureStore.h"
 #include "Managers/UserInputManager.h"
 #include "Managers/PinAnalyzeManager.h"
+#include "Managers/PinSurveyManager.h"
+#include "driver/gpio.h"
 #include "Transformers/ArgTransformer.h"
+#include "Transformers/VcdTransformer.h"
 #include "Shells/SysInfoShell.h"
 #include "Shells/GuideShell.h"
 #include "Shells/HelpShell.h"
@@ -27,8 +37,14 @@ public:
         IDeviceView& deviceView, 
         IInput& terminalInput, 
         PinService& pinService, 
+        LogicAnalyzerService& logicAnalyzerService,
+        AnalogCaptureService& analogCaptureService,
+        SdService& sdService,
+        LittleFsService& littleFsService,
+        SumpServer& sumpServer,
         UserInputManager& userInputManager,
         PinAnalyzeManager& pinAnalyzeManager,
+        PinSurveyManager& pinSurveyManager,
         ArgTransformer& argTransformer,
         SysInfoShell& sysInfoShell,
         GuideShell& guideShell,
@@ -72,18 +88,64 @@ private:
     // Firmware guide
     void handleGuide();
 
+    // Logic analyzer driven by a SUMP client (PulseView, OLS)
+    void handleLogicSump(const TerminalCommand& cmd);
+
+    // Draw a logic capture on the device screen and the serial terminal
+    void drawLogicCapture(const std::vector<uint8_t>& pins, uint8_t shown, size_t origin, size_t perColumn,
+                          size_t center, size_t triggerIndex, bool live, const RleCaptureStore* store = nullptr);
+
+    // Run-length capture of several seconds, browsed with zoom and pan
+    void browseLogicLong(const std::vector<uint8_t>& pins, uint8_t shown);
+
+    // Ask the user for a logic trigger, false when free running
+    bool readLogicTrigger(const std::vector<uint8_t>& pins, uint32_t sampleRate,
+                          CaptureTrigger& trigger, uint8_t& prePercent);
+
+    // Print min, max, average and frequency of the last analog capture
+    void reportAnalogCapture();
+
+    // Ask the user for an analog threshold trigger, false when free running
+    bool readAnalogTrigger(CaptureTrigger& trigger, uint8_t& prePercent);
+
+    // Stream a logic capture to a VCD file, deeper than the ring
+    void handleLogicRecord(const TerminalCommand& cmd);
+
+    // Write the frozen logic capture to a VCD file
+    void saveLogicCapture();
+
+    // Ask for SD or LittleFS and a file name, then create the file
+    bool openLogicExport(fs::File& file, bool& onSd, std::string& path);
+
+    // Parse and validate the logic analyzer pins
+    bool parseLogicPins(const std::vector<std::string>& tokens, std::vector<uint8_t>& pins);
+
     // Pin diagnostic with periodic report
     void handleWizard(const TerminalCommand& cmd);
 
+    // Same diagnostic on several pins at once, one ranked table per window
+    void handleWizardSurvey(const std::vector<uint8_t>& pins);
+
     ITerminalView& terminalView;
     IDeviceView& deviceView;
     IInput& terminalInput;
     PinService& pinService;
+    LogicAnalyzerService& logicAnalyzerService;
+    AnalogCaptureService& analogCaptureService;
+    SdService& sdService;
+    LittleFsService& littleFsService;
+    SumpServer& sumpServer;
     UserInputManager& userInputManager;
     PinAnalyzeManager& pinAnalyzeManager;
+    PinSurveyManager& pinSurveyManager;
     ArgTransformer& argTransformer;
     SysInfoShell& sysInfoShell;
     GuideShell& guideShell;
     HelpShell& helpShell;
     GlobalState& state = GlobalState::getInstance();
+
+    static constexpr size_t LOGIC_SCREEN_COLUMNS = 320;
+    static constexpr size_t LOGIC_TERMINAL_COLUMNS = 132;
+    static constexpr uint32_t LOGIC_RATES[] = { 10000, 50000, 100000, 250000, 500000, 1000000, 2000000, 5000000 };
+    static constexpr size_t LOGIC_RATE_COUNT = sizeof(LOGIC_RATES) / sizeof(LOGIC_RATES[0]);
 };
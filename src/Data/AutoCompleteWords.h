@@ -1,13 +1,13 @@
 static const char* const autoCompleteWords[] = {
 
     // --- General ---
-    "help","mode","man","system","logic","analogic","wizard",
+    "help","mode","man","system","logic","analogic","wizard","binary",
 
     // --- 1WIRE ---
     "scan","ping","sniff","read","write","temp","ibutton","eeprom","config",
 
     // --- UART / HDUART ---
-    "autobaud","bridge","at","spam","glitch","xmodem","swap", "emulator",
+    "autobaud","bridge","at","spam","glitch","xmodem","ymodem","swap", "emulator",
 
     // --- I2C ---
     "discovery","identify","slave","dump","flood","health","monitor",
@@ -1,5 +1,7 @@
 #pragma once
 #include <cstdint>
+#include <cstddef>
+#include <array>
 #include <ctype.h>
 
 struct I2cKnownAddress {
@@ -474,4 +476,205 @@ inline constexpr I2cKnownAddress i2cKnownAddresses[] = {
 {0xD1, "Grove Mini Motor Driver CH1 Read (Alt)", "Motor Driver"},
 
 };
-static const size_t i2cknownAddressesCount = sizeof(i2cKnownAddresses) / sizeof(i2cKnownAddresses[0]);
+
+/*
+The table above is only read at compile time. What goes in flash is
+the rows sorted by address with repeated rows dropped, types stored
+once in a pool, and an index of the first row of each address.
+*/
+struct I2cKnownDevice {
+    const char* component;
+    uint8_t address;
+    uint8_t type; // in i2cKnownTypes
+};
+
+namespace i2c_known_detail {
+
+constexpr size_t ROWS = sizeof(i2cKnownAddresses) / sizeof(i2cKnownAddresses[0]);
+
+constexpr bool sameText(const char* a, const char* b) {
+    while (*a && *a == *b) { ++a; ++b; }
+    return *a == *b;
+}
+
+constexpr bool sameRow(const I2cKnownAddress& a, const I2cKnownAddress& b) {
+    return a.address == b.address && sameText(a.component, b.component) && sameText(a.type, b.type);
+}
+
+// First row with the same type, or the same whole row
+constexpr bool isFirstType(size_t row) {
+    for (size_t i = 0; i < row; ++i) {
+        if (sameText(i2cKnownAddresses[i].type, i2cKnownAddresses[row].type)) return false;
+    }
+    return true;
+}
+
+constexpr bool isFirstRow(size_t row) {
+    for (size_t i = 0; i < row; ++i) {
+        if (sameRow(i2cKnownAddresses[i], i2cKnownAddresses[row])) return false;
+    }
+    return true;
+}
+
+constexpr size_t countTypes() {
+    size_t n = 0;
+    for (size_t i = 0; i < ROWS; ++i) n += isFirstType(i);
+    return n;
+}
+
+constexpr size_t countDevices() {
+    size_t n = 0;
+    for (size_t i = 0; i < ROWS; ++i) n += isFirstRow(i);
+    return n;
+}
+
+constexpr size_t TYPES = countTypes();
+constexpr size_t DEVICES = countDevices();
+static_assert(TYPES <= 256, "Type index is one byte");
+
+constexpr std::array<const char*, TYPES> buildTypes() {
+    std::array<const char*, TYPES> types = {};
+    size_t n = 0;
+    for (size_t i = 0; i < ROWS; ++i) {
+        if (isFirstType(i)) types[n++] = i2cKnownAddresses[i].type;
+    }
+    return types;
+}
+
+constexpr std::array<const char*, TYPES> TYPE_POOL = buildTypes();
+
+constexpr uint8_t typeIndex(const char* type) {
+    for (size_t i = 0; i < TYPES; ++i) {
+        if (sameText(TYPE_POOL[i], type)) return i;
+    }
+    return 0;
+}
+
+// Counting sort on the address, rows of one address keep the table order
+constexpr std::array<I2cKnownDevice, DEVICES> buildDevices() {
+    std::array<I2cKnownDevice, DEVICES> devices = {};
+    size_t n = 0;
+    for (size_t address = 0; address < 256; ++address) {
+        for (size_t i = 0; i < ROWS; ++i) {
+            const auto& row = i2cKnownAddresses[i];
+            if (row.address == address && isFirstRow(i)) {
+                devices[n++] = { row.component, row.address, typeIndex(row.type) };
+            }
+        }
+    }
+    return devices;
+}
+
+// Rows of address A are [index[A], index[A + 1])
+constexpr std::array<uint16_t, 257> buildIndex() {
+    std::array<uint16_t, 257> index = {};
+    for (size_t i = 0; i < ROWS; ++i) {
+        if (isFirstRow(i)) index[i2cKnownAddresses[i].address + 1]++;
+    }
+    for (size_t a = 1; a < index.size(); ++a) index[a] += index[a - 1];
+    return index;
+}
+
+} // namespace i2c_known_detail
+
+inline constexpr auto i2cKnownTypes = i2c_known_detail::TYPE_POOL;
+inline constexpr auto i2cKnownDevices = i2c_known_detail::buildDevices();
+inline constexpr auto i2cKnownIndex = i2c_known_detail::buildIndex();
+
+struct I2cKnownRange {
+    const I2cKnownDevice* first;
+    const I2cKnownDevice* last;
+    const I2cKnownDevice* begin() const { return first; }
+    const I2cKnownDevice* end() const { return last; }
+    bool empty() const { return first == last; }
+};
+
+// All the known parts answering at `address`
+inline I2cKnownRange i2cKnownDevicesAt(uint8_t address) {
+    return { i2cKnownDevices.data() + i2cKnownIndex[address], i2cKnownDevices.data() + i2cKnownIndex[address + 1] };
+}
+
+/*
+Identification registers, to tell apart parts sharing an address.
+A part matches when (reg & mask) == value, the first match wins.
+Parts without an ID register (command based, RTC, EEPROM) are not here.
+*/
+struct I2cFingerprint {
+    uint8_t address;
+    uint8_t reg;
+    uint8_t mask;
+    uint8_t value;
+    const char* component;
+};
+
+inline constexpr I2cFingerprint i2cFingerprints[] = {
+
+// Magnetometers
+{0x0D, 0x00, 0xFF, 0x48, "AK8975"},
+{0x1E, 0x0A, 0xFF, 0x48, "HMC5883L"},
+{0x1E, 0x0F, 0xFF, 0x3D, "LIS3MDL"},
+{0x1E, 0x4F, 0xFF, 0x40, "LIS2MDL"},
+
+// Accelerometers
+{0x18, 0x07, 0xFF, 0x04, "MCP9808"},
+{0x18, 0x0F, 0xFF, 0x33, "LIS3DH"},
+{0x19, 0x0F, 0xFF, 0x33, "LIS3DH / LSM303AGR"},
+{0x1D, 0x00, 0xFF, 0xE5, "ADXL343 / ADXL345"},
+{0x53, 0x00, 0xFF, 0xE5, "ADXL343 / ADXL345"},
+
+// IMU
+{0x28, 0x00, 0xFF, 0xA0, "BNO055"},
+{0x68, 0x75, 0xFF, 0x68, "MPU6050"},
+{0x68, 0x75, 0xFF, 0x70, "MPU6500"},
+{0x68, 0x75, 0xFF, 0x71, "MPU9250"},
+{0x68, 0x75, 0xFF, 0x19, "MPU6886"},
+{0x68, 0x00, 0xFF, 0x24, "BMI270"},
+{0x69, 0x75, 0xFF, 0x68, "MPU6050"},
+{0x69, 0x75, 0xFF, 0x71, "MPU9250"},
+{0x69, 0x00, 0xFF, 0xE1, "ICM20649"},
+{0x69, 0x00, 0xFF, 0x24, "BMI270"},
+{0x6A, 0x0F, 0xFF, 0x69, "LSM6DS3 / LSM6DS33"},
+{0x6A, 0x0F, 0xFF, 0x6C, "LSM6DSOX"},
+{0x6B, 0x0F, 0xFF, 0x69, "LSM6DS3 / LSM6DS33"},
+{0x6B, 0x0F, 0xFF, 0x6C, "LSM6DSOX"},
+
+// Distance, light, color
+{0x29, 0xC0, 0xFF, 0xEE, "VL53L0X"},
+{0x29, 0x92, 0xFF, 0x44, "TCS34725"},
+{0x29, 0x92, 0xFF, 0x4D, "TCS34727"},
+{0x39, 0x92, 0xFF, 0xAB, "APDS-9960"},
+{0x39, 0x92, 0xFC, 0x24, "AS7341"},
+{0x39, 0x8A, 0xF0, 0x50, "TSL2561"},
+
+// Power, temperature, humidity
+{0x40, 0xFF, 0xFF, 0x22, "INA260"},
+{0x40, 0xFF, 0xFF, 0x10, "HDC1008 / HDC1080"},
+{0x40, 0x00, 0xFF, 0x39, "INA219"},
+{0x40, 0xE7, 0xFF, 0x3A, "Si7021"},
+{0x40, 0xE7, 0xFF, 0x02, "HTU21D"},
+{0x48, 0x0F, 0xFF, 0x01, "TMP117"},
+{0x48, 0x01, 0xFF, 0x85, "ADS1115 / ADS1015"},
+{0x48, 0x01, 0xFF, 0x60, "TMP102"},
+
+// Heart rate, air quality, haptic
+{0x57, 0xFF, 0xFF, 0x15, "MAX30102 / MAX30105"},
+{0x57, 0xFF, 0xFF, 0x11, "MAX30100"},
+{0x5A, 0x20, 0xFF, 0x81, "CCS811"},
+{0x5B, 0x20, 0xFF, 0x81, "CCS811"},
+{0x5A, 0x00, 0xE0, 0xE0, "DRV2605L"},
+{0x5A, 0x00, 0xE0, 0x60, "DRV2605"},
+
+// Pressure
+{0x76, 0xD0, 0xFF, 0x58, "BMP280"},
+{0x76, 0xD0, 0xFF, 0x60, "BME280"},
+{0x76, 0xD0, 0xFF, 0x61, "BME680 / BME688"},
+{0x76, 0x00, 0xFF, 0x50, "BMP388"},
+{0x76, 0x0D, 0xFF, 0x10, "DPS310"},
+{0x77, 0xD0, 0xFF, 0x55, "BMP180"},
+{0x77, 0xD0, 0xFF, 0x58, "BMP280"},
+{0x77, 0xD0, 0xFF, 0x60, "BME280"},
+{0x77, 0xD0, 0xFF, 0x61, "BME680 / BME688"},
+{0x77, 0x00, 0xFF, 0x50, "BMP388"},
+{0x77, 0x0D, 0xFF, 0x10, "DPS310"},
+
+};
@@ -51,14 +51,18 @@ void ActionDispatcher::dispatch(const std::string& raw) {
 
     // Instructions
     if (first == '[' || first == '>' || first == '{') {
-        std::vector<Instruction> instructions = provider.getInstructionTransformer().transform(raw);
-        dispatchInstructions(instructions);
+        std::vector<ByteCode> bytecodes;
+        if (!provider.getInstructionTransformer().compile(raw, bytecodes)) {
+            provider.getTerminalView().println("Instruction too long, split it into several lines.");
+            return;
+        }
+        dispatchInstructions(bytecodes);
         return;
     }
 
     // Macros
     if (first == '(') {
-        provider.getTerminalView().println("Macros Not Yet Implemented.");
+        dispatchMacro(raw);
         return;
     }
 
@@ -80,6 +84,12 @@ void ActionDispatcher::dispatchCommand(const TerminalCommand& cmd) {
         return;
     }
 
+    // Binary host protocol
+    if (cmd.getRoot() == "binary") {
+        dispatchBinaryMode();
+        return;
+    }
+
     // Global command (help, logic, mode, P, p...)
     if (provider.getUtilityController().isGlobalCommand(cmd)) {
         provider.getUtilityController().handleCommand(cmd);
@@ -171,10 +181,7 @@ void ActionDispatcher::dispatchCommand(const TerminalCommand& cmd) {
 /*
 Dispatch Instructions
 */
-void ActionDispatcher::dispatchInstructions(const std::vector<Instruction>& instructions) {
-    // Convert raw instructions into bytecodes vector
-    auto bytecodes = provider.getInstructionTransformer().transformByteCodes(instructions);
-
+void ActionDispatcher::dispatchInstructions(const std::vector<ByteCode>& bytecodes, bool showSequence) {
     switch (state.getCurrentMode()) {
         case ModeEnum::OneWire:
             provider.getOneWireController().handleInstruction(bytecodes);
@@ -205,6 +212,8 @@ void ActionDispatcher::dispatchInstructions(const std::vector<Instruction>& inst
             return;
     }
 
+    if (!showSequence) return;
+
     // Line by line bytecode
     provider.getTerminalView().println("");
     provider.getTerminalView().println("ByteCode Sequence:");
@@ -219,6 +228,99 @@ void ActionDispatcher::dispatchInstructions(const std::vector<Instruction>& inst
     provider.getTerminalView().println("");
 }
 
+/*
+Dispatch Binary Mode
+*/
+void ActionDispatcher::dispatchBinaryMode() {
+    if (state.getTerminalMode() != TerminalTypeEnum::Serial) {
+        provider.getTerminalView().println("Binary mode is only available with the USB Serial terminal.");
+        return;
+    }
+
+    provider.getTerminalView().println("Binary mode: framed protocol active, send 0x01 0x00 0x00 or press [ENTER] to exit.");
+    provider.getTerminalView().flush();
+    provider.getBinaryProtocolServer().run();
+    provider.getTerminalView().println("\nBinary mode: exited.");
+
+    // Buses may have been reconfigured by the host
+    setCurrentMode(state.getCurrentMode());
+}
+
+/*
+Dispatch Macro
+    (0)          list macros of the current mode
+    (N)          run macro N
+    (N=[...])    define macro N
+    (N=)         delete macro N
+*/
+void ActionDispatcher::dispatchMacro(const std::string& raw) {
+    auto& view = provider.getTerminalView();
+    auto& macros = provider.getMacroManager();
+    ModeEnum mode = state.getCurrentMode();
+
+    size_t close = raw.find(')');
+    size_t eq = raw.find('=');
+    std::string idStr = raw.substr(1, std::min(close, eq) - 1);
+    idStr.erase(std::remove_if(idStr.begin(), idStr.end(), ::isspace), idStr.end());
+
+    if (!idStr.empty() && !std::all_of(idStr.begin(), idStr.end(), ::isdigit)) {
+        view.println("Invalid macro, use (0) to list, (N) to run, (N=[...]) to define.");
+        return;
+    }
+    // At most 3 digits, a longer id would overflow stoul
+    unsigned long id = idStr.empty() ? 0 : idStr.size() > 3 ? 256 : std::stoul(idStr);
+    if (id > 255) {
+        view.println("Macro number must be 1-255.");
+        return;
+    }
+
+    // Define or delete
+    if (eq != std::string::npos) {
+        if (id == 0) {
+            view.println("Macro number must be 1-255.");
+            return;
+        }
+        std::string source = raw.substr(eq + 1);
+        if (!source.empty() && source.back() == ')') source.pop_back();
+
+        if (source.find_first_not_of(' ') == std::string::npos) {
+            bool removed = macros.remove(mode, id);
+            view.println(removed ? "Macro " + std::to_string(id) + " deleted." : "Macro " + std::to_string(id) + " not found.");
+            return;
+        }
+
+        if (!macros.define(mode, id, source)) {
+            view.println("Macro " + std::to_string(id) + " not saved, check the instruction syntax.");
+            return;
+        }
+        view.println("Macro " + std::to_string(id) + " saved to " + macros.pathFor(mode));
+        return;
+    }
+
+    // List
+    if (id == 0) {
+        const auto& all = macros.list(mode);
+        if (all.empty()) {
+            view.println("No macros for " + ModeEnumMapper::toString(mode) + ". Define one with (1=[0x9F r:3])");
+            return;
+        }
+        view.println("");
+        for (const auto& entry : all) {
+            view.println("  (" + std::to_string(entry.first) + ") " + entry.second.source);
+        }
+        view.println("");
+        return;
+    }
+
+    // Replay the precompiled program
+    const std::vector<ByteCode>* program = macros.get(mode, id);
+    if (!program) {
+        view.println("Macro " + std::to_string(id) + " not found, use (0) to list.");
+        return;
+    }
+    dispatchInstructions(*program, false);
+}
+
 /*
 User Action
 */
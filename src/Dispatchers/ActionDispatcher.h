@@ -33,7 +33,13 @@ private:
     void dispatchCommand(const TerminalCommand& cmd);
 
     // Handle a sequence of bytecode instructions
-    void dispatchInstructions(const std::vector<Instruction>& instructions);
+    void dispatchInstructions(const std::vector<ByteCode>& bytecodes, bool showSequence = true);
+
+    // Serve the binary host protocol until the host exits
+    void dispatchBinaryMode();
+
+    // Handle a macro, list, run or define
+    void dispatchMacro(const std::string& raw);
 
     // Read user input with cursor support
     std::string getUserAction();
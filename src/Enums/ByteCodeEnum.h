@@ -1,7 +1,8 @@
 #pragma once
 #include <string>
+#include <cstdint>
 
-enum class ByteCodeEnum {
+enum class ByteCodeEnum : uint8_t {
     Write,
     Read,
     Start,
@@ -0,0 +1,32 @@
+#pragma once
+#include <string>
+
+enum class CaptureTriggerEnum {
+    None,           // free run
+    Rising,         // logic, low to high on a channel
+    Falling,        // logic, high to low on a channel
+    AnyEdge,        // logic, any change on the masked channels
+    Level,          // logic, a channel at a given level
+    Pattern,        // logic, masked channels equal a value
+    PulseWidth,     // logic, end of a pulse whose width is in range
+    AnalogRising,   // analog, crossing the threshold upward
+    AnalogFalling   // analog, crossing the threshold downward
+};
+
+class CaptureTriggerEnumMapper {
+public:
+    static std::string toString(CaptureTriggerEnum type) {
+        switch (type) {
+            case CaptureTriggerEnum::None:          return "None";
+            case CaptureTriggerEnum::Rising:        return "Rising edge";
+            case CaptureTriggerEnum::Falling:       return "Falling edge";
+            case CaptureTriggerEnum::AnyEdge:       return "Any edge";
+            case CaptureTriggerEnum::Level:         return "Level";
+            case CaptureTriggerEnum::Pattern:       return "Pattern";
+            case CaptureTriggerEnum::PulseWidth:    return "Pulse width";
+            case CaptureTriggerEnum::AnalogRising:  return "Threshold rising";
+            case CaptureTriggerEnum::AnalogFalling: return "Threshold falling";
+            default:                                return "Unknown";
+        }
+    }
+};
@@ -0,0 +1,20 @@
+#pragma once
+#include <string>
+
+enum class FlashReadModeEnum {
+    Standard,   // 0x03, no dummy cycle
+    Fast,       // 0x0B, 8 dummy clocks
+    None
+};
+
+class FlashReadModeEnumMapper {
+public:
+    static std::string toString(FlashReadModeEnum mode) {
+        switch (mode) {
+            case FlashReadModeEnum::Standard: return "Standard Read (0x03)";
+            case FlashReadModeEnum::Fast:     return "Fast Read (0x0B)";
+            case FlashReadModeEnum::None:     return "None";
+            default:                          return "Unknown";
+        }
+    }
+};
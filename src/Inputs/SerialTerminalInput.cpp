@@ -1,20 +1,27 @@
 #include "SerialTerminalInput.h"
 #include <Arduino.h>
 
+SerialTerminalInput::SerialTerminalInput(SerialTerminalView& view)
+    : view(view) {}
+
 char SerialTerminalInput::handler() {
+    view.flush();
     while (!Serial.available()) {}
     return Serial.read();
 }
 
 void SerialTerminalInput::waitPress(uint32_t timeoutMs) {
     (void)timeoutMs; // currently not used
+    view.flush();
     while (!Serial.available()) {}
     Serial.read(); // discard
 }
 
 char SerialTerminalInput::readChar() {
     if (Serial.available()) {
+        view.flush();
         return Serial.read();
     }
+    view.flushIfIdle();
     return KEY_NONE;
-}
\ No newline at end of file
+}
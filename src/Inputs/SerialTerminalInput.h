@@ -1,12 +1,19 @@
 #pragma once
 
 #include <Interfaces/IInput.h>
+#include <Views/SerialTerminalView.h>
 #include <Arduino.h>
 #include <vector>
 
 class SerialTerminalInput : public IInput {
 public:
+    explicit SerialTerminalInput(SerialTerminalView& view);
+
     char handler() override;
     void waitPress(uint32_t timeoutMs) override;
     char readChar() override;
+
+private:
+    // Buffered output is pushed out before waiting on the user
+    SerialTerminalView& view;
 };
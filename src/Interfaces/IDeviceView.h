@@ -38,6 +38,9 @@ public:
     // Analogic plotter
     virtual void drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) = 0;
 
+    // Analogic plotter, lowest and highest value of each column
+    virtual void drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) = 0;
+
     // Set screen rotation
     virtual void setRotation(uint8_t rotation) = 0;
 
@@ -1,6 +1,8 @@
 #pragma once
 #include <string>
 #include <vector>
+#include <cstddef>
+#include <cstdint>
 #include <Enums/TerminalTypeEnum.h>
 
 class ITerminalView {
@@ -19,6 +21,12 @@ public:
     virtual void println(const std::string& text) = 0;
     virtual void printPrompt(const std::string& mode = "HIZ") = 0;
 
+    // Write raw bytes as is, for bulk binary output
+    virtual void writeBytes(const uint8_t* data, size_t length) = 0;
+
+    // Push any buffered output to the terminal
+    virtual void flush() = 0;
+
     // Wait press
     virtual void waitPress() = 0;
 
@@ -0,0 +1,150 @@
+#include "I2cRegisterManager.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+
+I2cRegisterManager::I2cRegisterManager(I2cService& i2cService)
+: i2cService(i2cService) {}
+
+I2cRegisterManager::Access I2cRegisterManager::getAccess(uint8_t addr, uint16_t startReg) {
+    addr &= 0x7F;
+    if (access[addr] != Access::Unknown) return access[addr];
+
+    // Not cached when nothing answers, the device may still be powering up
+    uint8_t probe;
+    if (i2cService.isReadableDevice(addr, startReg & 0xFF)) {
+        access[addr] = Access::Register;
+    } else if (i2cService.readRaw(addr, &probe, 1) == 1) {
+        access[addr] = Access::Raw;
+    } else {
+        return Access::None;
+    }
+    return access[addr];
+}
+
+void I2cRegisterManager::forget(uint8_t addr) {
+    access[addr & 0x7F] = Access::Unknown;
+}
+
+size_t I2cRegisterManager::readRanges(uint8_t addr, const std::vector<Range>& ranges, uint16_t base,
+                                      std::vector<uint8_t>& values, std::vector<bool>& valid,
+                                      const std::function<bool()>& shouldAbort) {
+    Access mode = getAccess(addr, ranges.empty() ? 0 : ranges[0].start);
+    if (mode == Access::None) return 0;
+
+    size_t total = 0;
+    int failed = 0;
+
+    for (const auto& range : ranges) {
+        // A register pointer beyond 0xFF needs two address bytes
+        bool wide = (uint32_t)range.start + range.length - 1 > 0xFF;
+
+        for (uint32_t offset = 0; offset < range.length; ) {
+            if (failed >= MAX_FAILED_BURSTS) {
+                forget(addr);
+                return total;
+            }
+            if (shouldAbort && shouldAbort()) return total;
+
+            uint16_t reg = range.start + offset;
+            size_t chunk = std::min<size_t>(range.length - offset, I2cService::MAX_READ);
+            uint8_t buffer[I2cService::MAX_READ];
+
+            // Raw devices only stream from where their pointer is, one burst from the start
+            size_t n = mode == Access::Register
+                ? i2cService.readRegisters(addr, reg, wide, buffer, chunk)
+                : i2cService.readRaw(addr, buffer, chunk);
+
+            for (size_t i = 0; i < n; ++i) {
+                size_t index = reg - base + i;
+                if (index >= values.size()) break;
+                values[index] = buffer[i];
+                valid[index] = true;
+            }
+            total += n;
+
+            if (n == 0) {
+                failed++;
+                offset += chunk; // leave this burst unread
+            } else {
+                failed = 0;
+                offset += n;
+            }
+            if (mode == Access::Raw) break;
+        }
+        if (mode == Access::Raw) break;
+    }
+    return total;
+}
+
+std::vector<I2cRegisterManager::Range> I2cRegisterManager::findChanges(const std::vector<uint8_t>& previous,
+                                                                       const std::vector<uint8_t>& current,
+                                                                       const std::vector<bool>& valid) const {
+    std::vector<Range> runs;
+    size_t n = std::min({ previous.size(), current.size(), valid.size() });
+
+    for (size_t i = 0; i < n; ++i) {
+        if (!valid[i] || previous[i] == current[i]) continue;
+
+        if (!runs.empty() && runs.back().start + runs.back().length == i) {
+            runs.back().length++;
+        } else {
+            runs.push_back({ (uint16_t)i, 1 });
+        }
+    }
+    return runs;
+}
+
+uint32_t I2cRegisterManager::adaptInterval(uint32_t intervalMs, bool changed, uint32_t minMs, uint32_t maxMs) {
+    // Halve on a change to catch the next one, back off slowly while it is quiet
+    uint32_t next = changed ? intervalMs / 2 : intervalMs + std::max<uint32_t>(1, intervalMs / 4);
+    return std::min(maxMs, std::max(minMs, next));
+}
+
+bool I2cRegisterManager::parseRanges(const std::string& text, std::vector<Range>& ranges) {
+    ranges.clear();
+    std::vector<std::pair<uint32_t, uint32_t>> spans;
+
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t comma = text.find(',', pos);
+        std::string token = text.substr(pos, comma == std::string::npos ? std::string::npos : comma - pos);
+        pos = comma == std::string::npos ? text.size() + 1 : comma + 1;
+        if (token.empty()) continue;
+
+        // Each end is hex with 0x, or decimal
+        size_t dash = token.find('-', 1);
+        std::string first = token.substr(0, dash);
+        std::string last = dash == std::string::npos ? first : token.substr(dash + 1);
+
+        unsigned long lo = 0, hi = 0;
+        if (!parseNumber(first, lo) || !parseNumber(last, hi)) return false;
+        if (hi < lo || hi > 0xFFFF || hi - lo >= 0xFFFF) return false;
+
+        spans.push_back({ (uint32_t)lo, (uint32_t)hi });
+    }
+    if (spans.empty()) return false;
+
+    // Overlapping or touching spans are read in the same bursts
+    std::sort(spans.begin(), spans.end());
+    for (const auto& span : spans) {
+        if (!ranges.empty() && span.first <= (uint32_t)ranges.back().start + ranges.back().length) {
+            uint32_t end = std::max<uint32_t>(ranges.back().start + ranges.back().length, span.second + 1);
+            ranges.back().length = std::min<uint32_t>(end - ranges.back().start, 0xFFFF);
+        } else {
+            ranges.push_back({ (uint16_t)span.first, (uint16_t)(span.second - span.first + 1) });
+        }
+    }
+    return true;
+}
+
+bool I2cRegisterManager::parseNumber(const std::string& text, unsigned long& value) {
+    // Base 0 would read a leading zero as octal
+    bool hex = text.size() > 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X');
+    const char* digits = text.c_str() + (hex ? 2 : 0);
+    if (!isxdigit((unsigned char)*digits) || (!hex && !isdigit((unsigned char)*digits))) return false;
+
+    char* end = nullptr;
+    value = strtoul(digits, &end, hex ? 16 : 10);
+    return *end == '\0' && value <= 0xFFFF;
+}
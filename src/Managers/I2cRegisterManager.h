@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <vector>
+#include <functional>
+#include "Services/I2cService.h"
+
+/*
+Register dumps and monitoring of I2C devices.
+Reads go in bursts as large as the Wire buffer, relying on the register
+pointer auto-increment. How a device answers (register pointer or raw
+read) is probed once and kept until a read fails.
+*/
+class I2cRegisterManager {
+public:
+    enum class Access : uint8_t { Unknown, Register, Raw, None };
+
+    struct Range {
+        uint16_t start;
+        uint16_t length;
+    };
+
+    explicit I2cRegisterManager(I2cService& i2cService);
+
+    // Cached per address, probed on first use
+    Access getAccess(uint8_t addr, uint16_t startReg = 0);
+    void forget(uint8_t addr);
+
+    // Read the ranges into values/valid, indexed by register from `base`
+    // Returns the bytes read, stops on 3 failed bursts in a row or on abort
+    size_t readRanges(uint8_t addr, const std::vector<Range>& ranges, uint16_t base,
+                      std::vector<uint8_t>& values, std::vector<bool>& valid,
+                      const std::function<bool()>& shouldAbort = nullptr);
+
+    // Consecutive registers that differ, valid in both reads
+    std::vector<Range> findChanges(const std::vector<uint8_t>& previous, const std::vector<uint8_t>& current,
+                                   const std::vector<bool>& valid) const;
+
+    // Next poll interval, faster while registers change, slower while they do not
+    static uint32_t adaptInterval(uint32_t intervalMs, bool changed, uint32_t minMs, uint32_t maxMs);
+
+    // "0x10-0x1F,0x40,0x80-0x8F", end inclusive, sorted and merged
+    static bool parseRanges(const std::string& text, std::vector<Range>& ranges);
+
+    static constexpr int MAX_FAILED_BURSTS = 3;
+
+private:
+    static bool parseNumber(const std::string& text, unsigned long& value);
+
+    I2cService& i2cService;
+    Access access[128] = {};
+};
@@ -0,0 +1,118 @@
+#include "MacroManager.h"
+
+MacroManager::MacroManager(LittleFsService& littleFsService, InstructionTransformer& instructionTransformer)
+    : littleFsService(littleFsService),
+      instructionTransformer(instructionTransformer) {}
+
+/*
+Get
+*/
+const std::vector<ByteCode>* MacroManager::get(ModeEnum mode, uint8_t id) {
+    auto& macros = load(mode);
+    auto it = macros.find(id);
+    return it != macros.end() ? &it->second.program : nullptr;
+}
+
+/*
+List
+*/
+const std::map<uint8_t, MacroManager::Macro>& MacroManager::list(ModeEnum mode) {
+    return load(mode);
+}
+
+/*
+Define
+*/
+bool MacroManager::define(ModeEnum mode, uint8_t id, const std::string& source) {
+    Macro macro;
+    macro.source = source;
+    if (!instructionTransformer.compile(source, macro.program) || macro.program.empty()) {
+        return false;
+    }
+
+    auto& macros = load(mode);
+    macros[id] = std::move(macro);
+    return save(mode);
+}
+
+/*
+Remove
+*/
+bool MacroManager::remove(ModeEnum mode, uint8_t id) {
+    auto& macros = load(mode);
+    if (macros.erase(id) == 0) return false;
+    return save(mode);
+}
+
+/*
+Path
+*/
+std::string MacroManager::pathFor(ModeEnum mode) const {
+    std::string name = ModeEnumMapper::toString(mode);
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    return "/" + name + ".macro";
+}
+
+/*
+Load mode file, once
+*/
+std::map<uint8_t, MacroManager::Macro>& MacroManager::load(ModeEnum mode) {
+    auto cached = cache.find(mode);
+    if (cached != cache.end()) return cached->second;
+
+    auto& macros = cache[mode];
+
+    if (!littleFsService.mounted()) {
+        littleFsService.begin();
+    }
+
+    std::string content;
+    if (!littleFsService.readAll(pathFor(mode), content)) {
+        return macros;
+    }
+
+    size_t pos = 0;
+    while (pos < content.size()) {
+        size_t eol = content.find('\n', pos);
+        if (eol == std::string::npos) eol = content.size();
+        std::string line = content.substr(pos, eol - pos);
+        pos = eol + 1;
+
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        // id=instructions
+        size_t eq = line.find('=');
+        if (eq == std::string::npos || eq == 0) continue;
+        std::string idStr = line.substr(0, eq);
+        // At most 3 digits, a longer id is invalid and would overflow stoul
+        if (idStr.size() > 3 || !std::all_of(idStr.begin(), idStr.end(), ::isdigit)) continue;
+        unsigned long id = std::stoul(idStr);
+        if (id == 0 || id > 255) continue;
+
+        Macro macro;
+        macro.source = line.substr(eq + 1);
+        if (instructionTransformer.compile(macro.source, macro.program) && !macro.program.empty()) {
+            macros[static_cast<uint8_t>(id)] = std::move(macro);
+        }
+    }
+
+    return macros;
+}
+
+/*
+Save mode file
+*/
+bool MacroManager::save(ModeEnum mode) {
+    if (!littleFsService.mounted()) {
+        littleFsService.begin();
+    }
+
+    auto& macros = cache[mode];
+    std::string content = "# " + ModeEnumMapper::toString(mode) + " macros, id=instructions\n";
+    for (const auto& entry : macros) {
+        content += std::to_string(entry.first) + "=" + entry.second.source + "\n";
+    }
+
+    return littleFsService.write(pathFor(mode), content);
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Models/ByteCode.h"
+#include "Enums/ModeEnum.h"
+#include "Services/LittleFsService.h"
+#include "Transformers/InstructionTransformer.h"
+
+/*
+Macros are instruction lines stored per mode on LittleFS, one per line:
+
+    # comment
+    1=[0x50 0x01 0x80] [0x50 0x02 0x10]
+    2=[0x9F r:3]
+
+Each mode file is parsed and compiled once, then macros are replayed
+from the cached bytecode program.
+*/
+class MacroManager {
+public:
+    struct Macro {
+        std::string source;
+        std::vector<ByteCode> program;
+    };
+
+    MacroManager(LittleFsService& littleFsService, InstructionTransformer& instructionTransformer);
+
+    // Compiled program for the macro, nullptr if undefined
+    const std::vector<ByteCode>* get(ModeEnum mode, uint8_t id);
+
+    // All macros for the mode, ordered by id
+    const std::map<uint8_t, Macro>& list(ModeEnum mode);
+
+    // Compile, cache and persist a macro, false if the source does not compile or save
+    bool define(ModeEnum mode, uint8_t id, const std::string& source);
+
+    // Remove a macro and persist the mode file
+    bool remove(ModeEnum mode, uint8_t id);
+
+    // Path of the macro file for the mode
+    std::string pathFor(ModeEnum mode) const;
+
+private:
+    LittleFsService& littleFsService;
+    InstructionTransformer& instructionTransformer;
+    std::map<ModeEnum, std::map<uint8_t, Macro>> cache;
+
+    std::map<uint8_t, Macro>& load(ModeEnum mode);
+    bool save(ModeEnum mode);
+};
@@ -3,22 +3,35 @@
 #include <sstream>
 #include <cmath>
 
-PinAnalyzeManager::PinAnalyzeManager(PinService& pinService)
-: pinService(pinService) {}
+PinAnalyzeManager::PinAnalyzeManager(PinService& pinService, EdgeCaptureService& edgeCaptureService)
+: pinService(pinService), edgeCaptureService(edgeCaptureService) {}
 
 void PinAnalyzeManager::begin(uint8_t pin_) {
     end(); // clean up if rebeginning
-    pulseRing = new uint32_t[PULSE_RING];
-    riseUs    = new uint32_t[RISE_RING];
+    pinService.setInput(pin_);
 
-    pin = pin_;
-    pinService.setInput(pin);
+    // Hardware edge timestamps, the timeline starts on the same instant as micros()
+    timeline.start(ESP.getCycleCount(), micros(), getCpuFrequencyMhz());
+    interruptEdges = edgeCaptureService.begin(pin_);
+    droppedAtStart = edgeCaptureService.getDropped();
+
+    start(pin_, pinService.read(pin_), nowUs());
+}
 
-    lastLevel = pinService.read(pin);
+void PinAnalyzeManager::beginExternal(uint8_t pin_, bool level, uint32_t nowUs_) {
+    end();
+    external = true;
+    externalNowUs = nowUs_;
+    start(pin_, level, nowUs_);
+}
+
+void PinAnalyzeManager::start(uint8_t pin_, bool level, uint32_t nowUs_) {
+    pin = pin_;
+    lastLevel = level;
     startLevel = lastLevel;
 
     windowStartMs = millis();
-    lastChangeUs = micros();
+    lastChangeUs = nowUs_;
 
     edges = 0;
     highUs = 0;
@@ -32,25 +45,19 @@ void PinAnalyzeManager::begin(uint8_t pin_) {
     maxGapUs = 0;
     inBurst = false;
 
-    pulseCount = 0;
-    pulseHead = 0;
+    pulseStats.reset();
+    risePeriodStats.reset();
 
-    riseCount = 0;
-    riseHead = 0;
+    riseSeen = false;
     lastRiseUs = 0;
     lastHighPulseUs = 0;
 }
 
 void PinAnalyzeManager::end() {
-    if (pulseRing) {
-        delete[] pulseRing;
-        pulseRing = nullptr;
-    }
-
-    if (riseUs) {
-        delete[] riseUs;
-        riseUs = nullptr;
-    }
+    // The caller owns the edge source in fed mode
+    if (!external) edgeCaptureService.end();
+    interruptEdges = false;
+    external = false;
 }
 
 bool PinAnalyzeManager::shouldReport(unsigned long nowMs) const {
@@ -58,11 +65,53 @@ bool PinAnalyzeManager::shouldReport(unsigned long nowMs) const {
 }
 
 void PinAnalyzeManager::sample() {
+    if (external) return;
+
+    if (interruptEdges) {
+        drainEdges();
+        nowUs(); // keeps the timeline ahead of the cycle counter wrap
+        return;
+    }
+
     bool v = pinService.read(pin);
     if (v == lastLevel) return;
     onEdge(v, micros());
 }
 
+void PinAnalyzeManager::drainEdges() {
+    EdgeCaptureService::Edge batch[64];
+    size_t n;
+
+    while ((n = edgeCaptureService.read(batch, 64)) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            feedEdge(batch[i].level, timeline.advance(batch[i].cycles));
+        }
+    }
+}
+
+void PinAnalyzeManager::feedEdge(bool level, uint32_t nowUs_) {
+    // Both edges of a pulse shorter than the interrupt latency
+    if (level == lastLevel) onEdge(!level, nowUs_);
+    onEdge(level, nowUs_);
+    externalNowUs = nowUs_;
+}
+
+void PinAnalyzeManager::setNowUs(uint32_t nowUs_) {
+    externalNowUs = nowUs_;
+}
+
+uint32_t PinAnalyzeManager::nowUs() {
+    if (external) return externalNowUs;
+    if (!interruptEdges) return micros();
+
+    // Read the clock first, an edge stamped before it would still be in the ring
+    while (true) {
+        uint32_t cycles = ESP.getCycleCount();
+        if (!edgeCaptureService.hasPending()) return timeline.advance(cycles);
+        drainEdges();
+    }
+}
+
 void PinAnalyzeManager::onEdge(bool newLevel, uint32_t nowUs) {
     uint32_t dt = nowUs - lastChangeUs;
 
@@ -74,9 +123,7 @@ void PinAnalyzeManager::onEdge(bool newLevel, uint32_t nowUs) {
     if (dt < minPulseUs) minPulseUs = dt;
     if (dt > maxPulseUs) maxPulseUs = dt;
 
-    pulseRing[pulseHead] = dt;
-    pulseHead = (pulseHead + 1) % PULSE_RING;
-    if (pulseCount < PULSE_RING) pulseCount++;
+    pulseStats.add(dt);
 
     // Burst detection
     const uint32_t gapThresholdUs = 5000; // 5ms
@@ -91,13 +138,8 @@ void PinAnalyzeManager::onEdge(bool newLevel, uint32_t nowUs) {
 
     // Rising edges for servo period
     if (!lastLevel && newLevel) { // LOW->HIGH
-        riseUs[riseHead] = nowUs;
-        riseHead = (riseHead + 1) % RISE_RING;
-        if (riseCount < RISE_RING) riseCount++;
-
-        if (lastRiseUs != 0) {
-            // period candidate is time between rising edges (collected later)
-        }
+        if (riseSeen) risePeriodStats.add(nowUs - lastRiseUs);
+        riseSeen = true;
         lastRiseUs = nowUs;
     }
 
@@ -116,15 +158,16 @@ void PinAnalyzeManager::closeTail(uint32_t nowUs) {
     if (lastLevel) highUs += dt;
     else           lowUs  += dt;
 
-    // Don’t push tail into pulse ring
+    // Don’t push tail into pulse stats
     lastChangeUs = nowUs;
 }
 
 void PinAnalyzeManager::resetWindow() {
     // Start a fresh window from current state
     windowStartMs = millis();
-    lastChangeUs = micros();
+    lastChangeUs = nowUs();
     startLevel = lastLevel;
+    droppedAtStart = edgeCaptureService.getDropped();
 
     edges = 0;
     highUs = 0;
@@ -137,85 +180,28 @@ void PinAnalyzeManager::resetWindow() {
     maxGapUs = 0;
     inBurst = false;
 
-    pulseCount = 0;
-    pulseHead = 0;
+    pulseStats.reset();
+    risePeriodStats.reset();
     basePulseUs = 0;
 
-    riseCount = 0;
-    riseHead = 0;
+    riseSeen = false;
     lastRiseUs = 0;
     lastHighPulseUs = 0;
 }
 
-void PinAnalyzeManager::collectPulses(std::vector<uint32_t>& out) const {
-    out.clear();
-    out.reserve(pulseCount);
-
-    // Oldest -> newest
-    int start = (pulseHead - pulseCount);
-    if (start < 0) start += PULSE_RING;
-
-    for (int i = 0; i < (int)pulseCount; i++) {
-        int idx = (start + i) % PULSE_RING;
-        out.push_back(pulseRing[idx]);
-    }
-}
-
-void PinAnalyzeManager::collectRisePeriods(std::vector<uint32_t>& outPeriods) const {
-    outPeriods.clear();
-    if (riseCount < 2) return;
-
-    // Oldest -> newest
-    int start = (riseHead - riseCount);
-    if (start < 0) start += RISE_RING;
-
-    uint32_t prev = 0;
-    for (int i = 0; i < (int)riseCount; i++) {
-        int idx = (start + i) % RISE_RING;
-        uint32_t t = riseUs[idx];
-        if (prev != 0 && t > prev) outPeriods.push_back(t - prev);
-        prev = t;
-    }
-}
-
-void PinAnalyzeManager::collectHighPulses(std::vector<uint32_t>& outHighPulses) const {
-    // We don’t store a ring of highs here to keep it light;
-    // Instead, we infer from pulse distribution + duty + min/max.
-    // If you want, we can store high pulse widths on each falling edge.
-    outHighPulses.clear();
-}
-
-uint32_t PinAnalyzeManager::medianOf(std::vector<uint32_t>& v) {
-    if (v.empty()) return 0;
-    std::sort(v.begin(), v.end());
-    size_t n = v.size();
-    if (n & 1) return v[n/2];
-    return (uint32_t)((v[n/2 - 1] + v[n/2]) / 2);
-}
-
-uint32_t PinAnalyzeManager::estimateBaseT(const std::vector<uint32_t>& pulses) {
-    if (pulses.size() < 10) return 0;
+uint32_t PinAnalyzeManager::estimateBaseT(const StreamingStats& pulses) {
+    if (pulses.getCount() < 10) return 0;
 
     // Take short pulses as timing base candidate
-    std::vector<uint32_t> v = pulses;
-    std::sort(v.begin(), v.end());
-    size_t m = std::max<size_t>(8, v.size()/4);
-    v.resize(m);
-    return medianOf(v);
+    return (uint32_t)(pulses.shortMedian(8) + 0.5f);
 }
 
-float PinAnalyzeManager::jitterScorePct(const std::vector<uint32_t>& pulses, uint32_t ref) {
-    if (pulses.size() < 10 || ref == 0) return 100.f;
+float PinAnalyzeManager::jitterScorePct(const StreamingStats& pulses, uint32_t ref) {
+    if (pulses.getCount() < 10 || ref == 0) return 100.f;
 
     // MAD around ref
-    std::vector<uint32_t> dev;
-    dev.reserve(pulses.size());
-    for (auto p : pulses) {
-        uint32_t d = (p > ref) ? (p - ref) : (ref - p);
-        dev.push_back(d);
-    }
-    uint32_t mad = medianOf(dev);
-    float pct = (100.0f * (float)mad) / (float)ref;
+    float mad = pulses.deviationQuantile((float)ref, 0.5f);
+    float pct = (100.0f * mad) / (float)ref;
     if (pct < 0.f) pct = 0.f;
     if (pct > 200.f) pct = 200.f;
     return pct;
@@ -251,7 +237,7 @@ PinAnalyzeManager::Guess PinAnalyzeManager::detectIdle(float approxHz, float dut
     return g;
 }
 
-PinAnalyzeManager::Guess PinAnalyzeManager::detectNoiseOrFloating(const std::vector<uint32_t>& pulses, float jitterPct, uint32_t minP, uint32_t edges_) const {
+PinAnalyzeManager::Guess PinAnalyzeManager::detectNoiseOrFloating(const StreamingStats& pulses, float jitterPct, uint32_t minP, uint32_t edges_) const {
     Guess g;
     if (edges_ < 5) return g;
 
@@ -264,11 +250,9 @@ PinAnalyzeManager::Guess PinAnalyzeManager::detectNoiseOrFloating(const std::vec
     }
 
     // Very broad distribution (max >> median) and jitter high
-    if (!pulses.empty()) {
-        std::vector<uint32_t> tmp = pulses;
-        uint32_t med = medianOf(tmp);
-        uint32_t mx = 0;
-        for (auto p : pulses) if (p > mx) mx = p;
+    if (pulses.getCount()) {
+        uint32_t med = (uint32_t)(pulses.median() + 0.5f);
+        uint32_t mx = pulses.getMax();
 
         if (med > 0 && mx > (med * 20) && jitterPct > 80.f) {
             g.kind = SignalKind::NoiseOrFloating;
@@ -331,16 +315,12 @@ PinAnalyzeManager::Guess PinAnalyzeManager::detectClockPwm(float approxHz,
     return Guess{};
 }
 
-PinAnalyzeManager::Guess PinAnalyzeManager::detectServo(const std::vector<uint32_t>& risePeriods, const std::vector<uint32_t>& /*highPulses*/) const {
+PinAnalyzeManager::Guess PinAnalyzeManager::detectServo(const StreamingStats& risePeriods) const {
     Guess g;
-    if (risePeriods.size() < 6) return g;
+    if (risePeriods.getCount() < 6) return g;
 
     // Servo: period ~20ms (50Hz). We just detect a strong cluster near 20ms.
-    int near20 = 0;
-    for (auto p : risePeriods) {
-        if (p > 15000 && p < 25000) near20++;
-    }
-    float ratio = (float)near20 / (float)risePeriods.size();
+    float ratio = risePeriods.fractionBetween(15000.f, 25000.f);
     if (ratio > 0.70f) {
         g.kind = SignalKind::Servo;
         g.confidencePct = 78;
@@ -350,28 +330,27 @@ PinAnalyzeManager::Guess PinAnalyzeManager::detectServo(const std::vector<uint32
     return g;
 }
 
-PinAnalyzeManager::Guess PinAnalyzeManager::detectDataLike(const std::vector<uint32_t>& pulses, uint32_t baseT) const {
+PinAnalyzeManager::Guess PinAnalyzeManager::detectDataLike(const StreamingStats& pulses, uint32_t baseT) const {
     Guess g;
-    if (pulses.size() < 30 || baseT < 2 || baseT > 2000) return g;
+    if (pulses.getCount() < 30 || baseT < 2 || baseT > 2000) return g;
 
-    // Check how many pulses are close to N*T
-    int ok = 0;
-    int total = 0;
+    // Check how many pulses are close to N*T, one histogram bin at a time
+    uint32_t ok = 0;
+    uint32_t total = 0;
     float tol = baseT * 0.25f;
 
-    for (auto p : pulses) {
-        if (p < baseT / 2) continue;
-        total++;
+    pulses.forEachBin([&](float p, uint32_t weight) {
+        if (p < baseT / 2) return;
+        total += weight;
 
-        int bestN = 0;
         float bestErr = 1e9f;
         for (int n = 1; n <= 8; n++) {
             float target = (float)baseT * n;
-            float err = fabsf((float)p - target);
-            if (err < bestErr) { bestErr = err; bestN = n; }
+            float err = fabsf(p - target);
+            if (err < bestErr) bestErr = err;
         }
-        if (bestErr <= tol) ok++;
-    }
+        if (bestErr <= tol) ok += weight;
+    });
 
     if (total < 20) return g;
 
@@ -460,7 +439,7 @@ PinAnalyzeManager::Report PinAnalyzeManager::buildReport(bool doPullTest) {
     Report r;
 
     // Close tail to include the last stable segment time in high/low
-    closeTail(micros());
+    closeTail(nowUs());
 
     uint32_t elapsedMs = (uint32_t)(millis() - windowStartMs);
     if (elapsedMs == 0) elapsedMs = 1;
@@ -473,6 +452,8 @@ PinAnalyzeManager::Report PinAnalyzeManager::buildReport(bool doPullTest) {
     r.bursts = bursts;
     r.burstEdges = burstEdges;
     r.maxGapUs = maxGapUs;
+    r.polled = !interruptEdges && !external;
+    r.droppedEdges = interruptEdges ? edgeCaptureService.getDropped() - droppedAtStart : 0;
 
     uint32_t totalUs = highUs + lowUs;
     r.dutyPct = (totalUs ? (100.0f * (float)highUs) / (float)totalUs : 0.f);
@@ -481,26 +462,18 @@ PinAnalyzeManager::Report PinAnalyzeManager::buildReport(bool doPullTest) {
     r.approxHz = (seconds > 0.f) ? ((edges / 2.0f) / seconds) : 0.f;
 
 
-    // Pulse features
-    std::vector<uint32_t> pulses;
-    collectPulses(pulses);
-
-    if (!pulses.empty()) {
-        std::vector<uint32_t> tmp = pulses;
-        r.medianPulseUs = medianOf(tmp);
-        r.basePulseUs = estimateBaseT(pulses);
+    // Pulse features, read from the running stats while sampling goes on
+    if (pulseStats.getCount()) {
+        r.medianPulseUs = (uint32_t)(pulseStats.median() + 0.5f);
+        r.basePulseUs = estimateBaseT(pulseStats);
         basePulseUs = r.basePulseUs;
-        r.jitterPct = jitterScorePct(pulses, r.basePulseUs ? r.basePulseUs : r.medianPulseUs);
+        r.jitterPct = jitterScorePct(pulseStats, r.basePulseUs ? r.basePulseUs : r.medianPulseUs);
     } else {
         r.medianPulseUs = 0;
         r.basePulseUs = 0;
         r.jitterPct = 100.f;
     }
 
-    // Rise periods (servo)
-    std::vector<uint32_t> risePeriods;
-    collectRisePeriods(risePeriods);
-
     // Guesses
     std::vector<Guess> guesses;
     guesses.reserve(8);
@@ -508,16 +481,16 @@ PinAnalyzeManager::Report PinAnalyzeManager::buildReport(bool doPullTest) {
     auto gIdle  = detectIdle(r.approxHz, r.dutyPct, r.edges, startLevel);
     if (gIdle.confidencePct) guesses.push_back(gIdle);
 
-    auto gNoise = detectNoiseOrFloating(pulses, r.jitterPct, r.minPulseUs, r.edges);
+    auto gNoise = detectNoiseOrFloating(pulseStats, r.jitterPct, r.minPulseUs, r.edges);
     if (gNoise.confidencePct) guesses.push_back(gNoise);
 
     auto gCP = detectClockPwm(r.approxHz, r.dutyPct, r.jitterPct, r.edges);
     if (gCP.confidencePct) guesses.push_back(gCP);
 
-    auto gServo = detectServo(risePeriods, {});
+    auto gServo = detectServo(risePeriodStats);
     if (gServo.confidencePct) guesses.push_back(gServo);
 
-    auto gData = detectDataLike(pulses, r.basePulseUs);
+    auto gData = detectDataLike(pulseStats, r.basePulseUs);
     if (gData.confidencePct) guesses.push_back(gData);
 
     auto gBurst = detectBurstData(bursts, r.edges, r.approxHz, r.jitterPct);
@@ -630,6 +603,10 @@ std::string PinAnalyzeManager::formatWizardReport(uint8_t pin, const Report& r)
         line(r.pullHint);
     }
 
+    if (r.droppedEdges) {
+        line("Edges came faster than they could be timestamped (" + std::to_string(r.droppedEdges) + " dropped).");
+    }
+
     // Technical line
     {
         std::string tech = "Report: edges/sec=" + std::to_string(r.edgesPerSec) +
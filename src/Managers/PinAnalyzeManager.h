@@ -6,6 +6,9 @@
 #include <vector>
 #include <functional>
 #include "Services/PinService.h"
+#include "Services/EdgeCaptureService.h"
+#include "Models/CycleTimeline.h"
+#include "Models/StreamingStats.h"
 
 class PinAnalyzeManager {
 public:
@@ -51,23 +54,45 @@ public:
         // Pull test hints
         bool pullTestDone = false;
         std::string pullHint;
+
+        // Edges the interrupt could not keep up with
+        uint32_t droppedEdges = 0;
+        bool polled = false;
     };
 
 public:
-    explicit PinAnalyzeManager(PinService& pinService);
+    PinAnalyzeManager(PinService& pinService, EdgeCaptureService& edgeCaptureService);
 
     void begin(uint8_t pin);
     void end();
     void sample(); 
+
+    // Analyze edges timestamped by someone else (several pins at once)
+    void beginExternal(uint8_t pin, bool level, uint32_t nowUs);
+    void feedEdge(bool level, uint32_t nowUs);
+    void setNowUs(uint32_t nowUs);
     bool shouldReport(unsigned long nowMs) const; 
     Report buildReport(bool doPullTest);
     std::string formatWizardReport(uint8_t pin, const Report& r) const;
     void resetWindow();
 
+    static const char* kindToStr(SignalKind k);
+
 private:
     PinService& pinService;
+    EdgeCaptureService& edgeCaptureService;
     uint8_t pin = 0;
 
+    // Edge timestamps from the interrupt, polling when it is not available.
+    // The timeline is kept ahead of the cycle counter wrap while the ring is empty.
+    bool interruptEdges = false;
+    CycleTimeline timeline;
+    uint32_t droppedAtStart = 0;
+
+    // Fed mode, edges and time come from the caller
+    bool external = false;
+    uint32_t externalNowUs = 0;
+
     // Window timing
     unsigned long windowStartMs = 0;
     unsigned long nextReportMs  = 0;
@@ -90,18 +115,13 @@ private:
     uint32_t maxGapUs = 0;
     bool inBurst = false;
 
-    // Pulse ring buffer
-    static constexpr int PULSE_RING = 256;
-    uint32_t *pulseRing = nullptr;
-    uint16_t pulseCount = 0; 
-    uint16_t pulseHead = 0;    // next index to write
+    // Pulse widths and rising edge periods, updated on every edge
+    StreamingStats pulseStats;
+    StreamingStats risePeriodStats;
     uint32_t basePulseUs = 0;
 
     // Rising-edge based
-    static constexpr int RISE_RING = 64;
-    uint32_t *riseUs = nullptr;
-    uint16_t riseCount = 0;
-    uint16_t riseHead = 0;
+    bool riseSeen = false;
     uint32_t lastRiseUs = 0;
     uint32_t lastHighPulseUs = 0;
 
@@ -109,29 +129,25 @@ private:
 
 private:
     void onEdge(bool newLevel, uint32_t nowUs);
+    void start(uint8_t pin, bool level, uint32_t nowUs);
+    void drainEdges();
+    uint32_t nowUs();
     void closeTail(uint32_t nowUs);
 
     // Stats helpers
-    static uint32_t medianOf(std::vector<uint32_t>& v);
-    static uint32_t estimateBaseT(const std::vector<uint32_t>& pulses);
-    static float jitterScorePct(const std::vector<uint32_t>& pulses, uint32_t ref);
+    static uint32_t estimateBaseT(const StreamingStats& pulses);
+    static float jitterScorePct(const StreamingStats& pulses, uint32_t ref);
     static int clampInt(int v, int lo, int hi);
 
     // Pattern detectors
     Guess detectIdle(float approxHz, float dutyPct, uint32_t edges, bool startLevel) const;
-    Guess detectNoiseOrFloating(const std::vector<uint32_t>& pulses, float jitterPct, uint32_t minPulseUs, uint32_t edges) const;
+    Guess detectNoiseOrFloating(const StreamingStats& pulses, float jitterPct, uint32_t minPulseUs, uint32_t edges) const;
     Guess detectClockPwm(float approxHz, float dutyPct, float jitterPct, uint32_t edges) const;
-    Guess detectServo(const std::vector<uint32_t>& risePeriods, const std::vector<uint32_t>& highPulses) const;
-    Guess detectDataLike(const std::vector<uint32_t>& pulses, uint32_t baseT) const;
+    Guess detectServo(const StreamingStats& risePeriods) const;
+    Guess detectDataLike(const StreamingStats& pulses, uint32_t baseT) const;
     Guess detectBurstData(int bursts, uint32_t edges, float approxHz, float jitterPct) const;
 
     // Pull tests
     std::string runPullTest();
 
-    // Collectors
-    void collectPulses(std::vector<uint32_t>& out) const;
-    void collectRisePeriods(std::vector<uint32_t>& outPeriods) const;
-    void collectHighPulses(std::vector<uint32_t>& outHighPulses) const;
-
-    static const char* kindToStr(SignalKind k);
 };
@@ -0,0 +1,144 @@
+#include "PinSurveyManager.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+
+PinSurveyManager::PinSurveyManager(PinService& pinService, EdgeCaptureService& edgeCaptureService)
+: pinService(pinService), edgeCaptureService(edgeCaptureService) {}
+
+bool PinSurveyManager::begin(const std::vector<uint8_t>& newPins) {
+    end();
+    if (newPins.empty() || newPins.size() > EdgeCaptureService::MAX_CHANNELS) return false;
+
+    pins = newPins;
+    for (auto pin : pins) pinService.setInput(pin);
+
+    // All pins share the timeline, it starts on the same instant as micros()
+    timeline.start(ESP.getCycleCount(), micros(), getCpuFrequencyMhz());
+    if (!edgeCaptureService.begin(pins)) {
+        pins.clear();
+        return false;
+    }
+    droppedAtStart = edgeCaptureService.getDropped();
+
+    uint32_t now = nowUs();
+    for (auto pin : pins) {
+        auto analyzer = std::unique_ptr<PinAnalyzeManager>(new PinAnalyzeManager(pinService, edgeCaptureService));
+        analyzer->beginExternal(pin, pinService.read(pin), now);
+        analyzers.push_back(std::move(analyzer));
+    }
+    return true;
+}
+
+void PinSurveyManager::end() {
+    edgeCaptureService.end();
+    for (auto& analyzer : analyzers) analyzer->end();
+    analyzers.clear();
+    pins.clear();
+}
+
+void PinSurveyManager::sample() {
+    drainEdges();
+    nowUs(); // keeps the timeline ahead of the cycle counter wrap
+}
+
+void PinSurveyManager::drainEdges() {
+    EdgeCaptureService::Edge batch[64];
+    size_t n;
+
+    while ((n = edgeCaptureService.read(batch, 64)) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            const auto& edge = batch[i];
+            if (edge.channel < analyzers.size()) {
+                analyzers[edge.channel]->feedEdge(edge.level, timeline.advance(edge.cycles));
+            }
+        }
+    }
+}
+
+uint32_t PinSurveyManager::nowUs() {
+    // Read the clock first, an edge stamped before it would still be in the ring
+    while (true) {
+        uint32_t cycles = ESP.getCycleCount();
+        if (!edgeCaptureService.hasPending()) return timeline.advance(cycles);
+        drainEdges();
+    }
+}
+
+bool PinSurveyManager::shouldReport(unsigned long nowMs) const {
+    return !analyzers.empty() && analyzers.front()->shouldReport(nowMs);
+}
+
+std::vector<PinSurveyManager::Row> PinSurveyManager::buildReports() {
+    std::vector<Row> rows;
+    rows.reserve(analyzers.size());
+
+    uint32_t now = nowUs();
+    for (size_t i = 0; i < analyzers.size(); ++i) {
+        analyzers[i]->setNowUs(now);
+        Row row;
+        row.pin = pins[i];
+        row.report = analyzers[i]->buildReport(false);
+        rows.push_back(row);
+    }
+
+    // Active pins first, by confidence then by activity
+    std::stable_sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+        bool aIdle = a.report.edges == 0 || a.report.top1.kind == PinAnalyzeManager::SignalKind::Idle;
+        bool bIdle = b.report.edges == 0 || b.report.top1.kind == PinAnalyzeManager::SignalKind::Idle;
+        if (aIdle != bIdle) return !aIdle;
+        if (a.report.top1.confidencePct != b.report.top1.confidencePct) {
+            return a.report.top1.confidencePct > b.report.top1.confidencePct;
+        }
+        return a.report.edgesPerSec > b.report.edgesPerSec;
+    });
+    return rows;
+}
+
+std::string PinSurveyManager::formatSurveyTable(const std::vector<Row>& rows) const {
+    std::ostringstream oss;
+
+    oss << "[Wizard survey on " << rows.size() << " pins]\r\n";
+    oss << "  GPIO  Guess           Conf   Edges/s      ~Hz   Duty  Details\r\n";
+
+    for (const auto& row : rows) {
+        const auto& r = row.report;
+        bool idle = r.edges == 0;
+
+        oss << "  " << std::left << std::setw(4) << (int)row.pin << "  "
+            << std::setw(14) << (idle ? "Idle" : PinAnalyzeManager::kindToStr(r.top1.kind)) << "  "
+            << std::right << std::setw(3) << (idle ? 0 : r.top1.confidencePct) << "%  "
+            << std::setw(8) << r.edgesPerSec << "  "
+            << std::setw(7) << (int)(r.approxHz + 0.5f) << "  "
+            << std::setw(4) << (int)(r.dutyPct + 0.5f) << "%  ";
+
+        if (idle) {
+            oss << "stays " << (r.highUs > r.lowUs ? "HIGH" : "LOW");
+        } else {
+            if (!r.top1.extra.empty()) oss << r.top1.extra << " ";
+            if (r.minPulseUs != 0xFFFFFFFF) oss << "min " << r.minPulseUs << "us";
+        }
+        oss << "\r\n";
+    }
+
+    uint32_t dropped = getDroppedEdges();
+    if (dropped) {
+        oss << "  Edges came faster than they could be timestamped (" << dropped << " dropped).\r\n";
+    }
+
+    oss << "\r\n";
+    return oss.str();
+}
+
+void PinSurveyManager::resetWindow() {
+    uint32_t now = nowUs();
+    for (auto& analyzer : analyzers) {
+        analyzer->setNowUs(now);
+        analyzer->resetWindow();
+    }
+    droppedAtStart = edgeCaptureService.getDropped();
+}
+
+uint32_t PinSurveyManager::getDroppedEdges() const {
+    return edgeCaptureService.getDropped() - droppedAtStart;
+}
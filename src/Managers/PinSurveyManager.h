@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <memory>
+#include "Services/PinService.h"
+#include "Services/EdgeCaptureService.h"
+#include "Managers/PinAnalyzeManager.h"
+#include "Models/CycleTimeline.h"
+
+/*
+Signal discovery on several pins in the same window.
+One interrupt per pin timestamps edges into the shared ring,
+each pin runs its own PinAnalyzeManager detectors on its edges.
+*/
+class PinSurveyManager {
+public:
+    struct Row {
+        uint8_t pin = 0;
+        PinAnalyzeManager::Report report;
+    };
+
+    PinSurveyManager(PinService& pinService, EdgeCaptureService& edgeCaptureService);
+
+    bool begin(const std::vector<uint8_t>& pins);
+    void end();
+
+    // Dispatch the timestamped edges to their pin
+    void sample();
+
+    bool shouldReport(unsigned long nowMs) const;
+
+    // Reports of every pin, most confident active signals first
+    std::vector<Row> buildReports();
+    std::string formatSurveyTable(const std::vector<Row>& rows) const;
+    void resetWindow();
+
+    uint32_t getDroppedEdges() const;
+
+private:
+    PinService& pinService;
+    EdgeCaptureService& edgeCaptureService;
+
+    std::vector<uint8_t> pins;
+    std::vector<std::unique_ptr<PinAnalyzeManager>> analyzers;
+    CycleTimeline timeline;
+    uint32_t droppedAtStart = 0;
+
+    void drainEdges();
+    uint32_t nowUs();
+};
@@ -10,7 +10,7 @@ std::string SubGhzAnalyzeManager::analyzeFrame(const std::vector<rmt_item32_t>&
     std::vector<uint32_t> highs, lows;
     collectDurations(items, tickPerUs, highs, lows);
 
-    float T = estimateBaseT(highs, lows);
+    float T = estimateBaseT();
     r.baseT_us = T;
 
     float ratio = 0.f;
@@ -197,6 +197,9 @@ void SubGhzAnalyzeManager::collectDurations(const std::vector<rmt_item32_t>& ite
     highs.clear(); lows.clear();
     highs.reserve(items.size());
     lows.reserve(items.size());
+    highStats.reset();
+    lowStats.reset();
+    shortStats.reset();
 
     for (const auto& it : items) {
         // Convert RMT ticks
@@ -204,28 +207,18 @@ void SubGhzAnalyzeManager::collectDurations(const std::vector<rmt_item32_t>& ite
         uint32_t d1 = (uint32_t)std::max(1.f, std::round(it.duration1 / tickPerUs));
         highs.push_back(d0);
         lows.push_back(d1);
-    }
-}
 
-float SubGhzAnalyzeManager::median(std::vector<uint32_t> v) {
-    if (v.empty()) return 0.f;
-    std::sort(v.begin(), v.end());
-    size_t n = v.size();
-    return (n & 1) ? (float)v[n/2] : 0.5f * (v[n/2 - 1] + v[n/2]);
+        highStats.add(d0);
+        lowStats.add(d1);
+        if (d0 >= 2) shortStats.add(d0);
+        if (d1 >= 2) shortStats.add(d1);
+    }
 }
 
-float SubGhzAnalyzeManager::estimateBaseT(const std::vector<uint32_t>& highs, const std::vector<uint32_t>& lows) {
+float SubGhzAnalyzeManager::estimateBaseT() {
     // Take short durations as approximation
-    std::vector<uint32_t> pool;
-    pool.reserve(highs.size() + lows.size());
-    for (auto d : highs) if (d >= 2) pool.push_back(d);
-    for (auto d : lows)  if (d >= 2) pool.push_back(d);
-    if (pool.size() < 8) return 0.f;
-
-    std::sort(pool.begin(), pool.end());
-    size_t m = std::max<size_t>(4, pool.size()/4);
-    std::vector<uint32_t> q(pool.begin(), pool.begin() + m);
-    return median(q);
+    if (shortStats.getCount() < 8) return 0.f;
+    return shortStats.shortMedian(4);
 }
 
 bool SubGhzAnalyzeManager::looksManchester(float T, const std::vector<uint32_t>& highs, const std::vector<uint32_t>& lows) {
@@ -264,13 +257,8 @@ bool SubGhzAnalyzeManager::looksPulseLength(float T, const std::vector<uint32_t>
 bool SubGhzAnalyzeManager::looksPWM(float T, const std::vector<uint32_t>& highs, const std::vector<uint32_t>& lows) {
     if (T <= 0.f || highs.size() < 8) return false;
 
-    auto medH = median(highs);
-    auto medL = median(lows);
-    float varH = 0.f, varL = 0.f;
-    for (auto d : highs) varH += std::fabs((float)d - medH);
-    for (auto d : lows)  varL += std::fabs((float)d - medL);
-    varH /= std::max<size_t>(1, highs.size());
-    varL /= std::max<size_t>(1, lows.size());
+    float varH = highStats.meanDeviation(highStats.median());
+    float varL = lowStats.meanDeviation(lowStats.median());
 
     return (varH < 0.25f * varL) || (varL < 0.25f * varH);
 }
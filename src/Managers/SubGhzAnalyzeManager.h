@@ -9,6 +9,7 @@
 #include "Interfaces/ITerminalView.h"
 #include "Interfaces/IInput.h"
 #include "driver/rmt.h"
+#include "Models/StreamingStats.h"
 
 enum class RfEncoding { Unknown, PulseLength, Manchester, PWM };
 
@@ -75,8 +76,7 @@ private:
 
     void   collectDurations(const std::vector<rmt_item32_t>& items, float tickPerUs,
                                    std::vector<uint32_t>& highs, std::vector<uint32_t>& lows);
-    float  median(std::vector<uint32_t> v);
-    float  estimateBaseT(const std::vector<uint32_t>& highs, const std::vector<uint32_t>& lows);
+    float  estimateBaseT();
 
     // Protocols prediction
     bool   looksManchester(float T, const std::vector<uint32_t>& highs, const std::vector<uint32_t>& lows);
@@ -92,4 +92,9 @@ private:
     std::string bitsToHex(const std::string& bits);
     float       clamp01(float v);
     bool        nearf(float a, float b, float tol);
+
+    // Duration stats of the frame being analyzed, filled with the durations
+    StreamingStats highStats;
+    StreamingStats lowStats;
+    StreamingStats shortStats; // highs and lows of 2 us and more
 };
@@ -0,0 +1,219 @@
+#include "UartScanManager.h"
+#include <algorithm>
+#include <cmath>
+
+UartScanManager::UartScanManager(PinService& pinService, EdgeCaptureService& edgeCaptureService)
+: pinService(pinService), edgeCaptureService(edgeCaptureService) {}
+
+std::vector<UartScanManager::LineReport> UartScanManager::scan(const std::vector<uint8_t>& pins, uint32_t windowMs, bool pullup) {
+    std::vector<LineReport> out;
+    if (pins.empty() || pins.size() > MAX_PINS) return out;
+
+    // Cycle deltas stay below half a counter wrap (about 8.9 s at 240 MHz)
+    // so the signed checks on them hold
+    windowMs = std::min<uint32_t>(std::max<uint32_t>(windowMs, 1), 8000);
+    cyclesPerSec = getCpuFrequencyMhz() * 1000000UL;
+
+    std::vector<LineTrack> tracks(pins.size());
+    if (!edgeCaptureService.begin(pins)) return out;
+
+    // After begin, it leaves the pins floating
+    for (auto pin : pins) {
+        if (pullup) pinService.setInputPullup(pin);
+        else        pinService.setInput(pin);
+    }
+    delayMicroseconds(100);
+
+    // Edges of the pull settling are not part of the window
+    EdgeCaptureService::Edge batch[64];
+    while (edgeCaptureService.read(batch, 64) > 0) {}
+    uint32_t droppedAtStart = edgeCaptureService.getDropped();
+
+    uint32_t startCycles = ESP.getCycleCount();
+    for (size_t i = 0; i < pins.size(); ++i) {
+        tracks[i].level = pinService.read(pins[i]);
+        tracks[i].lastCycles = startCycles;
+    }
+
+    size_t n;
+    unsigned long startMs = millis();
+    while (millis() - startMs < windowMs) {
+        n = edgeCaptureService.read(batch, 64);
+        for (size_t i = 0; i < n; ++i) {
+            if (batch[i].channel < tracks.size()) onEdge(tracks[batch[i].channel], batch[i]);
+        }
+    }
+
+    // Edges stamped before the end may still be in the ring
+    uint32_t endCycles = ESP.getCycleCount();
+    edgeCaptureService.end();
+    while ((n = edgeCaptureService.read(batch, 64)) > 0) {
+        for (size_t i = 0; i < n; ++i) {
+            if (batch[i].channel >= tracks.size()) continue;
+            if ((int32_t)(batch[i].cycles - endCycles) > 0) continue;
+            onEdge(tracks[batch[i].channel], batch[i]);
+        }
+    }
+    bool lostEdges = edgeCaptureService.getDropped() != droppedAtStart;
+
+    out.reserve(pins.size());
+    for (size_t i = 0; i < pins.size(); ++i) {
+        // Time in the last level
+        LineTrack& track = tracks[i];
+        uint32_t tail = endCycles - track.lastCycles;
+        if ((int32_t)tail > 0) {
+            if (track.level) track.highCycles += tail;
+            else             track.lowCycles += tail;
+        }
+        out.push_back(buildReport(pins[i], track, windowMs, lostEdges));
+    }
+
+    std::sort(out.begin(), out.end(), [](const LineReport& a, const LineReport& b) {
+        if ((a.state == LineState::Tx) != (b.state == LineState::Tx)) return a.state == LineState::Tx;
+        if (a.confidencePct != b.confidencePct) return a.confidencePct > b.confidencePct;
+        return a.edges > b.edges;
+    });
+
+    return out;
+}
+
+uint32_t UartScanManager::detectBaud(uint8_t pin, uint32_t windowMs, int minConfidencePct, bool pullup) {
+    auto reports = scan(std::vector<uint8_t>{ pin }, windowMs, pullup);
+    if (reports.empty()) return 0;
+
+    const auto& r = reports[0];
+    if (r.state != LineState::Tx || r.confidencePct < minConfidencePct) return 0;
+    return r.baud;
+}
+
+/*
+Edges
+*/
+void UartScanManager::onEdge(LineTrack& track, const EdgeCaptureService::Edge& edge) {
+    uint32_t width = edge.cycles - track.lastCycles;
+    if ((int32_t)width < 0) width = 0; // stamped before the window started
+
+    if (track.level) track.highCycles += width;
+    else             track.lowCycles += width;
+
+    // Same level twice, the opposite edge was missed and the width is unknown
+    if (edge.level == track.level) {
+        track.edges += 2;
+        track.primed = true;
+        track.lastCycles = edge.cycles;
+        return;
+    }
+
+    if (track.primed) addPulse(track, width);
+
+    track.primed = true;
+    track.level = edge.level;
+    track.lastCycles = edge.cycles;
+    track.edges++;
+}
+
+void UartScanManager::addPulse(LineTrack& track, uint32_t widthCycles) {
+    if (widthCycles == 0) return;
+
+    // Too short for the fastest rate or a gap between frames
+    float rate = (float)cyclesPerSec / (float)widthCycles;
+    if (rate > BAUD_RATES[BAUD_COUNT - 1] * 1.25f || rate < BAUD_RATES[0] * 0.8f) return;
+
+    uint16_t& votes = track.rateVotes[nearestBaudIndex(rate)];
+    if (votes < UINT16_MAX) votes++;
+    track.pulses++;
+
+    track.widths[track.widthHead] = widthCycles;
+    track.widthHead = (track.widthHead + 1) % WIDTH_RING;
+    if (track.widthCount < WIDTH_RING) track.widthCount++;
+}
+
+/*
+Report
+*/
+UartScanManager::LineReport UartScanManager::buildReport(uint8_t pin, const LineTrack& track, uint32_t windowMs, bool lostEdges) const {
+    LineReport r;
+    r.pin = pin;
+    r.edges = track.edges;
+    r.edgesPerSec = track.edges * 1000.0f / (float)windowMs;
+    r.state = track.highCycles >= track.lowCycles ? LineState::IdleHigh : LineState::IdleLow;
+    if (track.edges == 0) return r;
+
+    r.state = LineState::Active;
+    uint32_t bitCycles = estimateBitCycles(track);
+    if (bitCycles == 0) return r;
+
+    int conf = bitFitPct(track, bitCycles);
+    if (track.widthCount < 16) conf = conf * track.widthCount / 16;
+    if (lostEdges) conf /= 2;
+
+    r.baud = BAUD_RATES[nearestBaudIndex((float)cyclesPerSec / (float)bitCycles)];
+    r.confidencePct = conf;
+    if (conf >= 50) r.state = LineState::Tx;
+    return r;
+}
+
+uint32_t UartScanManager::estimateBitCycles(const LineTrack& track) const {
+    if (track.pulses < 3) return 0;
+
+    // Shortest rate with enough votes, a stray glitch does not make the bit time
+    uint32_t minVotes = std::max<uint32_t>(3, track.pulses / 16);
+    int best = -1;
+    for (int i = BAUD_COUNT - 1; i >= 0; --i) {
+        if (track.rateVotes[i] >= minVotes) {
+            best = i;
+            break;
+        }
+    }
+    if (best < 0) return 0;
+
+    // Interrupt latency spreads one bit over neighbour rates, average the cluster
+    float nominal = (float)cyclesPerSec / (float)BAUD_RATES[best];
+    uint64_t sum = 0;
+    uint32_t count = 0;
+    for (uint8_t i = 0; i < track.widthCount; ++i) {
+        float w = (float)track.widths[i];
+        if (w > nominal * 0.7f && w < nominal * 1.3f) {
+            sum += track.widths[i];
+            count++;
+        }
+    }
+    if (count == 0) return (uint32_t)nominal;
+    return (uint32_t)(sum / count);
+}
+
+int UartScanManager::bitFitPct(const LineTrack& track, uint32_t bitCycles) const {
+    // Every pulse of a frame is a whole number of bits, longer ones are idle gaps
+    uint32_t ok = 0;
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < track.widthCount; ++i) {
+        float bits = (float)track.widths[i] / (float)bitCycles;
+        long n = lroundf(bits);
+        if (n < 1 || n > (long)MAX_BITS_RUN) continue;
+
+        total++;
+        if (fabsf(bits - (float)n) <= 0.25f + 0.03f * n) ok++;
+    }
+    if (total == 0) return 0;
+    return (int)(100 * ok / total);
+}
+
+size_t UartScanManager::nearestBaudIndex(float rate) {
+    const uint32_t* it = std::lower_bound(BAUD_RATES, BAUD_RATES + BAUD_COUNT, rate,
+                                          [](uint32_t baud, float r) { return (float)baud < r; });
+    if (it == BAUD_RATES) return 0;
+    if (it == BAUD_RATES + BAUD_COUNT) return BAUD_COUNT - 1;
+
+    size_t i = it - BAUD_RATES;
+    return (rate / (float)BAUD_RATES[i - 1] < (float)BAUD_RATES[i] / rate) ? i - 1 : i;
+}
+
+const char* UartScanManager::stateToStr(LineState state) {
+    switch (state) {
+        case LineState::Tx: return "TX";
+        case LineState::Active: return "Active";
+        case LineState::IdleHigh: return "Idle high";
+        case LineState::IdleLow: return "Idle low";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "Services/PinService.h"
+#include "Services/EdgeCaptureService.h"
+
+/*
+UART discovery on several pins in one pass.
+Edges of every pin are timestamped together by the edge capture interrupt,
+pulse widths are voted into the standard baud rates, the shortest well
+populated one is the bit time. Pulses are then checked to be whole bits.
+*/
+class UartScanManager {
+public:
+    enum class LineState {
+        Tx,         // UART frames at a standard baud rate
+        Active,     // edges, but no UART timing
+        IdleHigh,
+        IdleLow
+    };
+
+    struct LineReport {
+        uint8_t pin = 0;
+        LineState state = LineState::IdleLow;
+        uint32_t edges = 0;
+        float edgesPerSec = 0.f;
+        uint32_t baud = 0;
+        int confidencePct = 0;
+    };
+
+    static constexpr size_t MAX_PINS = EdgeCaptureService::MAX_CHANNELS;
+
+    UartScanManager(PinService& pinService, EdgeCaptureService& edgeCaptureService);
+
+    // Listen to all pins at once during the window, transmitting lines first
+    std::vector<LineReport> scan(const std::vector<uint8_t>& pins, uint32_t windowMs, bool pullup = true);
+
+    // Standard baud rate seen on the pin, 0 below the confidence
+    uint32_t detectBaud(uint8_t pin, uint32_t windowMs, int minConfidencePct = 60, bool pullup = true);
+
+    static const char* stateToStr(LineState state);
+
+private:
+    static constexpr uint32_t BAUD_RATES[] = {
+        // Legacy
+        110, 300, 600, 1200, 1800, 2000, 2400, 3600, 4800, 7200,
+        9600, 10400, 14400, 16000, 19200,
+
+        // Mid-range
+        28800, 31250, 32000, 33600, 38400,
+        56000, 57600, 64000, 76800,
+
+        // High
+        100000, 115200, 125000, 128000, 153600,
+        200000, 230400, 250000, 256000, 307200,
+
+        // Very high
+        460800, 500000, 576000, 614400, 750000,
+        921600, 1000000, 1152000, 1228800, 1500000,
+
+        // Extreme
+        2000000, 2500000, 3000000, 3500000, 4000000
+    };
+    static constexpr size_t BAUD_COUNT = sizeof(BAUD_RATES) / sizeof(BAUD_RATES[0]);
+    static constexpr size_t WIDTH_RING = 64;
+    static constexpr uint32_t MAX_BITS_RUN = 10; // start + 8 data + stop
+
+    // Per pin, in CPU cycles
+    struct LineTrack {
+        uint32_t lastCycles = 0;
+        uint8_t level = 0;
+        bool primed = false; // an edge was seen, pulses are measured from there
+        uint32_t edges = 0;
+        uint64_t highCycles = 0;
+        uint64_t lowCycles = 0;
+        uint32_t pulses = 0;
+        uint16_t rateVotes[BAUD_COUNT] = {};
+        uint32_t widths[WIDTH_RING];
+        uint8_t widthHead = 0;
+        uint8_t widthCount = 0;
+    };
+
+    PinService& pinService;
+    EdgeCaptureService& edgeCaptureService;
+    uint32_t cyclesPerSec = 240000000;
+
+    void onEdge(LineTrack& track, const EdgeCaptureService::Edge& edge);
+    void addPulse(LineTrack& track, uint32_t widthCycles);
+    LineReport buildReport(uint8_t pin, const LineTrack& track, uint32_t windowMs, bool lostEdges) const;
+    uint32_t estimateBitCycles(const LineTrack& track) const;
+    int bitFitPct(const LineTrack& track, uint32_t bitCycles) const;
+    static size_t nearestBaudIndex(float rate);
+};
@@ -0,0 +1,360 @@
+#include "YmodemManager.h"
+
+YmodemManager::YmodemManager(UartService& uartService,
+                             FileStreamService& fileStreamService,
+                             SdService& sdService,
+                             YmodemTransformer& ymodemTransformer)
+: uartService(uartService),
+  fileStreamService(fileStreamService),
+  sdService(sdService),
+  ymodemTransformer(ymodemTransformer) {}
+
+/*
+Receive
+*/
+YmodemManager::Result YmodemManager::receiveBatch(const std::string& dir, bool streaming, const ProgressFn& progress, const AbortFn& shouldAbort) {
+    Result result;
+    uint8_t request = streaming ? YmodemTransformer::STREAM_REQUEST : YmodemTransformer::CRC_REQUEST;
+    uint8_t frame[YmodemTransformer::MAX_FRAME];
+
+    while (true) {
+        size_t frameSize = 0;
+        if (!readHeader(request, frame, frameSize, shouldAbort)) {
+            cancel();
+            result.error = "No file header from the sender";
+            return result;
+        }
+
+        // Empty header, end of the batch
+        std::string name;
+        uint32_t size = 0;
+        if (!ymodemTransformer.decodeHeader(frame + 3, frameSize - YmodemTransformer::OVERHEAD, name, size)) {
+            sendByte(YmodemTransformer::ACK);
+            result.ok = true;
+            return result;
+        }
+
+        std::string path = (dir.empty() || dir.back() != '/') ? dir + "/" + name : dir + name;
+        if (!receiveFile(path, name, size, streaming, request, frame, result, progress, shouldAbort)) {
+            return result;
+        }
+    }
+}
+
+bool YmodemManager::readHeader(uint8_t request, uint8_t* frame, size_t& frameSize, const AbortFn& shouldAbort) {
+    // The sender starts when it sees the request, it is repeated every second
+    unsigned long start = millis();
+    while (millis() - start < START_TIMEOUT_MS) {
+        if (shouldAbort && shouldAbort()) return false;
+
+        sendByte(request);
+        uint8_t seq = 0;
+        switch (readFrame(frame, frameSize, seq, BYTE_TIMEOUT_MS)) {
+            case FrameStatus::Block:
+                if (seq == 0) return true;
+                break;
+            case FrameStatus::Eot:
+                // Our ACK of the last EOT was lost
+                sendByte(YmodemTransformer::ACK);
+                break;
+            case FrameStatus::Cancel:
+                return false;
+            case FrameStatus::Corrupt:
+                uartService.resetInput();
+                break;
+            default:
+                break;
+        }
+    }
+    return false;
+}
+
+bool YmodemManager::receiveFile(const std::string& path, const std::string& name, uint32_t size, bool streaming, uint8_t request,
+                                uint8_t* frame, Result& result, const ProgressFn& progress, const AbortFn& shouldAbort) {
+    File file = sdService.openFileWrite(path);
+    if (!file || !fileStreamService.beginWrite(file)) {
+        if (file) file.close();
+        cancel();
+        result.error = "Could not create " + path;
+        return false;
+    }
+
+    // Data blocks come after a new request
+    if (!streaming) sendByte(YmodemTransformer::ACK);
+    sendByte(request);
+
+    uint8_t expected = 1;
+    uint32_t received = 0;
+    int errors = 0;
+    bool ok = false;
+    unsigned long lastProgress = millis();
+
+    while (true) {
+        if (shouldAbort && shouldAbort()) {
+            cancel();
+            result.error = "Aborted";
+            break;
+        }
+
+        size_t frameSize = 0;
+        uint8_t seq = 0;
+        FrameStatus status = readFrame(frame, frameSize, seq, BLOCK_TIMEOUT_MS);
+
+        if (status == FrameStatus::Eot) {
+            sendByte(YmodemTransformer::ACK);
+            ok = true;
+            break;
+        }
+        if (status == FrameStatus::Cancel) {
+            result.error = "Cancelled by the sender";
+            break;
+        }
+        if (status != FrameStatus::Block) {
+            // Without ACK there is no retransmission in streaming mode
+            if (streaming || ++errors > MAX_RETRIES) {
+                cancel();
+                result.error = status == FrameStatus::Timeout ? "Timeout" : "Corrupted block";
+                break;
+            }
+            uartService.resetInput();
+            sendByte(YmodemTransformer::NAK);
+            continue;
+        }
+
+        // Our ACK was lost and the previous block came again
+        if (seq == (uint8_t)(expected - 1)) {
+            if (!streaming) sendByte(YmodemTransformer::ACK);
+            if (seq == 0) sendByte(request);
+            continue;
+        }
+        if (seq != expected) {
+            cancel();
+            result.error = "Block out of sequence";
+            break;
+        }
+
+        // Padding of the last block is not part of the file
+        size_t length = frameSize - YmodemTransformer::OVERHEAD;
+        if (size && received + length > size) length = size > received ? size - received : 0;
+
+        if (!fileStreamService.write(frame + 3, length)) {
+            cancel();
+            result.error = "SD write failed";
+            break;
+        }
+        if (!streaming) sendByte(YmodemTransformer::ACK);
+
+        received += length;
+        expected++;
+        errors = 0;
+
+        if (progress && millis() - lastProgress >= PROGRESS_INTERVAL_MS) {
+            progress(name, received, size);
+            lastProgress = millis();
+        }
+    }
+
+    bool flushed = fileStreamService.flush();
+    fileStreamService.end();
+    file.close();
+
+    if (ok && !flushed) {
+        result.error = "SD write failed";
+        ok = false;
+    }
+    if (!ok) {
+        sdService.deleteFile(path);
+        return false;
+    }
+
+    if (progress) progress(name, received, size);
+    result.files++;
+    result.bytes += received;
+    return true;
+}
+
+YmodemManager::FrameStatus YmodemManager::readFrame(uint8_t* frame, size_t& frameSize, uint8_t& seq, uint32_t timeoutMs) {
+    int start = readByte(timeoutMs);
+    if (start < 0) return FrameStatus::Timeout;
+    if (start == YmodemTransformer::EOT) return FrameStatus::Eot;
+    if (start == YmodemTransformer::CAN) {
+        return readByte(BYTE_TIMEOUT_MS) == YmodemTransformer::CAN ? FrameStatus::Cancel : FrameStatus::Corrupt;
+    }
+
+    size_t blockSize = YmodemTransformer::blockSizeOf(start);
+    if (blockSize == 0) return FrameStatus::Corrupt;
+
+    // The rest of the frame in one read from the driver buffer
+    frame[0] = start;
+    size_t rest = blockSize + YmodemTransformer::OVERHEAD - 1;
+    if (uartService.readTimeout(frame + 1, rest, BLOCK_TIMEOUT_MS) != rest) return FrameStatus::Corrupt;
+
+    frameSize = blockSize + YmodemTransformer::OVERHEAD;
+    return ymodemTransformer.checkFrame(frame, frameSize, seq) ? FrameStatus::Block : FrameStatus::Corrupt;
+}
+
+/*
+Send
+*/
+YmodemManager::Result YmodemManager::sendBatch(const std::vector<std::string>& paths, const ProgressFn& progress, const AbortFn& shouldAbort) {
+    Result result;
+
+    int request = waitRequest(START_TIMEOUT_MS, shouldAbort);
+    if (request < 0) {
+        result.error = "No request from the receiver";
+        return result;
+    }
+    bool streaming = request == YmodemTransformer::STREAM_REQUEST;
+
+    for (size_t i = 0; i < paths.size(); ++i) {
+        // The receiver asks again for each header
+        if (i > 0 && waitRequest(BLOCK_TIMEOUT_MS, shouldAbort) < 0) {
+            cancel();
+            result.error = "No request for the next file";
+            return result;
+        }
+        if (!sendFile(paths[i], streaming, result, progress, shouldAbort)) return result;
+    }
+
+    // Empty header ends the batch
+    uint8_t frame[YmodemTransformer::SMALL_BLOCK + YmodemTransformer::OVERHEAD];
+    if (waitRequest(BLOCK_TIMEOUT_MS, shouldAbort) < 0 ||
+        !sendFrame(frame, ymodemTransformer.encodeHeader("", 0, frame), streaming)) {
+        result.error = "End of batch not acknowledged";
+        return result;
+    }
+
+    result.ok = true;
+    return result;
+}
+
+bool YmodemManager::sendFile(const std::string& path, bool streaming, Result& result, const ProgressFn& progress, const AbortFn& shouldAbort) {
+    File file = sdService.openFileRead(path);
+    if (!file || !fileStreamService.beginRead(file)) {
+        if (file) file.close();
+        cancel();
+        result.error = "Could not open " + path;
+        return false;
+    }
+
+    uint32_t size = file.size();
+    std::string name = sdService.getFileName(path);
+    uint8_t frame[YmodemTransformer::MAX_FRAME];
+    uint8_t data[YmodemTransformer::LARGE_BLOCK];
+
+    // Header is acknowledged, then data is requested
+    bool ok = sendFrame(frame, ymodemTransformer.encodeHeader(name, size, frame), streaming) &&
+              waitRequest(BLOCK_TIMEOUT_MS, shouldAbort) >= 0;
+    if (!ok) result.error = "Header refused by the receiver";
+
+    uint8_t seq = 1;
+    uint32_t sent = 0;
+    unsigned long lastProgress = millis();
+
+    while (ok) {
+        if (shouldAbort && shouldAbort()) {
+            cancel();
+            result.error = "Aborted";
+            ok = false;
+            break;
+        }
+
+        // Next block is already in memory while this one is on the line
+        size_t length = fileStreamService.read(data, sizeof(data));
+        if (length == 0) break;
+
+        size_t frameSize = ymodemTransformer.encodeBlock(seq, data, length, frame);
+        if (!sendFrame(frame, frameSize, streaming)) {
+            result.error = "Block not acknowledged";
+            ok = false;
+            break;
+        }
+
+        sent += length;
+        seq++;
+
+        if (progress && millis() - lastProgress >= PROGRESS_INTERVAL_MS) {
+            progress(name, sent, size);
+            lastProgress = millis();
+        }
+    }
+
+    if (ok && fileStreamService.hasFailed()) {
+        cancel();
+        result.error = "SD read failed";
+        ok = false;
+    }
+    fileStreamService.end();
+    file.close();
+
+    if (ok && !sendEot()) {
+        result.error = "EOT not acknowledged";
+        ok = false;
+    }
+    if (!ok) return false;
+
+    if (progress) progress(name, sent, size);
+    result.files++;
+    result.bytes += sent;
+    return true;
+}
+
+int YmodemManager::waitRequest(uint32_t timeoutMs, const AbortFn& shouldAbort) {
+    unsigned long start = millis();
+    while (millis() - start < timeoutMs) {
+        if (shouldAbort && shouldAbort()) return -1;
+
+        int c = readByte(BYTE_TIMEOUT_MS);
+        if (c == YmodemTransformer::CRC_REQUEST || c == YmodemTransformer::STREAM_REQUEST) return c;
+        if (c == YmodemTransformer::CAN) return -1;
+    }
+    return -1;
+}
+
+bool YmodemManager::sendFrame(const uint8_t* frame, size_t frameSize, bool streaming) {
+    for (int attempt = 0; attempt <= MAX_RETRIES; ++attempt) {
+        uartService.writeBuffered(frame, frameSize);
+
+        // Streaming, only a cancel can come back
+        if (streaming) {
+            uint8_t c = 0;
+            return !(uartService.readBuffered(&c, 1) == 1 && c == YmodemTransformer::CAN);
+        }
+
+        int reply = readByte(BLOCK_TIMEOUT_MS);
+        while (reply == YmodemTransformer::CRC_REQUEST) reply = readByte(BLOCK_TIMEOUT_MS);
+        if (reply == YmodemTransformer::ACK) return true;
+        if (reply == YmodemTransformer::CAN) return false;
+
+        // NAK, timeout or noise, the frame goes again
+    }
+    return false;
+}
+
+bool YmodemManager::sendEot() {
+    // Some receivers NAK the first EOT
+    for (int attempt = 0; attempt <= MAX_RETRIES; ++attempt) {
+        sendByte(YmodemTransformer::EOT);
+        int reply = readByte(BLOCK_TIMEOUT_MS);
+        if (reply == YmodemTransformer::ACK) return true;
+        if (reply == YmodemTransformer::CAN) return false;
+    }
+    return false;
+}
+
+/*
+Bytes
+*/
+int YmodemManager::readByte(uint32_t timeoutMs) {
+    uint8_t byte = 0;
+    return uartService.readTimeout(&byte, 1, timeoutMs) == 1 ? byte : -1;
+}
+
+void YmodemManager::sendByte(uint8_t byte) {
+    uartService.writeBuffered(&byte, 1);
+}
+
+void YmodemManager::cancel() {
+    const uint8_t can[2] = { YmodemTransformer::CAN, YmodemTransformer::CAN };
+    uartService.writeBuffered(can, sizeof(can));
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include "Services/UartService.h"
+#include "Services/SdService.h"
+#include "Services/FileStreamService.h"
+#include "Transformers/YmodemTransformer.h"
+
+/*
+YMODEM batch transfers between the UART driver and the SD card.
+Blocks are 1K, the SD side runs on the file stream worker so the card
+is read or written while the next block is on the line. In streaming
+mode (YMODEM-g) blocks are not acknowledged, an error cancels the batch.
+The UART driver must be running.
+*/
+class YmodemManager {
+public:
+    struct Result {
+        bool ok = false;
+        uint32_t files = 0;
+        uint32_t bytes = 0;
+        std::string error;
+    };
+
+    // File name, bytes done, file size (0 if the sender did not tell)
+    using ProgressFn = std::function<void(const std::string&, uint32_t, uint32_t)>;
+    using AbortFn = std::function<bool()>;
+
+    YmodemManager(UartService& uartService,
+                  FileStreamService& fileStreamService,
+                  SdService& sdService,
+                  YmodemTransformer& ymodemTransformer);
+
+    // Save every file of the batch into `dir`
+    Result receiveBatch(const std::string& dir, bool streaming, const ProgressFn& progress, const AbortFn& shouldAbort);
+
+    // Send the files in one batch, the receiver picks the streaming mode
+    Result sendBatch(const std::vector<std::string>& paths, const ProgressFn& progress, const AbortFn& shouldAbort);
+
+private:
+    static constexpr uint32_t START_TIMEOUT_MS = 60000;
+    static constexpr uint32_t BLOCK_TIMEOUT_MS = 10000;
+    static constexpr uint32_t BYTE_TIMEOUT_MS = 1000;
+    static constexpr uint32_t PROGRESS_INTERVAL_MS = 500;
+    static constexpr int MAX_RETRIES = 10;
+
+    enum class FrameStatus { Block, Eot, Cancel, Timeout, Corrupt };
+
+    FrameStatus readFrame(uint8_t* frame, size_t& frameSize, uint8_t& seq, uint32_t timeoutMs);
+    bool readHeader(uint8_t request, uint8_t* frame, size_t& frameSize, const AbortFn& shouldAbort);
+    bool receiveFile(const std::string& path, const std::string& name, uint32_t size, bool streaming, uint8_t request,
+                     uint8_t* frame, Result& result, const ProgressFn& progress, const AbortFn& shouldAbort);
+
+    int waitRequest(uint32_t timeoutMs, const AbortFn& shouldAbort);
+    bool sendFrame(const uint8_t* frame, size_t frameSize, bool streaming);
+    bool sendFile(const std::string& path, bool streaming, Result& result, const ProgressFn& progress, const AbortFn& shouldAbort);
+    bool sendEot();
+
+    int readByte(uint32_t timeoutMs);
+    void sendByte(uint8_t byte);
+    void cancel();
+
+    UartService& uartService;
+    FileStreamService& fileStreamService;
+    SdService& sdService;
+    YmodemTransformer& ymodemTransformer;
+};
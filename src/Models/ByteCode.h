@@ -6,10 +6,10 @@
 class ByteCode {
 public:
     ByteCode(ByteCodeEnum command = ByteCodeEnum::None, uint32_t data = 0)
-        : command(command), data(data), bits(8), repeat(1), hasBits(false), hasRepeat(false) {}
+        : repeat(1), data(data), command(command), bits(8), hasBits(false), hasRepeat(false) {}
 
     ByteCode(ByteCodeEnum command, uint32_t data, uint8_t bits, uint32_t repeat)
-        : command(command), data(data), bits(bits), repeat(repeat), hasBits(true), hasRepeat(true) {}
+        : repeat(repeat), data(data), command(command), bits(bits), hasBits(true), hasRepeat(true) {}
 
 
     ByteCodeEnum getCommand() const { return command; }
@@ -31,10 +31,13 @@ public:
     void setHasRepeat(bool flag) { hasRepeat = flag; }
 
 private:
-    ByteCodeEnum command;
-    uint32_t data;
-    uint8_t bits;
+    // Packed to 8 bytes, programs are stored as contiguous arrays of ByteCode
     uint32_t repeat;
-    bool hasBits;
-    bool hasRepeat;
+    uint16_t data;
+    ByteCodeEnum command;
+    uint8_t bits : 6;
+    uint8_t hasBits : 1;
+    uint8_t hasRepeat : 1;
 };
+
+static_assert(sizeof(ByteCode) == 8, "ByteCode must stay packed");
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "Enums/CaptureTriggerEnum.h"
+#include <cstdint>
+
+/*
+Trigger condition fed with every captured sample.
+Logic samples carry one channel per bit, the mask selects channels.
+Analog samples are raw ADC values, the value is the threshold.
+Pulse widths are counted in samples.
+*/
+class CaptureTrigger {
+public:
+    CaptureTrigger(CaptureTriggerEnum type = CaptureTriggerEnum::None,
+                   uint16_t mask = 0, uint16_t value = 0,
+                   uint32_t minWidth = 1, uint32_t maxWidth = UINT32_MAX)
+        : type(type), mask(mask), value(value), minWidth(minWidth), maxWidth(maxWidth) {}
+
+    CaptureTriggerEnum getType() const { return type; }
+    uint16_t getMask() const { return mask; }
+    uint16_t getValue() const { return value; }
+    uint32_t getMinWidth() const { return minWidth; }
+    uint32_t getMaxWidth() const { return maxWidth; }
+
+    // Forget the previous sample, call before each arm
+    void reset() {
+        primed = false;
+        run = 0;
+    }
+
+    // True on the sample where the condition is met
+    bool feed(uint16_t sample) {
+        bool matched = false;
+
+        switch (type) {
+            case CaptureTriggerEnum::None:
+                matched = true;
+                break;
+            case CaptureTriggerEnum::Rising:
+                matched = primed && !(previous & mask) && (sample & mask);
+                break;
+            case CaptureTriggerEnum::Falling:
+                matched = primed && (previous & mask) && !(sample & mask);
+                break;
+            case CaptureTriggerEnum::AnyEdge:
+                matched = primed && ((previous ^ sample) & mask);
+                break;
+            case CaptureTriggerEnum::Level:
+            case CaptureTriggerEnum::Pattern:
+                matched = (sample & mask) == value;
+                break;
+            case CaptureTriggerEnum::PulseWidth:
+                // Fires when the pulse ends, its width is known only then
+                if ((sample & mask) == value) {
+                    if (run < UINT32_MAX) run++;
+                } else {
+                    matched = run >= minWidth && run <= maxWidth;
+                    run = 0;
+                }
+                break;
+            case CaptureTriggerEnum::AnalogRising:
+                matched = primed && previous < value && sample >= value;
+                break;
+            case CaptureTriggerEnum::AnalogFalling:
+                matched = primed && previous > value && sample <= value;
+                break;
+        }
+
+        previous = sample;
+        primed = true;
+        return matched;
+    }
+
+private:
+    CaptureTriggerEnum type;
+    uint16_t mask;
+    uint16_t value;
+    uint32_t minWidth;
+    uint32_t maxWidth;
+
+    bool primed = false;
+    uint16_t previous = 0;
+    uint32_t run = 0;
+};
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+/*
+Microsecond timeline built from CPU cycle stamps.
+Advancing it at least once per counter wrap (~17 s at 240 MHz)
+keeps timestamps exact over any duration, the remainder is carried.
+*/
+class CycleTimeline {
+public:
+    void start(uint32_t cycles, uint32_t us, uint32_t cyclesPerUs) {
+        lastCycles = cycles;
+        nowUs = us;
+        perUs = cyclesPerUs ? cyclesPerUs : 1;
+        remainder = 0;
+    }
+
+    // Stamps must come in order
+    uint32_t advance(uint32_t cycles) {
+        uint32_t elapsed = cycles - lastCycles + remainder;
+        nowUs += elapsed / perUs;
+        remainder = elapsed % perUs;
+        lastCycles = cycles;
+        return nowUs;
+    }
+
+    uint32_t getNowUs() const { return nowUs; }
+
+private:
+    uint32_t lastCycles = 0;
+    uint32_t nowUs = 0;
+    uint32_t perUs = 240;
+    uint32_t remainder = 0;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/*
+One I2C transaction, START to STOP, as rebuilt from sniffer records.
+A repeated START opens a new segment with its own address and direction.
+Only the first MAX_BYTES data bytes are kept, all of them are counted.
+*/
+struct I2cTransaction {
+    static constexpr size_t MAX_SEGMENTS = 4;
+    static constexpr size_t MAX_BYTES = 32;
+
+    struct Segment {
+        uint8_t address = 0;
+        bool read = false;
+        bool addressNack = false;
+        uint16_t byteCount = 0;  // data bytes of this segment
+        uint8_t firstByte = 0;   // index in data
+        uint8_t keptBytes = 0;   // bytes of this segment in data
+    };
+
+    uint32_t startUs = 0;
+    uint32_t endUs = 0;
+    Segment segments[MAX_SEGMENTS];
+    uint8_t segmentCount = 0;
+    uint8_t data[MAX_BYTES];
+    uint8_t dataCount = 0;
+    bool lastNack = false;   // last data byte was not acknowledged
+    bool stopped = false;    // ended by a STOP
+    bool lost = false;       // records are missing in or before it
+
+    void clear() {
+        startUs = endUs = 0;
+        segmentCount = 0;
+        dataCount = 0;
+        lastNack = stopped = lost = false;
+    }
+
+    bool hasAddress(uint8_t address) const {
+        for (uint8_t i = 0; i < segmentCount; ++i) {
+            if (segments[i].address == address) return true;
+        }
+        return false;
+    }
+};
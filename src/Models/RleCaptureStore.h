@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+
+/*
+Logic capture kept as transitions instead of samples.
+Each run is the sample index where it starts and the channels value,
+so idle lines cost nothing and any time is found by binary search.
+Memory is provided by the owner (PSRAM ring), 5 bytes per run.
+*/
+class RleCaptureStore {
+public:
+    void attach(uint8_t* memory, size_t bytes) {
+        capacity = bytes / (sizeof(uint32_t) + sizeof(uint8_t));
+        starts = reinterpret_cast<uint32_t*>(memory);
+        values = memory + capacity * sizeof(uint32_t);
+        clear();
+    }
+
+    void clear() {
+        runs = 0;
+        samples = 0;
+    }
+
+    // Samples come in order, only changes are stored. False once full.
+    inline bool push(uint32_t index, uint8_t value) {
+        if (runs && values[runs - 1] == value) return true;
+        if (runs == capacity) return false;
+        starts[runs] = index;
+        values[runs] = value;
+        runs++;
+        return true;
+    }
+
+    // Number of samples covered, the last run ends there
+    void close(uint32_t total) { samples = total; }
+
+    // Run holding the sample, O(log n)
+    size_t runAt(uint32_t index) const {
+        if (runs == 0) return 0;
+        const uint32_t* it = std::upper_bound(starts, starts + runs, index);
+        return it == starts ? 0 : (it - starts) - 1;
+    }
+
+    uint8_t valueAt(uint32_t index) const {
+        return runs ? values[runAt(index)] : 0;
+    }
+
+    uint32_t getRunStart(size_t run) const { return starts[run]; }
+    uint32_t getRunLength(size_t run) const { return (run + 1 < runs ? starts[run + 1] : samples) - starts[run]; }
+    uint8_t getRunValue(size_t run) const { return values[run]; }
+    size_t getRunCount() const { return runs; }
+    size_t getCapacity() const { return capacity; }
+    uint32_t getSampleCount() const { return samples; }
+    bool isFull() const { return runs == capacity; }
+
+    // One value per column, a column with an edge inside is drawn as a toggle.
+    // Cost is one seek per column plus the transitions on screen.
+    void decimate(uint8_t channel, uint32_t start, uint32_t length, size_t width, std::vector<uint8_t>& out) const {
+        out.clear();
+        if (width == 0 || runs == 0 || start >= samples) return;
+
+        length = std::min(length, samples - start);
+        uint32_t perColumn = std::max<uint32_t>(1, length / width);
+        size_t columns = std::min<size_t>(width, length / perColumn);
+        out.reserve(columns);
+
+        uint8_t previous = (valueAt(start) >> channel) & 1;
+        for (size_t col = 0; col < columns; ++col) {
+            uint32_t from = start + col * perColumn;
+            uint32_t to = from + perColumn;
+            size_t run = runAt(from);
+            uint8_t first = (values[run] >> channel) & 1;
+            uint8_t last = first;
+            bool edge = first != previous;
+
+            for (++run; run < runs && starts[run] < to; ++run) {
+                last = (values[run] >> channel) & 1;
+                if (last != first) edge = true;
+            }
+
+            // Keep short pulses visible when several samples share a pixel
+            uint8_t value = (edge && last == previous) ? !previous : last;
+            out.push_back(value);
+            previous = value;
+        }
+    }
+
+private:
+    uint32_t* starts = nullptr;
+    uint8_t* values = nullptr;
+    size_t capacity = 0;
+    size_t runs = 0;
+    uint32_t samples = 0;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <algorithm>
+
+/*
+Fixed capacity single producer / single consumer ring buffer.
+One task pushes, one task pops, no lock is taken on either side.
+Capacity must be a power of two.
+*/
+template <typename T, size_t Capacity>
+class SpscRingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRingBuffer capacity must be a power of two");
+
+public:
+    // Producer side, returns how many items were stored
+    size_t push(const T* items, size_t count) {
+        const size_t head = headIndex.load(std::memory_order_relaxed);
+        const size_t tail = tailIndex.load(std::memory_order_acquire);
+        const size_t n = std::min(count, Capacity - (head - tail));
+
+        for (size_t i = 0; i < n; ++i) {
+            slots[(head + i) & MASK] = items[i];
+        }
+
+        headIndex.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+    bool push(const T& item) {
+        return push(&item, 1) == 1;
+    }
+
+    // Consumer side
+    bool pop(T& item) {
+        const size_t tail = tailIndex.load(std::memory_order_relaxed);
+        if (tail == headIndex.load(std::memory_order_acquire)) return false;
+
+        item = slots[tail & MASK];
+        tailIndex.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t size() const {
+        return headIndex.load(std::memory_order_acquire) - tailIndex.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    T slots[Capacity];
+    std::atomic<size_t> headIndex{0}; // written by the producer
+    std::atomic<size_t> tailIndex{0}; // written by the consumer
+};
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+/*
+Running statistics over unsigned samples (pulse widths, periods).
+Min, max, mean and variance are updated in place (Welford), quantiles
+come from a log-linear histogram: exact below 32, then 16 bins per
+octave, so any quantile is within ~3% of the sorted answer.
+O(1) per sample, no heap, readable at any time while samples keep coming.
+*/
+class StreamingStats {
+public:
+    static constexpr uint8_t SUB_BITS = 4;
+    static constexpr uint32_t SUB = 1u << SUB_BITS;
+    static constexpr size_t BINS = (32 - SUB_BITS + 1) * SUB;
+
+    void reset() {
+        for (size_t i = 0; i < BINS; ++i) bins[i] = 0;
+        count = 0;
+        weight = 0;
+        minValue = UINT32_MAX;
+        maxValue = 0;
+        mean = 0.f;
+        m2 = 0.f;
+    }
+
+    inline void add(uint32_t value) {
+        count++;
+        if (value < minValue) minValue = value;
+        if (value > maxValue) maxValue = value;
+
+        float delta = (float)value - mean;
+        mean += delta / (float)count;
+        m2 += delta * ((float)value - mean);
+
+        // Halving keeps the shape when a bin would overflow
+        uint16_t& bin = bins[binOf(value)];
+        if (bin == UINT16_MAX) halve();
+        bin++;
+        weight++;
+    }
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMin() const { return count ? minValue : 0; }
+    uint32_t getMax() const { return maxValue; }
+    float getMean() const { return mean; }
+    float getVariance() const { return count > 1 ? m2 / (float)(count - 1) : 0.f; }
+    float getStdDev() const { return std::sqrt(getVariance()); }
+
+    // p in 0..1
+    float quantile(float p) const {
+        if (weight == 0) return 0.f;
+        return valueAtRank(rankOf(p));
+    }
+
+    float median() const { return quantile(0.5f); }
+
+    // Median of the shortest quarter, at least `atLeast` samples of it
+    float shortMedian(uint32_t atLeast) const {
+        if (weight == 0) return 0.f;
+        uint32_t shortest = weight / 4 > atLeast ? weight / 4 : atLeast;
+        if (shortest > weight) shortest = weight;
+        return valueAtRank((shortest - 1) / 2);
+    }
+
+    // Sample `target` of the sorted order, interpolated inside its bin
+    float valueAtRank(uint32_t target) const {
+        uint32_t before = 0;
+        for (size_t i = 0; i < BINS; ++i) {
+            if (before + bins[i] > target) {
+                float low = binLow(i);
+                float width = binWidth(i);
+                float value = width <= 1.f
+                    ? low
+                    : low + (width - 1.f) * ((float)(target - before) + 0.5f) / (float)bins[i];
+                return clampToRange(value);
+            }
+            before += bins[i];
+        }
+        return (float)maxValue;
+    }
+
+    // Quantile of |sample - ref|, bins are merged outward from ref
+    float deviationQuantile(float ref, float p) const {
+        if (weight == 0) return 0.f;
+        uint32_t target = rankOf(p);
+
+        int hi = binOf(ref <= 0.f ? 0 : ref >= 4294967295.f ? UINT32_MAX : (uint32_t)ref);
+        int lo = hi - 1;
+        uint32_t seen = 0;
+
+        while (lo >= 0 || hi < (int)BINS) {
+            float dHi = hi < (int)BINS ? std::fabs(binMid(hi) - ref) : INFINITY;
+            float dLo = lo >= 0 ? std::fabs(binMid(lo) - ref) : INFINITY;
+            int i;
+            float d;
+            if (dHi <= dLo) { i = hi++; d = dHi; }
+            else            { i = lo--; d = dLo; }
+
+            seen += bins[i];
+            if (seen > target) return d;
+        }
+        return 0.f;
+    }
+
+    // Mean of |sample - ref|
+    float meanDeviation(float ref) const {
+        if (weight == 0) return 0.f;
+        float sum = 0.f;
+        for (size_t i = 0; i < BINS; ++i) {
+            if (bins[i]) sum += (float)bins[i] * std::fabs(binMid(i) - ref);
+        }
+        return sum / (float)weight;
+    }
+
+    // Share of samples strictly between lo and hi
+    float fractionBetween(float lo, float hi) const {
+        if (weight == 0) return 0.f;
+        uint32_t inside = 0;
+        for (size_t i = 0; i < BINS; ++i) {
+            if (!bins[i]) continue;
+            float mid = binMid(i);
+            if (mid > lo && mid < hi) inside += bins[i];
+        }
+        return (float)inside / (float)weight;
+    }
+
+    // Visit non empty bins as (representative value, weight)
+    template <typename Fn>
+    void forEachBin(Fn fn) const {
+        for (size_t i = 0; i < BINS; ++i) {
+            if (bins[i]) fn(binMid(i), (uint32_t)bins[i]);
+        }
+    }
+
+    static inline size_t binOf(uint32_t value) {
+        if (value < 2 * SUB) return value;
+        uint32_t msb = 31 - __builtin_clz(value);
+        uint32_t shift = msb - SUB_BITS;
+        return (msb - SUB_BITS + 1) * SUB + ((value >> shift) & (SUB - 1));
+    }
+
+    static inline float binLow(size_t index) {
+        if (index < 2 * SUB) return (float)index;
+        uint32_t shift = index / SUB - 1;
+        return (float)((uint64_t)(SUB + index % SUB) << shift);
+    }
+
+    static inline float binWidth(size_t index) {
+        if (index < 2 * SUB) return 1.f;
+        return (float)(1ULL << (index / SUB - 1));
+    }
+
+    static inline float binMid(size_t index) {
+        return binLow(index) + (binWidth(index) - 1.f) * 0.5f;
+    }
+
+private:
+    uint16_t bins[BINS] = {};
+    uint32_t count = 0;   // samples seen
+    uint32_t weight = 0;  // samples in the bins, lower after a halving
+    uint32_t minValue = UINT32_MAX;
+    uint32_t maxValue = 0;
+    float mean = 0.f;
+    float m2 = 0.f;
+
+    uint32_t rankOf(float p) const {
+        if (p <= 0.f) return 0;
+        if (p >= 1.f) return weight - 1;
+        return (uint32_t)(p * (float)(weight - 1) + 0.5f);
+    }
+
+    float clampToRange(float value) const {
+        if (value < (float)minValue) return (float)minValue;
+        if (value > (float)maxValue) return (float)maxValue;
+        return value;
+    }
+
+    void halve() {
+        weight = 0;
+        for (size_t i = 0; i < BINS; ++i) {
+            bins[i] -= bins[i] >> 1;
+            weight += bins[i];
+        }
+    }
+};
@@ -28,6 +28,9 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       wifiService(),
       wifiScannerService(),
       i2sService(),
+      logicAnalyzerService(),
+      analogCaptureService(),
+      edgeCaptureService(),
       sshService(),
       jtagService(),
       canService(),
@@ -39,6 +42,7 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       subGhzService(),
       rfidService(),
       rf24Service(),
+      fileStreamService(),
 
       // Transformers
       commandTransformer(),
@@ -48,13 +52,19 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       jsonTransformer(),
       infraredTransformer(),
       subGhzTransformer(),
+      ymodemTransformer(),
 
       // Managers
       commandHistoryManager(),
       binaryAnalyzeManager(terminalView, terminalInput),
       userInputManager(terminalView, terminalInput, argTransformer),
       subGhzAnalyzeManager(),
-      pinAnalyzeManager(pinService),
+      pinAnalyzeManager(pinService, edgeCaptureService),
+      pinSurveyManager(pinService, edgeCaptureService),
+      uartScanManager(pinService, edgeCaptureService),
+      ymodemManager(uartService, fileStreamService, sdService, ymodemTransformer),
+      i2cRegisterManager(i2cService),
+      macroManager(littleFsService, instructionTransformer),
 
       // Shells
       sdCardShell(sdService, terminalView, terminalInput, argTransformer, userInputManager),
@@ -80,11 +90,11 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       terminalTypeConfigurator(horizontalSelector),
 
       // Controllers
-      uartController(terminalView, terminalInput, deviceInput, uartService, sdService, hdUartService, argTransformer, userInputManager, uartAtShell, helpShell, uartEmulationShell),
-      i2cController(terminalView, terminalInput, i2cService, argTransformer, userInputManager, i2cEepromShell, helpShell),
+      uartController(terminalView, deviceView, terminalInput, deviceInput, uartService, sdService, hdUartService, argTransformer, userInputManager, uartScanManager, ymodemManager, uartAtShell, helpShell, uartEmulationShell),
+      i2cController(terminalView, terminalInput, i2cService, sdService, littleFsService, argTransformer, userInputManager, i2cRegisterManager, i2cEepromShell, helpShell),
       oneWireController(terminalView, terminalInput, oneWireService, argTransformer, userInputManager, ibuttonShell, oneWireEepromShell, helpShell),
       infraredController(terminalView, terminalInput, infraredService, littleFsService, argTransformer, infraredTransformer, userInputManager, universalRemoteShell, helpShell),
-      utilityController(terminalView, deviceView, terminalInput, pinService, userInputManager, pinAnalyzeManager, argTransformer, sysInfoShell, guideShell, helpShell),
+      utilityController(terminalView, deviceView, terminalInput, pinService, logicAnalyzerService, analogCaptureService, sdService, littleFsService, sumpServer, userInputManager, pinAnalyzeManager, pinSurveyManager, argTransformer, sysInfoShell, guideShell, helpShell),
       hdUartController(terminalView, terminalInput, deviceInput, hdUartService, uartService, argTransformer, userInputManager, helpShell),
       spiController(terminalView, terminalInput, spiService, sdService, argTransformer, userInputManager, binaryAnalyzeManager, sdCardShell, spiFlashShell, spiEepromShell, helpShell),
       jtagController(terminalView, terminalInput, jtagService, userInputManager, helpShell),
@@ -99,7 +109,11 @@ DependencyProvider::DependencyProvider(ITerminalView &terminalView, IDeviceView
       subGhzController(terminalView, terminalInput, deviceView, subGhzService, pinService, i2sService, littleFsService, argTransformer, subGhzTransformer, userInputManager, subGhzAnalyzeManager, helpShell),
       rfidController(terminalView, terminalInput, rfidService, userInputManager, argTransformer, helpShell),
       rf24Controller(terminalView, terminalInput, deviceView, rf24Service, pinService, argTransformer, userInputManager, helpShell),
-      ethernetController(terminalView, terminalInput, deviceInput, wifiService, wifiScannerService, ethernetService, sshService, netcatService, nmapService, icmpService, nvsService, httpService, telnetService, argTransformer, jsonTransformer, userInputManager, modbusShell, helpShell)
+      ethernetController(terminalView, terminalInput, deviceInput, wifiService, wifiScannerService, ethernetService, sshService, netcatService, nmapService, icmpService, nvsService, httpService, telnetService, argTransformer, jsonTransformer, userInputManager, modbusShell, helpShell),
+
+      // Servers
+      binaryProtocolServer(Serial, spiService, i2cService, uartService, oneWireService, pinService),
+      sumpServer(Serial, logicAnalyzerService)
 {
 }
 
@@ -126,6 +140,9 @@ PinService &DependencyProvider::getPinService() { return pinService; }
 WifiService &DependencyProvider::getWifiService() { return wifiService; }
 BluetoothService &DependencyProvider::getBluetoothService() { return bluetoothService; }
 I2sService &DependencyProvider::getI2sService() { return i2sService; }
+LogicAnalyzerService &DependencyProvider::getLogicAnalyzerService() { return logicAnalyzerService; }
+AnalogCaptureService &DependencyProvider::getAnalogCaptureService() { return analogCaptureService; }
+EdgeCaptureService &DependencyProvider::getEdgeCaptureService() { return edgeCaptureService; }
 SshService &DependencyProvider::getSshService() { return sshService; }
 NetcatService &DependencyProvider::getNetcatService() { return netcatService; }
 NmapService &DependencyProvider::getNmapService() { return nmapService; }
@@ -139,6 +156,7 @@ SubGhzService &DependencyProvider::getSubGhzService() { return subGhzService; }
 RfidService &DependencyProvider::getRfidService() { return rfidService; }
 Rf24Service &DependencyProvider::getRf24Service() { return rf24Service; }
 LittleFsService &DependencyProvider::getLittleFsService() { return littleFsService; }
+FileStreamService &DependencyProvider::getFileStreamService() { return fileStreamService; }
 
 // Controllers
 UartController &DependencyProvider::getUartController() { return uartController; }
@@ -169,6 +187,7 @@ InstructionTransformer &DependencyProvider::getInstructionTransformer() { return
 ArgTransformer &DependencyProvider::getArgTransformer() { return argTransformer; }
 WebRequestTransformer &DependencyProvider::getWebRequestTransformer() { return webRequestTransformer; }
 JsonTransformer &DependencyProvider::getJsonTransformer() { return jsonTransformer; }
+YmodemTransformer &DependencyProvider::getYmodemTransformer() { return ymodemTransformer; }
 
 // Managers
 CommandHistoryManager &DependencyProvider::getCommandHistoryManager() { return commandHistoryManager; }
@@ -176,6 +195,11 @@ UserInputManager &DependencyProvider::getUserInputManager() { return userInputMa
 BinaryAnalyzeManager &DependencyProvider::getBinaryAnalyzeManager() { return binaryAnalyzeManager; }
 SubGhzAnalyzeManager &DependencyProvider::getSubGhzAnalyzeManager() { return subGhzAnalyzeManager; }
 PinAnalyzeManager &DependencyProvider::getPinAnalyzeManager() { return pinAnalyzeManager; }
+PinSurveyManager &DependencyProvider::getPinSurveyManager() { return pinSurveyManager; }
+UartScanManager &DependencyProvider::getUartScanManager() { return uartScanManager; }
+YmodemManager &DependencyProvider::getYmodemManager() { return ymodemManager; }
+I2cRegisterManager &DependencyProvider::getI2cRegisterManager() { return i2cRegisterManager; }
+MacroManager &DependencyProvider::getMacroManager() { return macroManager; }
 
 // Shells
 SdCardShell &DependencyProvider::getSdCardShell() { return sdCardShell; }
@@ -195,6 +219,10 @@ HorizontalSelector &DependencyProvider::getHorizontalSelector() { return horizon
 // Config
 TerminalTypeConfigurator &DependencyProvider::getTerminalTypeConfigurator() { return terminalTypeConfigurator; }
 
+// Servers
+BinaryProtocolServer &DependencyProvider::getBinaryProtocolServer() { return binaryProtocolServer; }
+SumpServer &DependencyProvider::getSumpServer() { return sumpServer; }
+
 // Disable interfaces
 void DependencyProvider::disableAllProtocols()
 {
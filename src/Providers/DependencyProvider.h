@@ -26,6 +26,9 @@ and injecting shared instances of core components
 #include "Services/WifiService.h"
 #include "Services/WifiOpenScannerService.h"
 #include "Services/I2sService.h"
+#include "Services/LogicAnalyzerService.h"
+#include "Services/AnalogCaptureService.h"
+#include "Services/EdgeCaptureService.h"
 #include "Services/SshService.h"
 #include "Services/JtagService.h"
 #include "Services/CanService.h"
@@ -39,6 +42,7 @@ and injecting shared instances of core components
 #include "Services/RfidService.h"
 #include "Services/Rf24Service.h"
 #include "Services/LittleFsService.h"
+#include "Services/FileStreamService.h"
 #include "Controllers/UartController.h"
 #include "Controllers/I2cController.h"
 #include "Controllers/OneWireController.h"
@@ -66,11 +70,17 @@ and injecting shared instances of core components
 #include "Transformers/JsonTransformer.h"
 #include "Transformers/WebRequestTransformer.h"
 #include "Transformers/SubGhzTransformer.h"
+#include "Transformers/YmodemTransformer.h"
 #include "Managers/CommandHistoryManager.h"
 #include "Managers/BinaryAnalyzeManager.h"
 #include "Managers/UserInputManager.h"
 #include "Managers/PinAnalyzeManager.h"
+#include "Managers/PinSurveyManager.h"
+#include "Managers/UartScanManager.h"
+#include "Managers/YmodemManager.h"
+#include "Managers/I2cRegisterManager.h"
 #include "Managers/SubGhzAnalyzeManager.h"
+#include "Managers/MacroManager.h"
 #include "Shells/SdCardShell.h"
 #include "Shells/UniversalRemoteShell.h"
 #include "Shells/I2cEepromShell.h"
@@ -87,6 +97,8 @@ and injecting shared instances of core components
 #include "Shells/HelpShell.h"
 #include "Shells/UartEmulationShell.h"
 #include "Config/TerminalTypeConfigurator.h"
+#include "Servers/BinaryProtocolServer.h"
+#include "Servers/SumpServer.h"
 
 class DependencyProvider
 {
@@ -122,6 +134,9 @@ public:
     WifiService &getWifiService();
     WifiOpenScannerService &getWifiScannerService();
     I2sService &getI2sService();
+    LogicAnalyzerService &getLogicAnalyzerService();
+    AnalogCaptureService &getAnalogCaptureService();
+    EdgeCaptureService &getEdgeCaptureService();
     SshService &getSshService();
     NetcatService &getNetcatService();
     NmapService &getNmapService();
@@ -137,6 +152,7 @@ public:
     RfidService &getRfidService();
     Rf24Service &getRf24Service();
     LittleFsService &getLittleFsService();
+    FileStreamService &getFileStreamService();
 
     // Controllers
     UartController &getUartController();
@@ -169,6 +185,7 @@ public:
     JsonTransformer &getJsonTransformer();
     InfraredRemoteTransformer &getInfraredTransformer();
     SubGhzTransformer &getSubGhzTransformer();
+    YmodemTransformer &getYmodemTransformer();
 
     // Managers
     CommandHistoryManager &getCommandHistoryManager();
@@ -176,6 +193,11 @@ public:
     BinaryAnalyzeManager &getBinaryAnalyzeManager();
     SubGhzAnalyzeManager &getSubGhzAnalyzeManager();
     PinAnalyzeManager &getPinAnalyzeManager();
+    PinSurveyManager &getPinSurveyManager();
+    UartScanManager &getUartScanManager();
+    YmodemManager &getYmodemManager();
+    I2cRegisterManager &getI2cRegisterManager();
+    MacroManager &getMacroManager();
 
     // Shells
     SdCardShell &getSdCardShell();
@@ -200,6 +222,10 @@ public:
     // Config
     TerminalTypeConfigurator &getTerminalTypeConfigurator();
 
+    // Servers
+    BinaryProtocolServer &getBinaryProtocolServer();
+    SumpServer &getSumpServer();
+
     // Disable
     void disableAllProtocols();
 
@@ -230,6 +256,9 @@ private:
     WifiOpenScannerService wifiScannerService;
     BluetoothService bluetoothService;
     I2sService i2sService;
+    LogicAnalyzerService logicAnalyzerService;
+    AnalogCaptureService analogCaptureService;
+    EdgeCaptureService edgeCaptureService;
     SshService sshService;
     NetcatService netcatService;
     NmapService nmapService;
@@ -244,6 +273,7 @@ private:
     SubGhzService subGhzService;
     RfidService rfidService;
     Rf24Service rf24Service;
+    FileStreamService fileStreamService;
 
     // Controllers
     UartController uartController;
@@ -275,6 +305,7 @@ private:
     JsonTransformer jsonTransformer;
     InfraredRemoteTransformer infraredTransformer;
     SubGhzTransformer subGhzTransformer;
+    YmodemTransformer ymodemTransformer;
 
     // Managers
     CommandHistoryManager commandHistoryManager;
@@ -282,6 +313,11 @@ private:
     BinaryAnalyzeManager binaryAnalyzeManager;
     SubGhzAnalyzeManager subGhzAnalyzeManager;
     PinAnalyzeManager pinAnalyzeManager;
+    PinSurveyManager pinSurveyManager;
+    UartScanManager uartScanManager;
+    YmodemManager ymodemManager;
+    I2cRegisterManager i2cRegisterManager;
+    MacroManager macroManager;
 
     // Shells
     SdCardShell sdCardShell;
@@ -305,4 +341,8 @@ private:
 
     // Config
     TerminalTypeConfigurator terminalTypeConfigurator;
+
+    // Servers
+    BinaryProtocolServer binaryProtocolServer;
+    SumpServer sumpServer;
 };
\ No newline at end of file
@@ -0,0 +1,327 @@
+#include "BinaryProtocolServer.h"
+
+BinaryProtocolServer::BinaryProtocolServer(
+    Stream& link,
+    SpiService& spiService,
+    I2cService& i2cService,
+    UartService& uartService,
+    OneWireService& oneWireService,
+    PinService& pinService
+)
+    : link(link),
+      spiService(spiService),
+      i2cService(i2cService),
+      uartService(uartService),
+      oneWireService(oneWireService),
+      pinService(pinService)
+{}
+
+/*
+Run
+*/
+void BinaryProtocolServer::run() {
+    request.reserve(256);
+    response.reserve(256);
+
+    while (true) {
+        uint8_t header[3];
+        if (!readExact(header, 1, UINT32_MAX)) continue;
+
+        // Never a command byte, the user is back on a terminal
+        if (header[0] == '\r' || header[0] == '\n') {
+            if (spiCsHeld) spiService.endTransaction();
+            spiCsHeld = false;
+            return;
+        }
+        if (!readExact(header + 1, 2, 100)) continue; // resync on partial header
+
+        uint8_t cmd = header[0];
+        uint16_t len = header[1] | (header[2] << 8);
+        if (len > MAX_PAYLOAD) {
+            reply(BadLength);
+            continue;
+        }
+
+        request.resize(len);
+        if (len && !readExact(request.data(), len, 1000)) {
+            reply(BadLength);
+            continue;
+        }
+
+        response.clear();
+        Status status;
+        switch (cmd) {
+            case Ping:
+                response.assign({'B', 'B', 'I', 'O', '1'});
+                status = Ok;
+                break;
+            case Exit:
+                if (spiCsHeld) spiService.endTransaction();
+                spiCsHeld = false;
+                reply(Ok);
+                return;
+            case SpiBegin:        status = handleSpiBegin(); break;
+            case SpiWriteRead:    status = handleSpiWriteRead(); break;
+            case SpiExchange:     status = handleSpiExchange(); break;
+            case SpiCs:           status = handleSpiCs(); break;
+            case I2cBegin:        status = handleI2cBegin(); break;
+            case I2cWriteRead:    status = handleI2cWriteRead(); break;
+            case UartBegin:       status = handleUartBegin(); break;
+            case UartWrite:       status = handleUartWrite(); break;
+            case UartRead:        status = handleUartRead(); break;
+            case OneWireBegin:    status = handleOneWireBegin(); break;
+            case OneWireTransfer: status = handleOneWireTransfer(); break;
+            case GpioMode:        status = handleGpioMode(); break;
+            case GpioWrite:       status = handleGpioWrite(); break;
+            case GpioRead:        status = handleGpioRead(); break;
+            default:              status = UnknownCmd; break;
+        }
+
+        if (status != Ok) response.clear();
+        reply(status);
+    }
+}
+
+/*
+Link
+*/
+bool BinaryProtocolServer::readExact(uint8_t* buffer, size_t length, uint32_t timeoutMs) {
+    size_t got = 0;
+    uint32_t start = millis();
+    while (got < length) {
+        int available = link.available();
+        if (available > 0) {
+            size_t n = std::min<size_t>(available, length - got);
+            got += link.readBytes(buffer + got, n);
+            start = millis();
+        } else if (millis() - start > timeoutMs) {
+            return false;
+        } else {
+            yield();
+        }
+    }
+    return true;
+}
+
+void BinaryProtocolServer::reply(Status status) {
+    uint8_t header[3] = {
+        status,
+        static_cast<uint8_t>(response.size() & 0xFF),
+        static_cast<uint8_t>(response.size() >> 8)
+    };
+    link.write(header, sizeof(header));
+    if (!response.empty()) {
+        link.write(response.data(), response.size());
+    }
+    link.flush();
+}
+
+uint16_t BinaryProtocolServer::u16(size_t offset) const {
+    return request[offset] | (request[offset + 1] << 8);
+}
+
+uint32_t BinaryProtocolServer::u32(size_t offset) const {
+    return request[offset] | (request[offset + 1] << 8) |
+           (request[offset + 2] << 16) | ((uint32_t)request[offset + 3] << 24);
+}
+
+/*
+SPI
+*/
+BinaryProtocolServer::Status BinaryProtocolServer::handleSpiBegin() {
+    uint32_t freq = request.size() >= 4 ? u32(0) : state.getSpiFrequency();
+    if (spiCsHeld) spiService.endTransaction();
+    spiCsHeld = false;
+    spiService.configure(state.getSpiMOSIPin(), state.getSpiMISOPin(),
+                         state.getSpiCLKPin(), state.getSpiCSPin(), freq);
+    spiReady = true;
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleSpiWriteRead() {
+    if (!spiReady) return NotConfigured;
+    if (request.size() < 2) return BadLength;
+
+    uint16_t readLen = u16(0);
+    size_t writeLen = request.size() - 2;
+    if (readLen > MAX_PAYLOAD) return BadLength;
+
+    // Inside a manual CS transaction the bus is already ours
+    response.resize(readLen);
+    if (!spiCsHeld) spiService.beginTransaction();
+    if (writeLen) spiService.transferBytes(request.data() + 2, nullptr, writeLen);
+    if (readLen)  spiService.transferBytes(nullptr, response.data(), readLen);
+    if (!spiCsHeld) spiService.endTransaction();
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleSpiExchange() {
+    if (!spiReady) return NotConfigured;
+
+    response.resize(request.size());
+    if (!spiCsHeld) spiService.beginTransaction();
+    spiService.transferBytes(request.data(), response.data(), request.size());
+    if (!spiCsHeld) spiService.endTransaction();
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleSpiCs() {
+    if (!spiReady) return NotConfigured;
+    if (request.size() != 1) return BadLength;
+
+    // Manual CS, for transactions split across several frames
+    // The bus lock is not recursive, a repeated level is a no-op
+    bool hold = request[0] == 0;
+    if (hold && !spiCsHeld) spiService.beginTransaction();
+    if (!hold && spiCsHeld) spiService.endTransaction();
+    spiCsHeld = hold;
+    return Ok;
+}
+
+/*
+I2C
+*/
+BinaryProtocolServer::Status BinaryProtocolServer::handleI2cBegin() {
+    uint32_t freq = request.size() >= 4 ? u32(0) : state.getI2cFrequency();
+    i2cService.configure(state.getI2cSdaPin(), state.getI2cSclPin(), freq);
+    i2cReady = true;
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleI2cWriteRead() {
+    if (!i2cReady) return NotConfigured;
+    if (request.size() < 2) return BadLength;
+
+    uint8_t addr = request[0];
+    uint8_t readLen = request[1];
+    size_t writeLen = request.size() - 2;
+
+    if (writeLen) {
+        i2cService.beginTransmission(addr);
+        for (size_t i = 0; i < writeLen; ++i) {
+            i2cService.write(request[2 + i]);
+        }
+        // Repeated start when a read follows, 0 means acked
+        if (i2cService.endTransmission(readLen == 0) != 0) return BusError;
+    }
+
+    if (readLen) {
+        // Nothing comes back when the address is not acked
+        uint8_t got = i2cService.requestFrom(addr, readLen);
+        if (got == 0) return BusError;
+        for (uint8_t i = 0; i < got; ++i) {
+            response.push_back(static_cast<uint8_t>(i2cService.read()));
+        }
+    }
+    return Ok;
+}
+
+/*
+UART
+*/
+BinaryProtocolServer::Status BinaryProtocolServer::handleUartBegin() {
+    uint32_t baud = request.size() >= 4 ? u32(0) : state.getUartBaudRate();
+    uartService.configure(baud, state.getUartConfig(), state.getUartRxPin(),
+                          state.getUartTxPin(), state.isUartInverted());
+    uartReady = true;
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleUartWrite() {
+    if (!uartReady) return NotConfigured;
+    uartService.write(request.data(), request.size());
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleUartRead() {
+    if (!uartReady) return NotConfigured;
+    if (request.size() != 4) return BadLength;
+
+    uint16_t maxLen = std::min<uint16_t>(u16(0), MAX_PAYLOAD);
+    uint16_t timeoutMs = u16(2);
+
+    response.resize(maxLen);
+    size_t got = uartService.readBytes(response.data(), maxLen, timeoutMs);
+    response.resize(got);
+    return Ok;
+}
+
+/*
+1-Wire
+*/
+BinaryProtocolServer::Status BinaryProtocolServer::handleOneWireBegin() {
+    uint8_t pin = request.size() >= 1 ? request[0] : state.getOneWirePin();
+    if (!GPIO_IS_VALID_GPIO(pin)) return InvalidPin;
+    if (state.isPinProtected(pin)) return ProtectedPin;
+    oneWireService.configure(pin);
+    oneWireReady = true;
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleOneWireTransfer() {
+    if (!oneWireReady) return NotConfigured;
+    if (request.size() < 2) return BadLength;
+
+    bool doReset = request[0];
+    uint8_t readLen = request[1];
+    size_t writeLen = request.size() - 2;
+
+    bool presence = doReset ? oneWireService.reset() : true;
+    response.push_back(presence ? 1 : 0);
+
+    // OneWire write/read lengths are 8 bits, write in chunks
+    size_t offset = 0;
+    while (offset < writeLen) {
+        uint8_t n = std::min<size_t>(255, writeLen - offset);
+        oneWireService.writeBytes(request.data() + 2 + offset, n);
+        offset += n;
+    }
+
+    if (readLen) {
+        response.resize(1 + readLen);
+        oneWireService.readBytes(response.data() + 1, readLen);
+    }
+    return Ok;
+}
+
+/*
+GPIO
+*/
+BinaryProtocolServer::Status BinaryProtocolServer::handleGpioMode() {
+    if (request.size() != 2) return BadLength;
+    uint8_t pin = request[0];
+    if (!GPIO_IS_VALID_GPIO(pin)) return InvalidPin;
+    if (state.isPinProtected(pin)) return ProtectedPin;
+
+    switch (request[1]) {
+        case 0: pinService.setInput(pin); break;
+        case 1: pinService.setOutput(pin); break;
+        case 2: pinService.setInputPullup(pin); break;
+        case 3: pinService.setInputPullDown(pin); break;
+        default: return BadLength;
+    }
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleGpioWrite() {
+    if (request.size() != 2) return BadLength;
+    uint8_t pin = request[0];
+    if (!GPIO_IS_VALID_GPIO(pin)) return InvalidPin;
+    if (state.isPinProtected(pin)) return ProtectedPin;
+
+    if (request[1]) pinService.setHigh(pin);
+    else pinService.setLow(pin);
+    return Ok;
+}
+
+BinaryProtocolServer::Status BinaryProtocolServer::handleGpioRead() {
+    if (request.empty()) return BadLength;
+
+    response.reserve(request.size());
+    for (uint8_t pin : request) {
+        if (!GPIO_IS_VALID_GPIO(pin)) return InvalidPin;
+        if (state.isPinProtected(pin)) return ProtectedPin;
+        response.push_back(pinService.read(pin) ? 1 : 0);
+    }
+    return Ok;
+}
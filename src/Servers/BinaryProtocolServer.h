@@ -0,0 +1,108 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "Services/SpiService.h"
+#include "Services/I2cService.h"
+#include "Services/UartService.h"
+#include "Services/OneWireService.h"
+#include "Services/PinService.h"
+#include "States/GlobalState.h"
+
+/*
+Binary framed protocol over the serial link, for host scripts.
+
+Request:  [cmd u8][len u16 LE][payload]
+Response: [status u8][len u16 LE][payload]
+
+Buses are configured with the current GlobalState pins and settings,
+payloads are raw bytes and responses are raw bytes, no text formatting.
+*/
+class BinaryProtocolServer {
+public:
+    enum Command : uint8_t {
+        Ping            = 0x00, // -> "BBIO1"
+        Exit            = 0x01,
+
+        SpiBegin        = 0x10, // [freq u32]?
+        SpiWriteRead    = 0x11, // [readLen u16][write...] -> CS low, write, read, CS high
+        SpiExchange     = 0x12, // [tx...] -> full duplex, rx same length
+        SpiCs           = 0x13, // [level u8] -> 0 holds CS low across frames, 1 releases it
+
+        I2cBegin        = 0x20, // [freq u32]?
+        I2cWriteRead    = 0x21, // [addr u8][readLen u8][write...] -> [read...], BusError on NACK
+
+        UartBegin       = 0x30, // [baud u32]?
+        UartWrite       = 0x31, // [data...]
+        UartRead        = 0x32, // [maxLen u16][timeoutMs u16] -> [data...]
+
+        OneWireBegin    = 0x40, // [pin u8]?
+        OneWireTransfer = 0x41, // [reset u8][readLen u8][write...] -> [presence u8][read...]
+
+        GpioMode        = 0x50, // [pin u8][mode u8] 0 input, 1 output, 2 pullup, 3 pulldown
+        GpioWrite       = 0x51, // [pin u8][level u8]
+        GpioRead        = 0x52, // [pin u8...] -> [level u8...]
+    };
+
+    enum Status : uint8_t {
+        Ok            = 0x00,
+        UnknownCmd    = 0x01,
+        BadLength     = 0x02,
+        BusError      = 0x03,
+        ProtectedPin  = 0x04,
+        NotConfigured = 0x05,
+        InvalidPin    = 0x06,
+    };
+
+    static constexpr size_t MAX_PAYLOAD = 4096;
+
+    BinaryProtocolServer(
+        Stream& link,
+        SpiService& spiService,
+        I2cService& i2cService,
+        UartService& uartService,
+        OneWireService& oneWireService,
+        PinService& pinService
+    );
+
+    // Serve frames until an Exit frame, or Enter typed on a terminal
+    void run();
+
+private:
+    Stream& link;
+    SpiService& spiService;
+    I2cService& i2cService;
+    UartService& uartService;
+    OneWireService& oneWireService;
+    PinService& pinService;
+    GlobalState& state = GlobalState::getInstance();
+
+    std::vector<uint8_t> request;
+    std::vector<uint8_t> response;
+    bool spiReady = false;
+    bool spiCsHeld = false; // SpiCs(0) owns the bus until SpiCs(1)
+    bool i2cReady = false;
+    bool uartReady = false;
+    bool oneWireReady = false;
+
+    bool readExact(uint8_t* buffer, size_t length, uint32_t timeoutMs);
+    void reply(Status status);
+
+    Status handleSpiBegin();
+    Status handleSpiWriteRead();
+    Status handleSpiExchange();
+    Status handleSpiCs();
+    Status handleI2cBegin();
+    Status handleI2cWriteRead();
+    Status handleUartBegin();
+    Status handleUartWrite();
+    Status handleUartRead();
+    Status handleOneWireBegin();
+    Status handleOneWireTransfer();
+    Status handleGpioMode();
+    Status handleGpioWrite();
+    Status handleGpioRead();
+
+    uint16_t u16(size_t offset) const;
+    uint32_t u32(size_t offset) const;
+};
@@ -1,4 +1,6 @@
 #include "HttpServer.h"
+#include "Transformers/VcdTransformer.h"
+#include "States/GlobalState.h"
 
 void HttpServer::setupRoutes() {
     // Page HTML
@@ -81,7 +83,18 @@ void HttpServer::setupRoutes() {
     };
     httpd_register_uri_handler(server, &lfs_dl_uri);
 
-    // Note: We can't have more than 8 handlers (ws + 7 above)
+    // GET /logic/capture.vcd
+    static httpd_uri_t logic_uri;
+    logic_uri.uri = "/logic/capture.vcd";
+    logic_uri.method = HTTP_GET;
+    logic_uri.user_ctx = this;
+    logic_uri.handler = [](httpd_req_t *req) -> esp_err_t {
+        HttpServer* self = static_cast<HttpServer*>(req->user_ctx);
+        return self->handleLogicCapture(req);
+    };
+    httpd_register_uri_handler(server, &logic_uri);
+
+    // Note: max_uri_handlers is raised in main, the default is 8 (ws + 7)
 }
 
 esp_err_t HttpServer::handleRootRequest(httpd_req_t *req) {
@@ -308,6 +321,44 @@ esp_err_t HttpServer::handleLittlefsUpload(httpd_req_t* req) {
     return httpd_resp_send(req, "{\"ok\":true}", HTTPD_RESP_USE_STRLEN);
 }
 
+esp_err_t HttpServer::handleLogicCapture(httpd_req_t* req) {
+    if (!logicAnalyzerService) {
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "No logic capture");
+        return ESP_FAIL;
+    }
+
+    // No capture can start or clear the ring until the download is done
+    if (!logicAnalyzerService->tryLockCapture(100)) {
+        httpd_resp_set_status(req, "409 Conflict");
+        return httpd_resp_send(req, "Capture in progress", HTTPD_RESP_USE_STRLEN);
+    }
+    if (!logicAnalyzerService->hasCapture()) {
+        logicAnalyzerService->unlockCapture();
+        httpd_resp_send_err(req, HTTPD_404_NOT_FOUND, "No logic capture");
+        return ESP_FAIL;
+    }
+
+    httpd_resp_set_hdr(req, "Cache-Control", "no-store");
+    httpd_resp_set_hdr(req, "Content-Disposition", "attachment; filename=\"capture.vcd\"");
+    httpd_resp_set_type(req, "text/plain");
+
+    // Encoded while sent, chunk by chunk, nothing is built in RAM
+    VcdTransformer vcd;
+    auto send = [req](const uint8_t* data, size_t length) {
+        return httpd_resp_send_chunk(req, reinterpret_cast<const char*>(data), length) == ESP_OK;
+    };
+    bool ok = vcd.begin(logicAnalyzerService->getCapturePins(), logicAnalyzerService->getEffectiveSampleRate(),
+                        GlobalState::getInstance().getVersion(), send) &&
+              logicAnalyzerService->readRuns([&vcd](uint8_t value, size_t length) {
+                  return vcd.feedRun(value, length);
+              }) &&
+              vcd.finish();
+    logicAnalyzerService->unlockCapture();
+    if (!ok) return ESP_FAIL;
+
+    return httpd_resp_send_chunk(req, nullptr, 0);
+}
+
 std::string HttpServer::urlDecode(const char* s) {
     // Decode %XX and + to space
     std::string out;
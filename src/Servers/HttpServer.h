@@ -5,6 +5,7 @@
 #include <string>
 #include <esp_http_server.h>
 #include "Services/LittleFsService.h"
+#include "Services/LogicAnalyzerService.h"
 #include "Transformers/JsonTransformer.h"
 #include "../webui/index.h"
 #include "../webui/scripts.h"
@@ -16,10 +17,14 @@ public:
         : server(sharedServer), littleFsService(fsService), jsonTransformer(jsonTransformer) {} ;
     void setupRoutes();
 
+    // Serve the last logic capture once the analyzer exists
+    void attachLogicAnalyzer(LogicAnalyzerService& service) { logicAnalyzerService = &service; }
+
 private:
     httpd_handle_t server;
     LittleFsService& littleFsService;
     JsonTransformer& jsonTransformer;
+    LogicAnalyzerService* logicAnalyzerService = nullptr;
     esp_err_t handleRootRequest(httpd_req_t *req);
     esp_err_t handleCssRequest(httpd_req_t *req);
     esp_err_t handleJsRequest(httpd_req_t *req);
@@ -27,6 +32,7 @@ private:
     esp_err_t handleLittlefsDelete(httpd_req_t *req);
     esp_err_t handleLittlefsDownload(httpd_req_t* req);
     esp_err_t handleLittlefsUpload(httpd_req_t* req);
+    esp_err_t handleLogicCapture(httpd_req_t* req);
 
     std::string urlDecode(const char* s);
     std::string sanitizeUploadFilename(const char* raw);
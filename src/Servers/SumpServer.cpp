@@ -0,0 +1,189 @@
+#include "SumpServer.h"
+
+SumpServer::SumpServer(Stream& link, LogicAnalyzerService& logicAnalyzerService)
+    : link(link),
+      logicAnalyzerService(logicAnalyzerService)
+{}
+
+/*
+Run
+*/
+void SumpServer::run(const std::vector<uint8_t>& pins) {
+    if (!logicAnalyzerService.configure(pins, 1000000)) return;
+    resetSettings();
+
+    while (true) {
+        int c = link.read();
+        if (c < 0) continue;
+        uint8_t cmd = c;
+
+        // Never a SUMP command byte, the user is back on a terminal
+        if (cmd == '\r' || cmd == '\n') break;
+
+        if (cmd & 0x80) {
+            uint8_t param[4];
+            if (!readExact(param, 4, 100)) continue;
+            handleLongCommand(cmd, param[0] | (param[1] << 8) | (param[2] << 16) | ((uint32_t)param[3] << 24));
+            continue;
+        }
+
+        switch (cmd) {
+            case Reset:
+                resetSettings();
+                break;
+            case Run:
+                sendCapture();
+                break;
+            case Id:
+                link.write((const uint8_t*)"1ALS", 4);
+                break;
+            case Metadata:
+                sendMetadata();
+                break;
+            default: // XOn, XOff and unknown short commands
+                break;
+        }
+    }
+
+    logicAnalyzerService.end();
+}
+
+/*
+Commands
+*/
+void SumpServer::handleLongCommand(uint8_t cmd, uint32_t param) {
+    switch (cmd) {
+        case SetDivider: {
+            // Faster than the sampler is refused at Run, a clamped rate would skew the host timebase
+            uint32_t rate = CLOCK_HZ / ((param & 0xFFFFFF) + 1);
+            rateSupported = rate <= LogicAnalyzerService::getMaxSampleRate();
+            if (rateSupported) logicAnalyzerService.setSampleRate(rate);
+            break;
+        }
+        case SetCounts:
+            readCount = ((param & 0xFFFF) + 1) * 4;
+            delayCount = ((param >> 16) + 1) * 4;
+            break;
+        case SetDelayCount:
+            delayCount = param;
+            break;
+        case SetReadCount:
+            readCount = param;
+            break;
+        case SetFlags:
+            disabledGroups = (param >> 2) & 0x0F;
+            break;
+        case TriggerMask:
+            triggerMask = param & 0xFF;
+            break;
+        case TriggerValue:
+            triggerValue = param & 0xFF;
+            break;
+        default: // TriggerConfig and stages 1..3, a single parallel stage is supported
+            break;
+    }
+}
+
+void SumpServer::resetSettings() {
+    readCount = 4096;
+    delayCount = 4096;
+    disabledGroups = 0;
+    triggerMask = 0;
+    triggerValue = 0;
+    rateSupported = true;
+}
+
+/*
+Metadata
+*/
+void SumpServer::sendMetadata() {
+    static const char name[] = "ESP32 Bus Pirate";
+    std::string version = state.getVersion();
+
+    link.write((uint8_t)0x01);
+    link.write((const uint8_t*)name, sizeof(name)); // with NUL
+    link.write((uint8_t)0x02);
+    link.write((const uint8_t*)version.c_str(), version.size() + 1);
+
+    writeU32(0x20, logicAnalyzerService.getPins().size());    // probes
+    writeU32(0x21, logicAnalyzerService.getCapacity());       // sample memory
+    writeU32(0x23, LogicAnalyzerService::getMaxSampleRate()); // max rate
+    writeU32(0x24, 2);                                        // protocol version
+    link.write((uint8_t)0x00);
+}
+
+void SumpServer::writeU32(uint8_t token, uint32_t value) {
+    uint8_t bytes[5] = {
+        token,
+        (uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value
+    };
+    link.write(bytes, sizeof(bytes));
+}
+
+/*
+Capture
+*/
+void SumpServer::sendCapture() {
+    // No samples at all, the host reports a timeout instead of a wrong timebase
+    if (!rateSupported) return;
+
+    size_t samples = std::min<size_t>(readCount, logicAnalyzerService.getCapacity());
+    if (samples == 0) return;
+
+    if (triggerMask) {
+        // Delay count is the part after the trigger, the rest of the read count comes before it
+        size_t post = std::min<size_t>(delayCount, samples);
+        size_t pre = samples - post;
+        CaptureTrigger trigger(CaptureTriggerEnum::Pattern, triggerMask, triggerValue & triggerMask);
+
+        // A new command from the host cancels the wait
+        bool fired = logicAnalyzerService.captureTriggered(trigger, pre, post ? post - 1 : 0,
+                                                           [this]() { return link.available() > 0; });
+        if (!fired) return;
+    } else {
+        logicAnalyzerService.clear();
+        logicAnalyzerService.capture(samples);
+    }
+
+    // Only group 0 carries data, the other enabled groups are sent as zeros
+    size_t groups = 0;
+    for (uint8_t g = 0; g < 4; ++g) {
+        if (!(disabledGroups & (1 << g))) groups++;
+    }
+    if (groups == 0) return;
+    bool firstGroup = !(disabledGroups & 0x01);
+
+    // SUMP sends the newest sample first, bulk writes of one chunk at a time
+    uint8_t chunk[512];
+    size_t used = 0;
+    size_t count = logicAnalyzerService.getSampleCount();
+    for (size_t i = 0; i < samples; ++i) {
+        uint8_t sample = logicAnalyzerService.sampleAt(count - 1 - i);
+        for (size_t g = 0; g < groups; ++g) {
+            chunk[used++] = (g == 0 && firstGroup) ? sample : 0;
+        }
+        if (used + groups > sizeof(chunk)) {
+            link.write(chunk, used);
+            used = 0;
+        }
+    }
+    if (used) link.write(chunk, used);
+    link.flush();
+}
+
+/*
+Link
+*/
+bool SumpServer::readExact(uint8_t* buffer, size_t length, uint32_t timeoutMs) {
+    size_t got = 0;
+    uint32_t start = millis();
+    while (got < length) {
+        int c = link.read();
+        if (c >= 0) {
+            buffer[got++] = c;
+            continue;
+        }
+        if (millis() - start >= timeoutMs) return false;
+    }
+    return true;
+}
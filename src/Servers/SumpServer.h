@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+#include <vector>
+#include "Services/LogicAnalyzerService.h"
+#include "States/GlobalState.h"
+
+/*
+SUMP / Openbench Logic Sniffer protocol over the serial link,
+so sigrok (PulseView) or the OLS client can drive the logic analyzer.
+
+Short commands are 1 byte, long commands are 1 byte + 4 bytes LE.
+Captured samples are returned newest first, one byte per enabled group.
+*/
+class SumpServer {
+public:
+    enum Command : uint8_t {
+        Reset          = 0x00,
+        Run            = 0x01,
+        Id             = 0x02, // -> "1ALS"
+        Metadata       = 0x04,
+        XOn            = 0x11,
+        XOff           = 0x13,
+
+        SetDivider     = 0x80, // rate = 100 MHz / (divider + 1)
+        SetCounts      = 0x81, // [read/4 - 1 u16][delay/4 - 1 u16]
+        SetFlags       = 0x82, // bits 2..5 disable channel groups
+        SetDelayCount  = 0x83, // 32 bits variant of SetCounts
+        SetReadCount   = 0x84,
+
+        TriggerMask    = 0xC0, // stage 0, stages 1..3 are +4, +8, +12
+        TriggerValue   = 0xC1,
+        TriggerConfig  = 0xC2,
+    };
+
+    static constexpr uint32_t CLOCK_HZ = 100000000; // SUMP reference clock
+
+    SumpServer(Stream& link, LogicAnalyzerService& logicAnalyzerService);
+
+    // Serve the host until it leaves, a CR/LF in command position returns to the terminal
+    void run(const std::vector<uint8_t>& pins);
+
+private:
+    Stream& link;
+    LogicAnalyzerService& logicAnalyzerService;
+    GlobalState& state = GlobalState::getInstance();
+
+    uint32_t readCount = 0;
+    uint32_t delayCount = 0;
+    uint8_t disabledGroups = 0;
+    uint8_t triggerMask = 0;
+    uint8_t triggerValue = 0;
+    bool rateSupported = true;
+
+    bool readExact(uint8_t* buffer, size_t length, uint32_t timeoutMs);
+    void resetSettings();
+    void handleLongCommand(uint8_t cmd, uint32_t param);
+    void sendMetadata();
+    void sendCapture();
+    void writeU32(uint8_t token, uint32_t value);
+};
@@ -1,10 +1,14 @@
 #include "WebSocketServer.h"
+#include <algorithm>
 
 
 static const char* TAG = "WebSocketServer";
 
 WebSocketServer::WebSocketServer(httpd_handle_t sharedServer)
-    : server(sharedServer) {}
+    : server(sharedServer) {
+    sendBuffer.reserve(SEND_BUFFER_SIZE);
+    if (!inputReady) inputReady = xSemaphoreCreateBinary();
+}
 
 void WebSocketServer::setupRoutes() {
     static httpd_uri_t ws_uri = {
@@ -19,8 +23,6 @@ void WebSocketServer::setupRoutes() {
 }
 
 esp_err_t WebSocketServer::wsHandler(httpd_req_t *req) {
-    WebSocketServer* self = static_cast<WebSocketServer*>(req->user_ctx);
-    
     if (req->method == HTTP_GET) {
         clientFd = httpd_req_to_sockfd(req);  // Capture le socket client
         return ESP_OK;
@@ -46,30 +48,50 @@ esp_err_t WebSocketServer::wsHandler(httpd_req_t *req) {
     }
     frame.payload[frame.len] = '\0';
     
-    // Push chars one by one into buffer
-    for (size_t i = 0; i < frame.len; ++i) {
-        self->buffer.push_back(((char*)frame.payload)[i]);
-    }
+    pushInput((const char*)frame.payload, frame.len);
 
     free(frame.payload);
     return ESP_OK;
 }
 
+void WebSocketServer::pushInput(const char* data, size_t length) {
+    uint32_t start = millis();
+
+    while (length > 0) {
+        size_t n = buffer.push(data, length);
+        data += n;
+        length -= n;
+
+        if (n > 0 && inputReady) xSemaphoreGive(inputReady);
+        if (length == 0) break;
+
+        // Ring is full (large paste), give the reader time to drain it
+        if (millis() - start >= INPUT_FULL_TIMEOUT_MS) {
+            ESP_LOGW(TAG, "Input buffer full, %u bytes dropped", (unsigned)length);
+            break;
+        }
+        vTaskDelay(1);
+    }
+}
+
 char WebSocketServer::readCharBlocking() {
-    while (buffer.empty()) {
-        delay(10);
+    flush();
+
+    char c;
+    while (!buffer.pop(c)) {
+        // Given by the httpd task as soon as input is pushed
+        xSemaphoreTake(inputReady, portMAX_DELAY);
     }
-    char c = buffer.front();
-    buffer.pop_front();
     return c;
 }
 
 char WebSocketServer::readCharNonBlocking() {
-    if (buffer.empty()) return KEY_NONE;
-
-    char c = buffer.front();
-    buffer.pop_front();
-
+    char c;
+    if (!buffer.pop(c)) {
+        flushIfIdle();
+        return KEY_NONE;
+    }
+    flush();
     return c;
 }
 
@@ -78,13 +100,77 @@ void WebSocketServer::sendText(const std::string& msg) {
 
     // Sanitize UTF8
     std::string safeMsg = sanitizeUtf8(msg);
+    append(HTTPD_WS_TYPE_TEXT, reinterpret_cast<const uint8_t*>(safeMsg.data()), safeMsg.size());
+}
+
+void WebSocketServer::sendBinary(const uint8_t* data, size_t length) {
+    if (clientFd < 0) return;
+
+    // Big blocks go out as their own frame, after what is already pending
+    if (length >= SEND_BUFFER_SIZE) {
+        flush();
+        sendFrame(HTTPD_WS_TYPE_BINARY, data, length);
+        return;
+    }
+    append(HTTPD_WS_TYPE_BINARY, data, length);
+}
+
+void WebSocketServer::flush() {
+    if (!sendBuffer.empty()) {
+        sendFrame(sendType, sendBuffer.data(), sendBuffer.size());
+        sendBuffer.clear();
+    }
+    lastFlushMs = millis();
+}
+
+void WebSocketServer::flushIfIdle() {
+    if (!sendBuffer.empty() && millis() - lastFlushMs >= FLUSH_TIMEOUT_MS) {
+        flush();
+    }
+}
+
+void WebSocketServer::append(httpd_ws_type_t type, const uint8_t* data, size_t length) {
+    // A frame carries a single type, text and raw bytes are never mixed
+    if (type != sendType) {
+        flush();
+        sendType = type;
+    }
+
+    while (length > 0) {
+        size_t n = std::min(length, SEND_BUFFER_SIZE - sendBuffer.size());
+
+        // Text frames must hold whole UTF-8 sequences, cut before a continuation byte
+        if (type == HTTPD_WS_TYPE_TEXT && n < length) {
+            while (n > 0 && (data[n] & 0xC0) == 0x80) n--;
+            if (n == 0) {
+                flush();
+                continue;
+            }
+        }
+
+        sendBuffer.insert(sendBuffer.end(), data, data + n);
+        data += n;
+        length -= n;
+
+        if (length > 0 || sendBuffer.size() == SEND_BUFFER_SIZE) flush();
+    }
+
+    if (millis() - lastFlushMs >= FLUSH_TIMEOUT_MS) {
+        flush();
+    }
+}
+
+void WebSocketServer::sendFrame(httpd_ws_type_t type, const uint8_t* data, size_t length) {
+    if (clientFd < 0) return;
 
     httpd_ws_frame_t ws_pkt = {};
-    ws_pkt.type = HTTPD_WS_TYPE_TEXT;
-    ws_pkt.payload = (uint8_t*) safeMsg.c_str();
-    ws_pkt.len = safeMsg.length();
+    ws_pkt.type = type;
+    ws_pkt.payload = const_cast<uint8_t*>(data);
+    ws_pkt.len = length;
 
-    httpd_ws_send_frame_async(server, clientFd, &ws_pkt);
+    if (httpd_ws_send_frame_async(server, clientFd, &ws_pkt) != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to send frame (%u bytes)", (unsigned)length);
+    }
 }
 
 std::string WebSocketServer::sanitizeUtf8(const std::string& input) {
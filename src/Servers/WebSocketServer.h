@@ -1,9 +1,9 @@
 #pragma once
-#include <deque>
 #include <esp_http_server.h>
 #include <vector>
 #include <string>
 #include <Inputs/InputKeys.h>
+#include <Models/SpscRingBuffer.h>
 #include <Arduino.h>
 #include <esp_log.h>
 #include <cstring>
@@ -16,11 +16,31 @@ public:
     char readCharBlocking();
     char readCharNonBlocking();
     void sendText(const std::string& msg);
+    void sendBinary(const uint8_t* data, size_t length);
+    void flush();
+    void flushIfIdle();
     std::string sanitizeUtf8(const std::string& input);
 
 private:
     static esp_err_t wsHandler(httpd_req_t *req);
+    static void pushInput(const char* data, size_t length);
+    void append(httpd_ws_type_t type, const uint8_t* data, size_t length);
+    void sendFrame(httpd_ws_type_t type, const uint8_t* data, size_t length);
+
+    // Output is batched into one frame per few KB or per few ms
+    static constexpr size_t SEND_BUFFER_SIZE = 4096;
+    static constexpr uint32_t FLUSH_TIMEOUT_MS = 10;
+
     httpd_handle_t server;
-    static inline std::deque<char> buffer;
+    std::vector<uint8_t> sendBuffer;
+    httpd_ws_type_t sendType = HTTPD_WS_TYPE_TEXT;
+    uint32_t lastFlushMs = 0;
+
+    // Filled by the httpd task, drained by the terminal task
+    static constexpr size_t INPUT_BUFFER_SIZE = 2048;
+    static constexpr uint32_t INPUT_FULL_TIMEOUT_MS = 1000;
+    static inline SpscRingBuffer<char, INPUT_BUFFER_SIZE> buffer;
+    // Own semaphore, the task notification of the reader belongs to its workers
+    static inline SemaphoreHandle_t inputReady = nullptr;
     static inline int clientFd = -1; 
 };
@@ -0,0 +1,301 @@
+#include "AnalogCaptureService.h"
+#include <algorithm>
+
+AnalogCaptureService::~AnalogCaptureService() {
+    end();
+}
+
+bool AnalogCaptureService::configure(const std::vector<uint8_t>& newPins, uint32_t rate) {
+    end();
+    if (newPins.empty() || newPins.size() > MAX_CHANNELS) return false;
+
+    if (ring.empty()) ring.resize(CAPACITY);
+    pins = newPins;
+    frameCapacity = CAPACITY / pins.size();
+
+    // Continuous mode needs every pin on ADC1, ADC2 is shared with the WiFi radio
+    dmaCapable = ANALOG_CAPTURE_DMA;
+    for (auto pin : pins) {
+        pinMode(pin, INPUT);
+        int8_t channel = digitalPinToAnalogChannel(pin);
+        if (channel < 0 || channel >= 10) dmaCapable = false;
+    }
+
+    configured = true;
+    setSampleRate(rate);
+    clear();
+    return true;
+}
+
+void AnalogCaptureService::setSampleRate(uint32_t rate) {
+    sampleRate = rate == 0 ? 1 : std::min(rate, getMaxSampleRate());
+
+    // The conversion clock is set when the continuous driver starts,
+    // below its lowest clock the analogRead path takes over
+    stopDma();
+    #if ANALOG_CAPTURE_DMA
+        if (configured && dmaCapable && sampleRate * pins.size() >= SOC_ADC_SAMPLE_FREQ_THRES_LOW) {
+            startDma();
+        }
+    #endif
+    nextSampleUs = micros();
+}
+
+void AnalogCaptureService::end() {
+    stopDma();
+    configured = false;
+    dmaCapable = false;
+    pins.clear();
+    clear();
+}
+
+/*
+Capture
+*/
+size_t AnalogCaptureService::capture(size_t frames) {
+    if (!configured || frames == 0) return 0;
+
+    uint16_t frame[MAX_CHANNELS];
+    discardPending();
+
+    size_t taken = 0;
+    while (taken < frames && nextFrame(frame)) {
+        store(frame);
+        taken++;
+    }
+
+    count = std::min(frameCapacity, count + taken);
+    return taken;
+}
+
+bool AnalogCaptureService::captureTriggered(CaptureTrigger& trigger, size_t pre, size_t post, const std::function<bool()>& shouldAbort) {
+    if (!configured) return false;
+
+    pre = std::min(pre, frameCapacity - 1);
+    post = std::min(post, frameCapacity - 1 - pre);
+    clear();
+    trigger.reset();
+    discardPending();
+
+    uint16_t frame[MAX_CHANNELS];
+    size_t armed = 0;  // frames behind the current one, up to pre
+    uint32_t lastAbortCheck = millis();
+
+    // Nothing but sampling and the trigger check runs until it fires
+    while (true) {
+        if (!nextFrame(frame)) return false;
+        store(frame);
+
+        bool matched = trigger.feed(frame[0]);
+        if (matched && armed >= pre) break;
+        if (armed < pre) armed++;
+
+        if (millis() - lastAbortCheck >= 50) {
+            lastAbortCheck = millis();
+            if (shouldAbort && shouldAbort()) return false;
+        }
+    }
+
+    for (size_t i = 0; i < post; ++i) {
+        if (!nextFrame(frame)) return false;
+        store(frame);
+    }
+
+    count = pre + 1 + post;
+    triggerIndex = pre;
+    return true;
+}
+
+bool AnalogCaptureService::nextFrame(uint16_t* frame) {
+    #if ANALOG_CAPTURE_DMA
+        if (dmaRunning) {
+            // Conversions come in pattern order, a frame is complete on the last slot
+            while (true) {
+                if (dmaPos + SOC_ADC_DIGI_RESULT_BYTES > dmaLen) {
+                    uint32_t got = 0;
+                    esp_err_t err = adc_digi_read_bytes(dmaBuffer.data(), dmaBuffer.size(), &got, DMA_TIMEOUT_MS);
+                    // INVALID_STATE only reports a driver pool overflow, the data is still valid
+                    if ((err != ESP_OK && err != ESP_ERR_INVALID_STATE) || got == 0) return false;
+                    dmaPos = 0;
+                    dmaLen = got;
+                }
+
+                auto* result = reinterpret_cast<adc_digi_output_data_t*>(&dmaBuffer[dmaPos]);
+                dmaPos += SOC_ADC_DIGI_RESULT_BYTES;
+
+                if (result->type2.unit != 0 || result->type2.channel >= 16) continue;
+                int8_t slot = slotOfChannel[result->type2.channel];
+                if (slot < 0) continue;
+
+                pending[slot] = result->type2.data;
+                if (slot == (int8_t)pins.size() - 1) {
+                    std::copy(pending, pending + pins.size(), frame);
+                    return true;
+                }
+            }
+        }
+    #endif
+
+    // analogRead fallback, paced on the microsecond clock
+    const uint32_t period = 1000000UL / sampleRate;
+    while ((int32_t)(micros() - nextSampleUs) < 0) {}
+    nextSampleUs += period;
+
+    for (size_t i = 0; i < pins.size(); ++i) {
+        frame[i] = analogRead(pins[i]);
+    }
+    return true;
+}
+
+void AnalogCaptureService::discardPending() {
+    #if ANALOG_CAPTURE_DMA
+        if (dmaRunning) {
+            // Drop what the driver buffered while nobody was reading, bounded at high rates
+            uint32_t got = 0;
+            for (size_t i = 0; i < DMA_STORE_BYTES / DMA_READ_BYTES + 1; ++i) {
+                esp_err_t err = adc_digi_read_bytes(dmaBuffer.data(), dmaBuffer.size(), &got, 0);
+                if ((err != ESP_OK && err != ESP_ERR_INVALID_STATE) || got == 0) break;
+            }
+            dmaPos = dmaLen = 0;
+            return;
+        }
+    #endif
+    nextSampleUs = micros();
+}
+
+void AnalogCaptureService::store(const uint16_t* frame) {
+    std::copy(frame, frame + pins.size(), &ring[head * pins.size()]);
+    if (++head == frameCapacity) head = 0;
+}
+
+/*
+Continuous ADC
+*/
+bool AnalogCaptureService::startDma() {
+    #if ANALOG_CAPTURE_DMA
+        uint32_t mask = 0;
+        adc_digi_pattern_config_t pattern[MAX_CHANNELS] = {};
+        std::fill(std::begin(slotOfChannel), std::end(slotOfChannel), -1);
+
+        for (size_t i = 0; i < pins.size(); ++i) {
+            int8_t channel = digitalPinToAnalogChannel(pins[i]);
+
+            mask |= 1u << channel;
+            slotOfChannel[channel] = i;
+            pattern[i].atten = ADC_ATTEN_DB_11;
+            pattern[i].channel = channel;
+            pattern[i].unit = 0;
+            pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+        }
+
+        adc_digi_init_config_t init = {};
+        init.max_store_buf_size = DMA_STORE_BYTES;
+        init.conv_num_each_intr = DMA_READ_BYTES;
+        init.adc1_chan_mask = mask;
+        init.adc2_chan_mask = 0;
+        if (adc_digi_initialize(&init) != ESP_OK) return false;
+
+        adc_digi_configuration_t config = {};
+        config.conv_limit_en = false;
+        config.conv_limit_num = 250;
+        config.pattern_num = pins.size();
+        config.adc_pattern = pattern;
+        config.sample_freq_hz = sampleRate * pins.size();
+        config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+        config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+
+        if (adc_digi_controller_configure(&config) != ESP_OK || adc_digi_start() != ESP_OK) {
+            adc_digi_deinitialize();
+            return false;
+        }
+
+        dmaBuffer.resize(DMA_READ_BYTES);
+        dmaPos = dmaLen = 0;
+        dmaRunning = true;
+        return true;
+    #else
+        return false;
+    #endif
+}
+
+void AnalogCaptureService::stopDma() {
+    #if ANALOG_CAPTURE_DMA
+        if (dmaRunning) {
+            adc_digi_stop();
+            adc_digi_deinitialize();
+            dmaRunning = false;
+        }
+    #endif
+}
+
+/*
+Access
+*/
+void AnalogCaptureService::clear() {
+    head = 0;
+    count = 0;
+    triggerIndex = 0;
+}
+
+uint16_t AnalogCaptureService::sampleAt(size_t index, uint8_t channel) const {
+    if (index >= count || channel >= pins.size()) return 0;
+    size_t frame = (head + frameCapacity - count + index) % frameCapacity;
+    return ring[frame * pins.size() + channel];
+}
+
+void AnalogCaptureService::decimateMinMax(uint8_t channel, size_t start, size_t length, size_t width,
+                                          std::vector<uint16_t>& mins, std::vector<uint16_t>& maxs) const {
+    mins.clear();
+    maxs.clear();
+    if (width == 0 || channel >= pins.size() || start >= count) return;
+
+    length = std::min(length, count - start);
+    size_t perColumn = std::max<size_t>(1, length / width);
+    size_t columns = std::min(width, length / perColumn);
+    mins.reserve(columns);
+    maxs.reserve(columns);
+
+    for (size_t col = 0; col < columns; ++col) {
+        size_t from = start + col * perColumn;
+        uint16_t low = 0xFFFF, high = 0;
+        for (size_t i = 0; i < perColumn; ++i) {
+            uint16_t v = sampleAt(from + i, channel);
+            low = std::min(low, v);
+            high = std::max(high, v);
+        }
+        mins.push_back(low);
+        maxs.push_back(high);
+    }
+}
+
+size_t AnalogCaptureService::getSampleCount() const {
+    return count;
+}
+
+size_t AnalogCaptureService::getTriggerIndex() const {
+    return triggerIndex;
+}
+
+uint32_t AnalogCaptureService::getSampleRate() const {
+    return sampleRate;
+}
+
+uint32_t AnalogCaptureService::getMaxSampleRate() const {
+    size_t channels = pins.empty() ? 1 : pins.size();
+    #if ANALOG_CAPTURE_DMA
+        if (dmaCapable) return SOC_ADC_SAMPLE_FREQ_THRES_HIGH / channels;
+    #endif
+    return ANALOG_READ_MAX_RATE / channels;
+}
+
+const std::vector<uint8_t>& AnalogCaptureService::getPins() const {
+    return pins;
+}
+
+bool AnalogCaptureService::isConfigured() const {
+    return configured;
+}
+
+bool AnalogCaptureService::isDma() const {
+    return dmaRunning;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <functional>
+#include "Models/CaptureTrigger.h"
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3)
+    #include "driver/adc.h"
+    #define ANALOG_CAPTURE_DMA 1
+#else
+    #define ANALOG_CAPTURE_DMA 0
+#endif
+
+/*
+Analog capture of up to 4 ADC pins at a fixed sample rate.
+On the ESP32-S3 the ADC runs in continuous mode and DMA paces the
+conversions, channels are interleaved by the ADC pattern table.
+Elsewhere samples are taken with analogRead on the microsecond clock.
+Raw 12 bits samples are stored in a ring of frames, oldest first.
+*/
+class AnalogCaptureService {
+public:
+    static constexpr uint8_t MAX_CHANNELS = 4;
+    static constexpr size_t CAPACITY = 16384; // values, shared by the channels
+
+    ~AnalogCaptureService();
+
+    // Sample rate is per channel
+    bool configure(const std::vector<uint8_t>& pins, uint32_t sampleRate);
+    void setSampleRate(uint32_t sampleRate);
+    void end();
+
+    // Take `count` frames at the configured rate, appended to the ring
+    size_t capture(size_t count);
+
+    // Sample until the trigger fires on the first channel with `pre` frames behind it,
+    // then take `post` more and freeze
+    bool captureTriggered(CaptureTrigger& trigger, size_t pre, size_t post, const std::function<bool()>& shouldAbort);
+
+    void clear();
+    uint16_t sampleAt(size_t index, uint8_t channel = 0) const;
+
+    // Lowest and highest value per column, so spikes and ripple survive the zoom out
+    void decimateMinMax(uint8_t channel, size_t start, size_t length, size_t width,
+                        std::vector<uint16_t>& mins, std::vector<uint16_t>& maxs) const;
+
+    size_t getSampleCount() const;
+    size_t getTriggerIndex() const;
+    uint32_t getSampleRate() const;
+    uint32_t getMaxSampleRate() const;
+    const std::vector<uint8_t>& getPins() const;
+    bool isConfigured() const;
+    bool isDma() const;
+
+private:
+    bool nextFrame(uint16_t* frame);
+    void store(const uint16_t* frame);
+    void discardPending();
+    bool startDma();
+    void stopDma();
+
+    static constexpr uint32_t ANALOG_READ_MAX_RATE = 20000;
+    static constexpr uint32_t DMA_TIMEOUT_MS = 100;
+    static constexpr size_t DMA_READ_BYTES = 256;
+    static constexpr size_t DMA_STORE_BYTES = 4096;
+
+    std::vector<uint8_t> pins;
+    std::vector<uint16_t> ring;
+    bool configured = false;
+    uint32_t sampleRate = 1000;
+    size_t frameCapacity = 0;
+    size_t head = 0;  // next frame written
+    size_t count = 0; // frames held
+    size_t triggerIndex = 0;
+
+    // analogRead pacing
+    uint32_t nextSampleUs = 0;
+
+    // Continuous ADC, channel to pattern slot and the last DMA block
+    bool dmaCapable = false;
+    bool dmaRunning = false;
+    int8_t slotOfChannel[16];
+    std::vector<uint8_t> dmaBuffer;
+    size_t dmaPos = 0;
+    size_t dmaLen = 0;
+    uint16_t pending[MAX_CHANNELS];
+};
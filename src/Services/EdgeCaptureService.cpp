@@ -0,0 +1,89 @@
+#include "EdgeCaptureService.h"
+#include <esp_heap_caps.h>
+#include "soc/gpio_reg.h"
+#include <algorithm>
+
+EdgeCaptureService::~EdgeCaptureService() {
+    end();
+}
+
+bool EdgeCaptureService::begin(uint8_t pin) {
+    return begin(std::vector<uint8_t>{ pin });
+}
+
+bool EdgeCaptureService::begin(const std::vector<uint8_t>& newPins) {
+    end();
+    if (newPins.empty() || newPins.size() > MAX_CHANNELS) return false;
+
+    if (!ring) {
+        ring = (Edge*)heap_caps_malloc(CAPACITY * sizeof(Edge), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (!ring) return false;
+    }
+
+    pins = newPins;
+    head = 0;
+    tail = 0;
+    dropped = 0;
+
+    // The channel travels as the interrupt argument
+    for (size_t i = 0; i < pins.size(); ++i) {
+        inputRegs[i] = pins[i] < 32 ? GPIO_IN_REG : GPIO_IN1_REG;
+        shifts[i] = pins[i] < 32 ? pins[i] : pins[i] - 32;
+        pinMode(pins[i], INPUT);
+        attachInterruptArg(pins[i], onInterrupt, (void*)(uintptr_t)i, CHANGE);
+    }
+
+    running = true;
+    return true;
+}
+
+void EdgeCaptureService::end() {
+    if (!running) return;
+    for (auto pin : pins) {
+        detachInterrupt(pin);
+    }
+    pins.clear();
+    running = false;
+}
+
+void IRAM_ATTR EdgeCaptureService::onInterrupt(void* arg) {
+    uint32_t now = ESP.getCycleCount();
+    uint8_t channel = (uintptr_t)arg;
+    uint8_t level = (REG_READ(inputRegs[channel]) >> shifts[channel]) & 1;
+
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= CAPACITY) {
+        dropped = dropped + 1;
+        return;
+    }
+
+    Edge& edge = ring[h & MASK];
+    edge.cycles = now;
+    edge.level = level;
+    edge.channel = channel;
+    head.store(h + 1, std::memory_order_release);
+}
+
+size_t EdgeCaptureService::read(Edge* out, size_t max) {
+    size_t t = tail.load(std::memory_order_relaxed);
+    size_t n = std::min(max, head.load(std::memory_order_acquire) - t);
+
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = ring[(t + i) & MASK];
+    }
+
+    tail.store(t + n, std::memory_order_release);
+    return n;
+}
+
+bool EdgeCaptureService::hasPending() const {
+    return head.load(std::memory_order_acquire) != tail.load(std::memory_order_relaxed);
+}
+
+uint32_t EdgeCaptureService::getDropped() const {
+    return dropped;
+}
+
+bool EdgeCaptureService::isRunning() const {
+    return running;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include <vector>
+
+/*
+Edge timestamps of GPIOs, taken by an interrupt on both edges.
+Each edge is the CPU cycle counter, the level read right after and the
+channel (index in the pins), pushed into one lock-free ring drained by
+one reader on the same core, so all channels share the same timebase.
+The GPIO ISR service is not an IRAM one, edges during flash writes are missed.
+*/
+class EdgeCaptureService {
+public:
+    struct Edge {
+        uint32_t cycles;
+        uint8_t level;
+        uint8_t channel;
+    };
+
+    static constexpr size_t CAPACITY = 1024; // power of two
+    static constexpr size_t MAX_CHANNELS = 48;
+
+    ~EdgeCaptureService();
+
+    bool begin(uint8_t pin);
+    bool begin(const std::vector<uint8_t>& pins);
+    void end();
+
+    // Move up to `max` edges oldest first, returns how many
+    size_t read(Edge* out, size_t max);
+    bool hasPending() const;
+
+    // Edges lost because the ring was full, since begin()
+    uint32_t getDropped() const;
+    bool isRunning() const;
+
+private:
+    static void IRAM_ATTR onInterrupt(void* arg);
+
+    static constexpr size_t MASK = CAPACITY - 1;
+
+    // Static so they live in DRAM, whatever allocated the service
+    static inline Edge* ring = nullptr;
+    static inline std::atomic<size_t> head{0};
+    static inline std::atomic<size_t> tail{0};
+    static inline volatile uint32_t dropped = 0;
+    static inline uint32_t inputRegs[MAX_CHANNELS];
+    static inline uint8_t shifts[MAX_CHANNELS];
+
+    std::vector<uint8_t> pins;
+    bool running = false;
+};
@@ -0,0 +1,196 @@
+#include "FileStreamService.h"
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+FileStreamService::~FileStreamService() {
+    end();
+    if (stopped) vSemaphoreDelete(stopped);
+}
+
+bool FileStreamService::beginWrite(File& target) {
+    return start(target, true);
+}
+
+bool FileStreamService::beginRead(File& source) {
+    if (!start(source, false)) return false;
+
+    // Both buffers are prefetched, then refilled as they are drained
+    submit(0, 0);
+    submit(1, 0);
+    return true;
+}
+
+bool FileStreamService::start(File& target, bool write) {
+    end();
+
+    for (auto& buffer : buffers) {
+        buffer = (uint8_t*)malloc(BUFFER_SIZE);
+    }
+    jobs = xQueueCreate(4, sizeof(Job));
+    done = xQueueCreate(4, sizeof(Job));
+    if (!stopped) stopped = xSemaphoreCreateBinary();
+
+    file = &target;
+    writing = write;
+    failed = false;
+    active = 0;
+    used = 0;
+    available = 0;
+    holding = false;
+    endOfFile = false;
+    pending = 0;
+
+    // The worker takes the SD card on the other core
+    BaseType_t otherCore = xPortGetCoreID() ^ 1;
+    if (!buffers[0] || !buffers[1] || !jobs || !done || !stopped ||
+        xTaskCreatePinnedToCore(workerTask, "fileStream", 6144, this, 1, &worker, otherCore) != pdPASS) {
+        worker = nullptr;
+        end();
+        return false;
+    }
+    return true;
+}
+
+void FileStreamService::end() {
+    if (worker) {
+        if (writing) flush();
+
+        // Jobs are done in order, the stop comes after the last one
+        Job stop = { 0, true, 0 };
+        xQueueSend(jobs, &stop, portMAX_DELAY);
+        xSemaphoreTake(stopped, portMAX_DELAY);
+        worker = nullptr;
+    }
+
+    if (jobs) vQueueDelete(jobs);
+    if (done) vQueueDelete(done);
+    jobs = nullptr;
+    done = nullptr;
+
+    for (auto& buffer : buffers) {
+        free(buffer);
+        buffer = nullptr;
+    }
+    file = nullptr;
+    pending = 0;
+}
+
+/*
+Write
+*/
+bool FileStreamService::write(const uint8_t* data, size_t length) {
+    if (!worker || !writing) return false;
+
+    while (length && !failed) {
+        size_t n = std::min(length, BUFFER_SIZE - used);
+        memcpy(buffers[active] + used, data, n);
+        used += n;
+        data += n;
+        length -= n;
+
+        if (used == BUFFER_SIZE) {
+            submit(active, used);
+            active ^= 1;
+            used = 0;
+        }
+    }
+    return !failed;
+}
+
+bool FileStreamService::flush() {
+    if (!worker || !writing) return !failed;
+
+    if (used) {
+        submit(active, used);
+        active ^= 1;
+        used = 0;
+    }
+    while (pending) waitDone();
+    return !failed;
+}
+
+/*
+Read
+*/
+size_t FileStreamService::read(uint8_t* data, size_t length) {
+    if (!worker || writing) return 0;
+
+    size_t total = 0;
+    while (total < length) {
+        if (used == available) {
+            if (endOfFile) break;
+
+            // Refill the drained buffer behind the other one
+            if (holding) {
+                submit(active, 0);
+                active ^= 1;
+                holding = false;
+            }
+
+            Job job = waitDone();
+            holding = true;
+            used = 0;
+            available = job.length;
+            if (available == 0) {
+                endOfFile = true;
+                break;
+            }
+        }
+
+        size_t n = std::min(length - total, available - used);
+        memcpy(data + total, buffers[active] + used, n);
+        used += n;
+        total += n;
+    }
+    return total;
+}
+
+bool FileStreamService::hasFailed() const {
+    return failed;
+}
+
+/*
+Worker
+*/
+void FileStreamService::submit(uint8_t buffer, size_t length) {
+    // At most one buffer waits for the worker while the other one is in use
+    if (writing) {
+        while (pending >= 1) waitDone();
+    }
+
+    Job job = { buffer, false, (uint16_t)length };
+    xQueueSend(jobs, &job, portMAX_DELAY);
+    pending++;
+}
+
+FileStreamService::Job FileStreamService::waitDone() {
+    Job job = { 0, false, 0 };
+    if (pending == 0) return job;
+
+    xQueueReceive(done, &job, portMAX_DELAY);
+    pending--;
+    return job;
+}
+
+void FileStreamService::workerTask(void* param) {
+    auto* self = static_cast<FileStreamService*>(param);
+    Job job;
+
+    while (xQueueReceive(self->jobs, &job, portMAX_DELAY) == pdTRUE && !job.stop) {
+        uint8_t* buffer = self->buffers[job.buffer];
+
+        if (self->writing) {
+            if (!self->failed && self->file->write(buffer, job.length) != job.length) self->failed = true;
+        } else {
+            int n = self->failed ? 0 : self->file->read(buffer, BUFFER_SIZE);
+            if (n < 0) self->failed = true;
+            job.length = n > 0 ? n : 0;
+        }
+
+        xQueueSend(self->done, &job, portMAX_DELAY);
+    }
+
+    xSemaphoreGive(self->stopped);
+    vTaskDelete(nullptr);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Arduino.h>
+#include <FS.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+Double buffered file I/O on a worker task.
+While the worker writes (or prefetches) one buffer on the other core,
+the caller fills (or drains) the other one, so a transfer on a serial
+link keeps going instead of stalling on every SD access.
+The file must not be touched by the caller between begin and end.
+*/
+class FileStreamService {
+public:
+    static constexpr size_t BUFFER_SIZE = 8192;
+
+    ~FileStreamService();
+
+    bool beginWrite(File& file);
+    bool write(const uint8_t* data, size_t length);
+
+    // Hand what is left to the worker and wait for it, false if any write failed
+    bool flush();
+
+    bool beginRead(File& file);
+
+    // Next bytes in file order, less than asked at the end of the file
+    size_t read(uint8_t* data, size_t length);
+
+    // Flushes a write stream, stops the worker
+    void end();
+    bool hasFailed() const;
+
+private:
+    struct Job {
+        uint8_t buffer;
+        bool stop;
+        uint16_t length;
+    };
+
+    bool start(File& file, bool writing);
+    void submit(uint8_t buffer, size_t length);
+    Job waitDone();
+    static void workerTask(void* param);
+
+    File* file = nullptr;
+    bool writing = false;
+    volatile bool failed = false;
+    uint8_t* buffers[2] = { nullptr, nullptr };
+    uint8_t active = 0;
+    size_t used = 0;       // written to, or read from, the active buffer
+    size_t available = 0;  // bytes read into the active buffer
+    bool holding = false;  // the active buffer came back from the worker
+    bool endOfFile = false;
+    uint8_t pending = 0;   // jobs at the worker
+
+    QueueHandle_t jobs = nullptr;
+    QueueHandle_t done = nullptr;
+    TaskHandle_t worker = nullptr;
+    SemaphoreHandle_t stopped = nullptr; // given by the worker before it ends
+};
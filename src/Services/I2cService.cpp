@@ -1,5 +1,6 @@
 #include "I2cService.h"
 #include "driver/gpio.h"
+#include <algorithm>
 
 void I2cService::configure(uint8_t sda, uint8_t scl, uint32_t frequency) {
     Wire.end();
@@ -76,7 +77,7 @@ std::string I2cService::executeByteCode(const std::vector<ByteCode>& bytecodes)
                         transmissionStarted = false;
                     }
 
-                    uint8_t toRead = code.getRepeat();
+                    uint8_t toRead = std::min<uint32_t>(code.getRepeat(), 255);
                     uint8_t readAddr = currentAddress;
 
                     Wire.requestFrom(readAddr, toRead);
@@ -329,6 +330,96 @@ bool I2cService::i2cBitBangRecoverBus(uint8_t scl, uint8_t sda, uint32_t freqHz)
     return gpio_get_level((gpio_num_t)sda) == 1;
 }
 
+/*
+Quick probe
+*/
+void I2cService::i2cProbeBegin(uint8_t scl, uint8_t sda) {
+    // Both lines released, a device or the pull-ups drive them high
+    for (uint8_t pin : { scl, sda }) {
+        gpio_reset_pin((gpio_num_t)pin);
+        gpio_set_pull_mode((gpio_num_t)pin, GPIO_PULLUP_ONLY);
+        gpio_set_direction((gpio_num_t)pin, GPIO_MODE_INPUT_OUTPUT_OD);
+        gpio_set_level((gpio_num_t)pin, 1);
+    }
+}
+
+uint32_t I2cService::i2cProbeRiseTimeNs(uint8_t pin, uint32_t timeoutUs) {
+    gpio_set_level((gpio_num_t)pin, 0);
+    i2cBitBangDelay(5);
+
+    // Cycles from release to a high read, the read itself is included
+    uint32_t timeoutCycles = timeoutUs * ESP.getCpuFreqMHz();
+    uint32_t start = ESP.getCycleCount();
+    gpio_set_level((gpio_num_t)pin, 1);
+    while (!gpio_get_level((gpio_num_t)pin)) {
+        if (ESP.getCycleCount() - start >= timeoutCycles) return UINT32_MAX;
+    }
+    uint32_t elapsed = ESP.getCycleCount() - start;
+
+    return elapsed * 1000 / ESP.getCpuFreqMHz();
+}
+
+bool I2cService::i2cProbeWaitHigh(uint8_t pin, uint32_t timeoutUs) {
+    if (gpio_get_level((gpio_num_t)pin)) return true;
+
+    uint32_t start = micros();
+    while (!gpio_get_level((gpio_num_t)pin)) {
+        if (micros() - start >= timeoutUs) return false;
+    }
+    return true;
+}
+
+bool I2cService::i2cProbeClock(uint8_t scl, uint32_t halfPeriodUs, uint32_t timeoutUs) {
+    // Released clock can be held low by a stretching device
+    gpio_set_level((gpio_num_t)scl, 1);
+    bool high = i2cProbeWaitHigh(scl, timeoutUs);
+    i2cBitBangDelay(halfPeriodUs);
+    return high;
+}
+
+I2cService::ProbeResult I2cService::i2cProbeAddress(uint8_t scl, uint8_t sda, uint8_t addr, uint32_t halfPeriodUs, uint32_t timeoutUs) {
+    if (!i2cProbeWaitHigh(scl, timeoutUs) || !i2cProbeWaitHigh(sda, timeoutUs)) {
+        return ProbeResult::BusStuck;
+    }
+
+    // START
+    gpio_set_level((gpio_num_t)sda, 0);
+    i2cBitBangDelay(halfPeriodUs);
+    gpio_set_level((gpio_num_t)scl, 0);
+
+    // Address and write bit, MSB first
+    uint8_t byte = addr << 1;
+    bool clocked = true;
+    for (int i = 7; i >= 0 && clocked; --i) {
+        gpio_set_level((gpio_num_t)sda, (byte >> i) & 0x01);
+        i2cBitBangDelay(halfPeriodUs);
+        clocked = i2cProbeClock(scl, halfPeriodUs, timeoutUs);
+        gpio_set_level((gpio_num_t)scl, 0);
+    }
+
+    // ACK, the device pulls SDA low during the 9th clock
+    bool ack = false;
+    if (clocked) {
+        gpio_set_level((gpio_num_t)sda, 1);
+        i2cBitBangDelay(halfPeriodUs);
+        gpio_set_level((gpio_num_t)scl, 1);
+        clocked = i2cProbeWaitHigh(scl, timeoutUs);
+        ack = gpio_get_level((gpio_num_t)sda) == 0;
+        i2cBitBangDelay(halfPeriodUs);
+        gpio_set_level((gpio_num_t)scl, 0);
+    }
+
+    // STOP, even after a timeout so the device lets go
+    gpio_set_level((gpio_num_t)sda, 0);
+    i2cBitBangDelay(halfPeriodUs);
+    i2cProbeClock(scl, halfPeriodUs, timeoutUs);
+    gpio_set_level((gpio_num_t)sda, 1);
+    i2cBitBangDelay(halfPeriodUs);
+
+    if (!clocked) return ProbeResult::Timeout;
+    return ack ? ProbeResult::Ack : ProbeResult::Nack;
+}
+
 void I2cService::rapidStartStop(uint8_t address, uint32_t freqHz, uint8_t scl, uint8_t sda) {
     uint32_t d = 500000 / freqHz;
     bool ack;
@@ -627,6 +718,29 @@ bool I2cService::readReg(uint8_t addr, uint8_t reg, uint8_t* outVal, uint32_t* o
     return ok;
 }
 
+size_t I2cService::readRegisters(uint8_t addr, uint16_t reg, bool wideAddress, uint8_t* out, size_t length) {
+    length = std::min(length, MAX_READ);
+
+    beginTransmission(addr);
+    if (wideAddress) write((reg >> 8) & 0xFF);
+    write(reg & 0xFF);
+    if (endTransmission(false) != 0) return 0; // repeated START follows
+
+    return readRaw(addr, out, length);
+}
+
+size_t I2cService::readRaw(uint8_t addr, uint8_t* out, size_t length) {
+    length = std::min(length, MAX_READ);
+
+    size_t received = requestFrom(addr, (uint8_t)length, true);
+    size_t n = 0;
+    while (n < received && available()) {
+        out[n++] = (uint8_t)read();
+    }
+    while (available()) (void)read();
+    return n;
+}
+
 bool I2cService::probeReadableReg(uint8_t addr, uint8_t reg) {
     beginTransmission(addr);
     write(reg);
@@ -21,6 +21,15 @@ public:
     bool ping(uint8_t addr, bool sendStop = true, uint32_t* outDtUs = nullptr);
     bool readReg(uint8_t addr, uint8_t reg, uint8_t* outVal, uint32_t* outDtUs = nullptr);
 
+    // Largest read in one transaction, the Wire buffer
+    static constexpr size_t MAX_READ = I2C_BUFFER_LENGTH < 255 ? I2C_BUFFER_LENGTH : 255;
+
+    // Auto-increment read from `reg` (1 or 2 address bytes), returns the bytes received
+    size_t readRegisters(uint8_t addr, uint16_t reg, bool wideAddress, uint8_t* out, size_t length);
+
+    // Read without register pointer, from where the device is
+    size_t readRaw(uint8_t addr, uint8_t* out, size_t length);
+
     // I2C Bit bang
     void i2cBitBangDelay(uint32_t delayUs);
     void i2cBitBangSetLevel(uint8_t pin, bool level);
@@ -33,6 +42,12 @@ public:
     void i2cBitBangStopCondition(uint8_t scl, uint8_t sda, uint32_t delayUs);
     bool i2cBitBangRecoverBus(uint8_t scl, uint8_t sda, uint32_t freqHz);
 
+    // Quick probe, open drain bit bang, Wire must be ended
+    enum class ProbeResult : uint8_t { Ack, Nack, Timeout, BusStuck };
+    void i2cProbeBegin(uint8_t scl, uint8_t sda);
+    uint32_t i2cProbeRiseTimeNs(uint8_t pin, uint32_t timeoutUs = 100); // UINT32_MAX if it never rises
+    ProbeResult i2cProbeAddress(uint8_t scl, uint8_t sda, uint8_t addr, uint32_t halfPeriodUs, uint32_t timeoutUs);
+
     // Slave
     static constexpr size_t SLAVE_LOG_MAX = 128;
     void beginSlave(uint8_t address, uint8_t sda, uint8_t scl, uint32_t freq = 100000);
@@ -79,6 +94,8 @@ public:
 private:
     ExternalEEPROM eeprom;
     bool probeReadableReg(uint8_t addr, uint8_t reg);
+    bool i2cProbeWaitHigh(uint8_t pin, uint32_t timeoutUs);
+    bool i2cProbeClock(uint8_t scl, uint32_t halfPeriodUs, uint32_t timeoutUs);
 
     static void onSlaveReceive(int len);
     static void onSlaveRequest();
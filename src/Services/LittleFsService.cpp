@@ -186,6 +186,16 @@ bool LittleFsService::write(const std::string& userPath, const uint8_t* data, si
     return ok;
 }
 
+fs::File LittleFsService::openWrite(const std::string& userPath) {
+    if (!_mounted || _readOnly) return fs::File();
+
+    std::string p;
+    if (!normalizeUserPath(userPath, p, /*dir=*/false)) return fs::File();
+    if (!ensureParentDirs(p)) return fs::File();
+
+    return LittleFS.open(p.c_str(), "w", true);
+}
+
 bool LittleFsService::mkdirRecursive(const std::string& userDir) const {
     if (!_mounted || _readOnly) return false;
 
@@ -37,6 +37,7 @@ public:
 
     bool write(const std::string& userPath, const std::string& data, bool append=false);
     bool write(const std::string& userPath, const uint8_t* data, size_t len, bool append=false);
+    fs::File openWrite(const std::string& userPath); // truncates, for streamed writes
 
     bool mkdirRecursive(const std::string& userDir) const;
     bool removeFile    (const std::string& userPath);
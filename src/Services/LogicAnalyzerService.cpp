@@ -0,0 +1,538 @@
+#include "LogicAnalyzerService.h"
+#include <esp_heap_caps.h>
+#include "soc/gpio_reg.h"
+
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    #include "hal/dedic_gpio_cpu_ll.h"
+#endif
+
+LogicAnalyzerService::~LogicAnalyzerService() {
+    end();
+    if (ring) heap_caps_free(ring);
+    if (streamDone) vSemaphoreDelete(streamDone);
+    if (captureMutex) vSemaphoreDelete(captureMutex);
+}
+
+bool LogicAnalyzerService::configure(const std::vector<uint8_t>& newPins, uint32_t rate) {
+    end();
+
+    if (newPins.empty() || newPins.size() > MAX_CHANNELS) return false;
+    if (!allocate()) return false;
+
+    pins = newPins;
+    setSampleRate(rate);
+    clear();
+
+    for (auto pin : pins) {
+        pinMode(pin, INPUT);
+    }
+
+    // Fast path when channels are consecutive GPIOs, one shift and one mask per sample
+    firstPin = pins[0];
+    mask = (1u << pins.size()) - 1;
+    contiguous = true;
+    needHighBank = false;
+    for (size_t i = 0; i < pins.size(); ++i) {
+        if (pins[i] != firstPin + i) contiguous = false;
+        if (pins[i] >= 32) needHighBank = true;
+    }
+    if (needHighBank) contiguous = false;
+
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        // Dedicated GPIO reads all channels with a single CPU instruction
+        int gpios[MAX_CHANNELS];
+        for (size_t i = 0; i < pins.size(); ++i) gpios[i] = pins[i];
+
+        dedic_gpio_bundle_config_t config = {};
+        config.gpio_array = gpios;
+        config.array_size = pins.size();
+        config.flags.in_en = 1;
+
+        if (dedic_gpio_new_bundle(&config, &bundle) != ESP_OK) {
+            bundle = nullptr;
+        } else {
+            dedic_gpio_get_in_offset(bundle, &bundleOffset);
+        }
+    #endif
+
+    return true;
+}
+
+void LogicAnalyzerService::setSampleRate(uint32_t rate) {
+    uint32_t maxRate = getMaxSampleRate();
+    sampleRate = rate == 0 ? 1 : (rate > maxRate ? maxRate : rate);
+}
+
+void LogicAnalyzerService::end() {
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        if (bundle) {
+            dedic_gpio_del_bundle(bundle);
+            bundle = nullptr;
+        }
+    #endif
+    // The last capture stays for the screen and downloads until the next configure
+    pins.clear();
+}
+
+bool LogicAnalyzerService::allocate() {
+    if (ring) return true;
+
+    // Large ring in PSRAM, small one in internal RAM as fallback
+    ring = (uint8_t*)heap_caps_malloc(PSRAM_CAPACITY, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (ring) {
+        capacity = PSRAM_CAPACITY;
+        inPsram = true;
+        return true;
+    }
+
+    ring = (uint8_t*)heap_caps_malloc(INTERNAL_CAPACITY, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ring) {
+        capacity = INTERNAL_CAPACITY;
+        inPsram = false;
+        return true;
+    }
+
+    capacity = 0;
+    return false;
+}
+
+uint8_t LogicAnalyzerService::readSample() const {
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        if (bundle) {
+            return (dedic_gpio_cpu_ll_read_in() >> bundleOffset) & mask;
+        }
+    #endif
+
+    uint32_t low = REG_READ(GPIO_IN_REG);
+    if (contiguous) {
+        return (low >> firstPin) & mask;
+    }
+
+    uint32_t high = needHighBank ? REG_READ(GPIO_IN1_REG) : 0;
+    uint8_t sample = 0;
+    for (size_t i = 0; i < pins.size(); ++i) {
+        uint8_t pin = pins[i];
+        uint32_t level = pin < 32 ? (low >> pin) : (high >> (pin - 32));
+        sample |= (level & 1) << i;
+    }
+    return sample;
+}
+
+size_t LogicAnalyzerService::capture(size_t samples) {
+    if (!ring || pins.empty() || samples == 0) return 0;
+    lockCapture();
+    rle.clear();
+
+    // Sample clock is the CPU cycle counter, late samples catch up without shifting the timebase
+    const uint32_t cpuHz = getCpuFrequencyMhz() * 1000000UL;
+    const uint32_t period = cpuHz / sampleRate;
+    const size_t windowSamples = std::max<size_t>(1, (uint64_t)sampleRate * MASKED_WINDOW_US / 1000000ULL);
+
+    uint32_t start = ESP.getCycleCount();
+    uint32_t windowEnd = start;
+    uint64_t elapsed = 0;
+    uint32_t next = start;
+    size_t done = 0;
+
+    while (done < samples) {
+        size_t window = std::min(samples - done, windowSamples);
+
+        portDISABLE_INTERRUPTS();
+        for (size_t i = 0; i < window; ++i) {
+            while ((int32_t)(ESP.getCycleCount() - next) < 0) {}
+            next += period;
+
+            ring[head] = readSample();
+            if (++head == capacity) head = 0;
+        }
+        portENABLE_INTERRUPTS();
+
+        // Summed per window, one delta would wrap after ~17 s at 240 MHz
+        uint32_t now = ESP.getCycleCount();
+        elapsed += now - windowEnd;
+        windowEnd = now;
+
+        done += window;
+    }
+
+    effectiveRate = elapsed ? (uint32_t)((uint64_t)done * cpuHz / elapsed) : sampleRate;
+
+    count = std::min(capacity, count + done);
+    unlockCapture();
+    return done;
+}
+
+bool LogicAnalyzerService::waitForTrigger(uint8_t triggerMask, uint8_t value, const std::function<bool()>& shouldAbort) {
+    if (pins.empty()) return false;
+
+    while (true) {
+        for (uint16_t i = 0; i < 4096; ++i) {
+            if ((readSample() & triggerMask) == value) return true;
+        }
+        if (shouldAbort && shouldAbort()) return false;
+    }
+}
+
+bool LogicAnalyzerService::captureTriggered(CaptureTrigger& trigger, size_t pre, size_t post, const std::function<bool()>& shouldAbort) {
+    if (!ring || pins.empty()) return false;
+
+    pre = std::min(pre, capacity - 1);
+    post = std::min(post, capacity - 1 - pre);
+    lockCapture();
+    resetCapture();
+    trigger.reset();
+
+    const uint32_t cpuHz = getCpuFrequencyMhz() * 1000000UL;
+    const uint32_t period = cpuHz / sampleRate;
+    const size_t windowSamples = std::max<size_t>(1, (uint64_t)sampleRate * MASKED_WINDOW_US / 1000000ULL);
+
+    size_t armed = 0;      // samples behind the current one, up to pre
+    size_t remaining = 0;  // post trigger samples still to take
+    bool fired = false;
+    bool done = false;
+    uint32_t next = ESP.getCycleCount();
+
+    // Nothing but sampling and the trigger check runs until the capture is frozen
+    while (!done) {
+        portDISABLE_INTERRUPTS();
+        for (size_t i = 0; i < windowSamples; ++i) {
+            while ((int32_t)(ESP.getCycleCount() - next) < 0) {}
+            next += period;
+
+            uint8_t sample = readSample();
+            ring[head] = sample;
+            if (++head == capacity) head = 0;
+
+            if (fired) {
+                if (--remaining == 0) { done = true; break; }
+            } else {
+                bool matched = trigger.feed(sample);
+                if (matched && armed >= pre) {
+                    fired = true;
+                    remaining = post;
+                    if (remaining == 0) { done = true; break; }
+                } else if (armed < pre) {
+                    armed++;
+                }
+            }
+        }
+        portENABLE_INTERRUPTS();
+
+        if (!fired && shouldAbort && shouldAbort()) {
+            unlockCapture();
+            return false;
+        }
+    }
+
+    count = pre + 1 + post;
+    triggerIndex = pre;
+    unlockCapture();
+    return true;
+}
+
+size_t LogicAnalyzerService::captureStream(size_t total, const std::function<bool(const uint8_t*, size_t)>& consumer,
+                                           const std::function<bool()>& shouldAbort) {
+    if (!ring || pins.empty() || total == 0) return 0;
+
+    lockCapture();
+    resetCapture();
+    overrun = false;
+    produced = 0;
+    consumed = 0;
+    producerDone = false;
+    consumerFailed = false;
+    streamConsumer = &consumer;
+    if (!streamDone) streamDone = xSemaphoreCreateBinary();
+    if (!streamDone) {
+        unlockCapture();
+        return 0;
+    }
+
+    // The consumer (encoding, SD, LittleFS, socket) runs on the other core
+    TaskHandle_t task = nullptr;
+    BaseType_t otherCore = xPortGetCoreID() ^ 1;
+    if (xTaskCreatePinnedToCore(streamTask, "logicStream", 6144, this, 1, &task, otherCore) != pdPASS) {
+        unlockCapture();
+        return 0;
+    }
+
+    const uint32_t cpuHz = getCpuFrequencyMhz() * 1000000UL;
+    const uint32_t period = cpuHz / sampleRate;
+    // Windows small enough to leave the consumer part of the ring to work on
+    const size_t windowSamples = std::max<size_t>(1, std::min<size_t>(capacity / 4,
+                                 (uint64_t)sampleRate * MASKED_WINDOW_US / 1000000ULL));
+
+    uint32_t start = ESP.getCycleCount();
+    uint32_t windowEnd = start;
+    uint64_t elapsed = 0;
+    uint32_t next = start;
+    size_t done = 0;
+
+    while (done < total && !consumerFailed) {
+        size_t window = std::min(total - done, windowSamples);
+
+        // A window never overwrites what the consumer has not taken yet
+        if (capacity - (done - consumed.load()) < window) {
+            overrun = true;
+            break;
+        }
+
+        portDISABLE_INTERRUPTS();
+        for (size_t i = 0; i < window; ++i) {
+            while ((int32_t)(ESP.getCycleCount() - next) < 0) {}
+            next += period;
+
+            ring[head] = readSample();
+            if (++head == capacity) head = 0;
+        }
+        portENABLE_INTERRUPTS();
+
+        // Summed per window, one delta would wrap after ~17 s at 240 MHz
+        uint32_t now = ESP.getCycleCount();
+        elapsed += now - windowEnd;
+        windowEnd = now;
+
+        done += window;
+        produced = done;
+
+        if (shouldAbort && shouldAbort()) break;
+    }
+
+    effectiveRate = elapsed ? (uint32_t)((uint64_t)done * cpuHz / elapsed) : sampleRate;
+
+    // Let the consumer drain what is left, it gives the semaphore before deleting itself
+    producerDone = true;
+    xSemaphoreTake(streamDone, portMAX_DELAY);
+    streamConsumer = nullptr;
+
+    // The tail of the stream stays in the ring for the screen and downloads
+    count = std::min(capacity, done);
+    unlockCapture();
+    return consumerFailed ? consumed.load() : done;
+}
+
+void LogicAnalyzerService::streamTask(void* param) {
+    auto* self = static_cast<LogicAnalyzerService*>(param);
+
+    while (true) {
+        size_t available = self->produced.load();
+        size_t taken = self->consumed.load();
+
+        if (available == taken) {
+            if (self->producerDone) break;
+            vTaskDelay(1);
+            continue;
+        }
+
+        // Contiguous part of the ring, the wrapped part comes on the next turn
+        size_t pos = taken % self->capacity;
+        size_t length = std::min(available - taken, self->capacity - pos);
+        if (!(*self->streamConsumer)(self->ring + pos, length)) {
+            self->consumerFailed = true;
+            break;
+        }
+        self->consumed = taken + length;
+    }
+
+    xSemaphoreGive(self->streamDone);
+    vTaskDelete(nullptr);
+}
+
+bool LogicAnalyzerService::hasOverrun() const {
+    return overrun;
+}
+
+size_t LogicAnalyzerService::captureRle(size_t samples, const std::function<bool()>& shouldAbort) {
+    if (!ring || pins.empty() || samples == 0) return 0;
+
+    // The raw samples are gone once the ring holds runs
+    lockCapture();
+    resetCapture();
+    rle.attach(ring, capacity);
+
+    const uint32_t cpuHz = getCpuFrequencyMhz() * 1000000UL;
+    const uint32_t period = cpuHz / sampleRate;
+    const size_t windowSamples = std::max<size_t>(1, (uint64_t)sampleRate * MASKED_WINDOW_US / 1000000ULL);
+
+    uint32_t start = ESP.getCycleCount();
+    uint32_t windowEnd = start;
+    uint64_t elapsed = 0;
+    uint32_t next = start;
+    uint16_t last = 0x100; // never a sample, the first one opens a run
+    size_t done = 0;
+    bool full = false;
+
+    while (done < samples && !full) {
+        size_t window = std::min(samples - done, windowSamples);
+        size_t i = 0;
+
+        portDISABLE_INTERRUPTS();
+        for (; i < window; ++i) {
+            while ((int32_t)(ESP.getCycleCount() - next) < 0) {}
+            next += period;
+
+            uint8_t sample = readSample();
+            if (sample != last) {
+                if (!rle.push(done + i, sample)) { full = true; break; }
+                last = sample;
+            }
+        }
+        portENABLE_INTERRUPTS();
+
+        // Summed per window, one delta would wrap after ~17 s at 240 MHz
+        uint32_t now = ESP.getCycleCount();
+        elapsed += now - windowEnd;
+        windowEnd = now;
+
+        done += i;
+        if (shouldAbort && shouldAbort()) break;
+    }
+
+    effectiveRate = elapsed ? (uint32_t)((uint64_t)done * cpuHz / elapsed) : sampleRate;
+
+    rle.close(done);
+    unlockCapture();
+    return done;
+}
+
+const RleCaptureStore& LogicAnalyzerService::getRleStore() const {
+    return rle;
+}
+
+bool LogicAnalyzerService::readRuns(const std::function<bool(uint8_t, size_t)>& consumer) const {
+    if (rle.getSampleCount()) {
+        for (size_t run = 0; run < rle.getRunCount(); ++run) {
+            if (!consumer(rle.getRunValue(run), rle.getRunLength(run))) return false;
+        }
+        return true;
+    }
+
+    if (count == 0) return true;
+
+    // Raw ring, equal samples are merged on the fly
+    size_t pos = (head + capacity - count) % capacity;
+    uint8_t value = ring[pos];
+    size_t length = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint8_t sample = ring[pos];
+        if (++pos == capacity) pos = 0;
+        if (sample != value) {
+            if (!consumer(value, length)) return false;
+            value = sample;
+            length = 0;
+        }
+        length++;
+    }
+    return consumer(value, length);
+}
+
+bool LogicAnalyzerService::hasCapture() const {
+    return count > 0 || rle.getSampleCount() > 0;
+}
+
+bool LogicAnalyzerService::tryLockCapture(uint32_t timeoutMs) {
+    return captureMutex && xSemaphoreTake(captureMutex, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
+
+void LogicAnalyzerService::lockCapture() {
+    xSemaphoreTake(captureMutex, portMAX_DELAY);
+    capturePins = pins;
+    effectiveRate = sampleRate;
+}
+
+void LogicAnalyzerService::unlockCapture() {
+    xSemaphoreGive(captureMutex);
+}
+
+size_t LogicAnalyzerService::getTriggerIndex() const {
+    return triggerIndex;
+}
+
+void LogicAnalyzerService::clear() {
+    xSemaphoreTake(captureMutex, portMAX_DELAY);
+    resetCapture();
+    xSemaphoreGive(captureMutex);
+}
+
+void LogicAnalyzerService::resetCapture() {
+    head = 0;
+    count = 0;
+    triggerIndex = 0;
+    rle.clear();
+}
+
+uint8_t LogicAnalyzerService::sampleAt(size_t index) const {
+    if (index >= count) return 0;
+    size_t oldest = (head + capacity - count) % capacity;
+    size_t pos = oldest + index;
+    if (pos >= capacity) pos -= capacity;
+    return ring[pos];
+}
+
+void LogicAnalyzerService::decimate(uint8_t channel, size_t start, size_t length, size_t width, std::vector<uint8_t>& out) const {
+    out.clear();
+    if (width == 0 || channel >= pins.size() || start >= count) return;
+
+    length = std::min(length, count - start);
+    size_t perColumn = std::max<size_t>(1, length / width);
+    size_t columns = std::min(width, length / perColumn);
+    out.reserve(columns);
+
+    uint8_t previous = (sampleAt(start) >> channel) & 1;
+    for (size_t col = 0; col < columns; ++col) {
+        size_t from = start + col * perColumn;
+        uint8_t first = (sampleAt(from) >> channel) & 1;
+        bool edge = first != previous;
+        uint8_t last = first;
+
+        for (size_t i = 1; i < perColumn; ++i) {
+            last = (sampleAt(from + i) >> channel) & 1;
+            if (last != first) edge = true;
+        }
+
+        // Keep short pulses visible when several samples share a pixel
+        uint8_t value = (edge && last == previous) ? !previous : last;
+        out.push_back(value);
+        previous = value;
+    }
+}
+
+size_t LogicAnalyzerService::getSampleCount() const {
+    return count;
+}
+
+size_t LogicAnalyzerService::getCapacity() const {
+    return capacity;
+}
+
+const std::vector<uint8_t>& LogicAnalyzerService::getPins() const {
+    return pins;
+}
+
+const std::vector<uint8_t>& LogicAnalyzerService::getCapturePins() const {
+    return capturePins;
+}
+
+uint32_t LogicAnalyzerService::getSampleRate() const {
+    return sampleRate;
+}
+
+uint32_t LogicAnalyzerService::getEffectiveSampleRate() const {
+    return effectiveRate;
+}
+
+uint32_t LogicAnalyzerService::getMaxSampleRate() {
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        return 5000000;
+    #else
+        return 2000000;
+    #endif
+}
+
+bool LogicAnalyzerService::isConfigured() const {
+    return !pins.empty();
+}
+
+bool LogicAnalyzerService::isInPsram() const {
+    return inPsram;
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <Arduino.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include "soc/soc_caps.h"
+#include "Models/CaptureTrigger.h"
+#include "Models/RleCaptureStore.h"
+
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    #include "driver/dedic_gpio.h"
+#endif
+
+/*
+Parallel capture of up to 8 GPIOs at a fixed sample rate.
+One sample is one byte, bit N is the level of channel N.
+Samples are stored in a ring (PSRAM when available), oldest first.
+*/
+class LogicAnalyzerService {
+public:
+    static constexpr uint8_t MAX_CHANNELS = 8;
+
+    ~LogicAnalyzerService();
+
+    // Claim the pins and allocate the ring, false if a pin or the memory is not available
+    bool configure(const std::vector<uint8_t>& pins, uint32_t sampleRate);
+    void setSampleRate(uint32_t sampleRate);
+    void end();
+
+    // Sample `count` times at the configured rate, appended to the ring
+    size_t capture(size_t count);
+    void clear();
+
+    // Poll the channels until (sample & mask) == value, false when aborted
+    bool waitForTrigger(uint8_t mask, uint8_t value, const std::function<bool()>& shouldAbort);
+
+    // Sample at full rate until the trigger fires with `pre` samples behind it,
+    // then take `post` more and freeze. The ring then holds pre + 1 + post samples.
+    bool captureTriggered(CaptureTrigger& trigger, size_t pre, size_t post, const std::function<bool()>& shouldAbort);
+    size_t getTriggerIndex() const;
+
+    // Sample `total` times while `consumer` drains the ring from a task on the other core,
+    // so the depth is bounded by the consumer throughput instead of the ring.
+    // Stops early when the consumer falls a ring behind, fails or on abort.
+    size_t captureStream(size_t total, const std::function<bool(const uint8_t*, size_t)>& consumer,
+                         const std::function<bool()>& shouldAbort);
+    bool hasOverrun() const;
+
+    // Sample `count` times keeping only the transitions, in the ring memory.
+    // Seconds of mostly idle bus fit where the raw ring holds a fraction of one.
+    // Stops early when the store is full, returns the samples covered.
+    size_t captureRle(size_t count, const std::function<bool()>& shouldAbort);
+    const RleCaptureStore& getRleStore() const;
+
+    // Hand the last capture to `consumer` as (value, length) runs, raw or run-length
+    bool readRuns(const std::function<bool(uint8_t, size_t)>& consumer) const;
+    bool hasCapture() const;
+
+    // Readers from other tasks hold the lock while they read the capture,
+    // a capture started meanwhile waits for it
+    bool tryLockCapture(uint32_t timeoutMs);
+    void unlockCapture();
+
+    // Indexed from the oldest sample still in the ring
+    uint8_t sampleAt(size_t index) const;
+    size_t getSampleCount() const;
+    size_t getCapacity() const;
+
+    // One value per column, a column with an edge inside is drawn as a toggle
+    void decimate(uint8_t channel, size_t start, size_t count, size_t width, std::vector<uint8_t>& out) const;
+
+    const std::vector<uint8_t>& getPins() const;
+    const std::vector<uint8_t>& getCapturePins() const; // channels of the last capture, kept after end()
+    uint32_t getSampleRate() const;
+    uint32_t getEffectiveSampleRate() const;
+    static uint32_t getMaxSampleRate();
+    bool isConfigured() const;
+    bool isInPsram() const;
+
+private:
+    uint8_t readSample() const;
+    bool allocate();
+    void lockCapture();
+    void resetCapture();
+    static void streamTask(void* param);
+
+    // Interrupts are masked by windows, short enough for the interrupt watchdog
+    static constexpr uint32_t MASKED_WINDOW_US = 50000;
+    static constexpr size_t PSRAM_CAPACITY = 1024 * 1024;
+    static constexpr size_t INTERNAL_CAPACITY = 32 * 1024;
+
+    std::vector<uint8_t> pins;
+    std::vector<uint8_t> capturePins;
+    uint32_t sampleRate = 0;
+    uint32_t effectiveRate = 0; // of the last capture
+
+    uint8_t* ring = nullptr;
+    size_t capacity = 0;
+    size_t head = 0;  // next write position
+    size_t count = 0;
+    size_t triggerIndex = 0;
+    bool inPsram = false;
+    SemaphoreHandle_t captureMutex = xSemaphoreCreateMutex(); // held while the ring is written
+    RleCaptureStore rle; // shares the ring memory, valid after captureRle only
+
+    // Streaming, the sampler publishes `produced`, the consumer task `consumed`
+    std::atomic<size_t> produced{0};
+    std::atomic<size_t> consumed{0};
+    std::atomic<bool> producerDone{false};
+    std::atomic<bool> consumerFailed{false};
+    const std::function<bool(const uint8_t*, size_t)>* streamConsumer = nullptr;
+    SemaphoreHandle_t streamDone = nullptr; // given by the consumer task before it ends
+    bool overrun = false;
+
+    // Fast path, channels are consecutive GPIOs of the low bank
+    bool contiguous = false;
+    uint8_t firstPin = 0;
+    uint8_t mask = 0;
+    bool needHighBank = false;
+
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        dedic_gpio_bundle_handle_t bundle = nullptr;
+        uint32_t bundleOffset = 0;
+    #endif
+};
@@ -29,6 +29,10 @@ uint8_t SpiService::transfer(uint8_t data) {
     return SPI.transfer(data);
 }
 
+void SpiService::transferBytes(const uint8_t* tx, uint8_t* rx, size_t length) {
+    SPI.transferBytes(tx, rx, length); // tx nullptr clocks 0xFF
+}
+
 std::string SpiService::readFlashID() {
     uint8_t id[3] = {0};
 
@@ -62,18 +66,104 @@ uint32_t SpiService::calculateFlashCapacity(uint8_t code) {
 }
 
 void SpiService::readFlashData(uint32_t address, uint8_t* buffer, size_t length) {
+    readFlashWithOpcode(0x03, 0, address, buffer, length); // Read Data
+}
+
+void SpiService::readFlashFast(uint32_t address, uint8_t* buffer, size_t length) {
+    readFlashWithOpcode(0x0B, 1, address, buffer, length); // Fast Read, 8 dummy clocks
+}
+
+void SpiService::readFlashBulk(uint32_t address, uint8_t* buffer, size_t length) {
+    if (flashReadMode == FlashReadModeEnum::Fast) {
+        readFlashFast(address, buffer, length);
+    } else {
+        readFlashData(address, buffer, length);
+    }
+}
+
+void SpiService::readFlashWithOpcode(uint8_t opcode, uint8_t dummyBytes, uint32_t address, uint8_t* buffer, size_t length) {
+    uint8_t header[5] = {
+        opcode,
+        static_cast<uint8_t>((address >> 16) & 0xFF),
+        static_cast<uint8_t>((address >> 8) & 0xFF),
+        static_cast<uint8_t>(address & 0xFF),
+        0x00 // dummy
+    };
+
     beginTransaction();
-    SPI.transfer(0x03);  // Read Data command
-    SPI.transfer((address >> 16) & 0xFF);
-    SPI.transfer((address >> 8) & 0xFF);
-    SPI.transfer(address & 0xFF);
+    SPI.writeBytes(header, 4 + dummyBytes);
 
-    for (size_t i = 0; i < length; ++i) {
-        buffer[i] = SPI.transfer(0x00);
+    // The flash auto increments the address, so the whole range is clocked
+    // under a single CS, in chunks the SPI driver pushes through its FIFO
+    const size_t chunkSize = 4096;
+    size_t offset = 0;
+    while (offset < length) {
+        size_t n = std::min(chunkSize, length - offset);
+        SPI.transferBytes(nullptr, buffer + offset, n); // MOSI held high
+        offset += n;
     }
     endTransaction();
 }
 
+bool SpiService::readFlashSfdp(FlashSfdpInfo& info) {
+    info = FlashSfdpInfo();
+
+    auto readSfdp = [&](uint32_t address, uint8_t* buffer, size_t length) {
+        readFlashWithOpcode(0x5A, 1, address, buffer, length); // Read SFDP
+    };
+
+    // SFDP header + first parameter header (JESD216)
+    uint8_t header[16] = {0};
+    readSfdp(0x000000, header, sizeof(header));
+    if (header[0] != 'S' || header[1] != 'F' || header[2] != 'D' || header[3] != 'P') {
+        return false;
+    }
+
+    info.valid = true;
+    info.minor = header[4];
+    info.major = header[5];
+
+    // Basic Flash Parameter Table pointer, DWORD 1 holds the fast read support bits
+    uint32_t tablePtr = header[12] | (header[13] << 8) | (header[14] << 16);
+    uint8_t dword1[4] = {0};
+    readSfdp(tablePtr, dword1, sizeof(dword1));
+    uint32_t caps = dword1[0] | (dword1[1] << 8) | (dword1[2] << 16) | (dword1[3] << 24);
+
+    info.dualOutput = caps & (1UL << 16);
+    info.dualIo     = caps & (1UL << 20);
+    info.quadIo     = caps & (1UL << 21);
+    info.quadOutput = caps & (1UL << 22);
+    return true;
+}
+
+FlashReadModeEnum SpiService::detectFlashReadMode() {
+    // SFDP capable chips always implement Fast Read
+    FlashSfdpInfo sfdp;
+    if (readFlashSfdp(sfdp)) {
+        flashReadMode = FlashReadModeEnum::Fast;
+        return flashReadMode;
+    }
+
+    // Older chips, check that 0x0B returns the same data as 0x03
+    uint8_t standard[32];
+    uint8_t fast[32];
+    readFlashData(0, standard, sizeof(standard));
+    readFlashFast(0, fast, sizeof(fast));
+
+    flashReadMode = memcmp(standard, fast, sizeof(standard)) == 0
+                        ? FlashReadModeEnum::Fast
+                        : FlashReadModeEnum::Standard;
+    return flashReadMode;
+}
+
+void SpiService::setFlashReadMode(FlashReadModeEnum mode) {
+    flashReadMode = mode;
+}
+
+FlashReadModeEnum SpiService::getFlashReadMode() const {
+    return flashReadMode;
+}
+
 void SpiService::eraseFlashSector(uint32_t address, uint32_t freq) {
     enableFlashWrite(freq);  // 0x06
 
@@ -155,7 +245,7 @@ void SpiService::writeFlashPatch(uint32_t address, const std::vector<uint8_t>& d
 
     // Read the concerned sector
     std::vector<uint8_t> sectorData(sectorSize, 0xFF);
-    readFlashData(sectorStart, sectorData.data(), sectorSize);
+    readFlashBulk(sectorStart, sectorData.data(), sectorSize);
 
     // Modify data
     for (size_t i = 0; i < data.size(); ++i) {
@@ -175,12 +265,51 @@ void SpiService::writeFlashPatch(uint32_t address, const std::vector<uint8_t>& d
 }
 
 std::string SpiService::executeByteCode(const std::vector<ByteCode>& bytecodes) {
-    std::string result;
+    // Consecutive Write/Read codes are coalesced into one full duplex buffer,
+    // clocked with a single transferBytes() at the next boundary
+    static constexpr size_t maxBatchSize = 4096;
+    std::vector<uint8_t> tx;
+    std::vector<uint8_t> rx;
+    std::vector<std::pair<size_t, size_t>> readSpans; // offset, length in tx
+    std::vector<uint8_t> readBytes;
     bool inTransaction = false;
+    uint32_t startUs = micros();
+
+    tx.reserve(64);
+    lastByteCodeBytes = 0;
+
+    auto flush = [&]() {
+        if (tx.empty()) return;
+        rx.resize(tx.size());
+        SPI.transferBytes(tx.data(), rx.data(), tx.size());
+        for (const auto& span : readSpans) {
+            readBytes.insert(readBytes.end(), rx.begin() + span.first, rx.begin() + span.first + span.second);
+        }
+        lastByteCodeBytes += tx.size();
+        tx.clear();
+        readSpans.clear();
+    };
+
+    auto append = [&](uint8_t value, uint32_t count, bool isRead) {
+        while (count > 0) {
+            size_t n = std::min<size_t>(count, maxBatchSize - tx.size());
+            if (isRead) {
+                if (!readSpans.empty() && readSpans.back().first + readSpans.back().second == tx.size()) {
+                    readSpans.back().second += n;
+                } else {
+                    readSpans.emplace_back(tx.size(), n);
+                }
+            }
+            tx.insert(tx.end(), n, value);
+            count -= n;
+            if (tx.size() >= maxBatchSize) flush();
+        }
+    };
 
     for (const auto& code : bytecodes) {
         switch (code.getCommand()) {
             case ByteCodeEnum::Start:
+                flush();
                 if (!inTransaction) {
                     beginTransaction();
                     inTransaction = true;
@@ -188,6 +317,7 @@ std::string SpiService::executeByteCode(const std::vector<ByteCode>& bytecodes)
                 break;
 
             case ByteCodeEnum::Stop:
+                flush();
                 if (inTransaction) {
                     endTransaction();
                     inTransaction = false;
@@ -195,25 +325,20 @@ std::string SpiService::executeByteCode(const std::vector<ByteCode>& bytecodes)
                 break;
 
             case ByteCodeEnum::Write:
-                for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                    transfer(code.getData());
-                }
+                append(static_cast<uint8_t>(code.getData()), code.getRepeat(), false);
                 break;
 
             case ByteCodeEnum::Read:
-                for (uint32_t i = 0; i < code.getRepeat(); ++i) {
-                    uint8_t val = transfer(0x00);  // dummy byte
-                    char hex[5];
-                    snprintf(hex, sizeof(hex), "%02X ", val);
-                    result += hex;
-                }
+                append(0x00, code.getRepeat(), true);  // dummy bytes
                 break;
 
             case ByteCodeEnum::DelayMs:
+                flush();
                 delay(code.getRepeat());
                 break;
 
             case ByteCodeEnum::DelayUs:
+                flush();
                 delayMicroseconds(code.getRepeat());
                 break;
 
@@ -221,15 +346,37 @@ std::string SpiService::executeByteCode(const std::vector<ByteCode>& bytecodes)
                 break;
         }
     }
+    flush();
 
     // Close transaction if left open
     if (inTransaction) {
         endTransaction();
     }
 
+    lastByteCodeUs = micros() - startUs;
+
+    // Hex format once, at the end
+    static const char hexChars[] = "0123456789ABCDEF";
+    std::string result;
+    result.reserve(readBytes.size() * 3);
+    for (uint8_t val : readBytes) {
+        result += hexChars[val >> 4];
+        result += hexChars[val & 0x0F];
+        result += ' ';
+    }
+
     return result;
 }
 
+uint32_t SpiService::getLastByteCodeBytes() const {
+    return lastByteCodeBytes;
+}
+
+uint32_t SpiService::getLastByteCodeBytesPerSecond() const {
+    if (lastByteCodeUs == 0) return 0;
+    return (uint64_t)lastByteCodeBytes * 1000000ULL / lastByteCodeUs;
+}
+
 // #### SPI SLAVE ######
 
 static ESP32SPISlave spiSlave;
@@ -9,6 +9,17 @@
 #include <SPI.h>
 #include <Data/FlashDatabase.h>
 #include <Models/ByteCode.h>
+#include <Enums/FlashReadModeEnum.h>
+
+struct FlashSfdpInfo {
+    bool valid = false;
+    uint8_t major = 0;
+    uint8_t minor = 0;
+    bool dualOutput = false; // 1-1-2, 0x3B
+    bool dualIo = false;     // 1-2-2, 0xBB
+    bool quadOutput = false; // 1-1-4, 0x6B
+    bool quadIo = false;     // 1-4-4, 0xEB
+};
 
 class SpiService {
 public:
@@ -18,11 +29,18 @@ public:
     void beginTransaction();
     void endTransaction();
     uint8_t transfer(uint8_t data);
+    void transferBytes(const uint8_t* tx, uint8_t* rx, size_t length);
 
     // Flash
     std::string readFlashID();
     void readFlashIdRaw(uint8_t* buffer);
     void readFlashData(uint32_t address, uint8_t* buffer, size_t length);
+    void readFlashFast(uint32_t address, uint8_t* buffer, size_t length);
+    void readFlashBulk(uint32_t address, uint8_t* buffer, size_t length);
+    bool readFlashSfdp(FlashSfdpInfo& info);
+    FlashReadModeEnum detectFlashReadMode();
+    void setFlashReadMode(FlashReadModeEnum mode);
+    FlashReadModeEnum getFlashReadMode() const;
     uint32_t calculateFlashCapacity(uint8_t code);
     void eraseFlashSector(uint32_t address, uint32_t freq);
     void enableFlashWrite(uint32_t freq);
@@ -56,9 +74,15 @@ public:
 
     // Instructions
     std::string executeByteCode(const std::vector<ByteCode>& bytecodes);
+    uint32_t getLastByteCodeBytes() const;
+    uint32_t getLastByteCodeBytesPerSecond() const;
 private:
     uint8_t csPin;
     uint32_t spiFrequency = 1000000;
+    FlashReadModeEnum flashReadMode = FlashReadModeEnum::Standard;
+    uint32_t lastByteCodeBytes = 0;
+    uint32_t lastByteCodeUs = 0;
+    void readFlashWithOpcode(uint8_t opcode, uint8_t dummyBytes, uint32_t address, uint8_t* buffer, size_t length);
     EEPROM_SPI_WE eeprom = EEPROM_SPI_WE(&SPI, SPI_CS_PIN, 999, 8000000);
     bool eepromInitialized = false;
     uint32_t eepromFrequency = 8000000;
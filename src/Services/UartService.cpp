@@ -71,6 +71,24 @@ void UartService::write(const std::string& str) {
     Serial1.write(reinterpret_cast<const uint8_t*>(str.c_str()), str.length());
 }
 
+void UartService::write(const uint8_t* data, size_t length) {
+    Serial1.write(data, length);
+}
+
+size_t UartService::readBytes(uint8_t* buffer, size_t length, uint32_t timeoutMs) {
+    size_t received = 0;
+    uint32_t start = millis();
+    while (received < length && (millis() - start) < timeoutMs) {
+        int available = Serial1.available();
+        if (available > 0) {
+            received += Serial1.read(buffer + received, std::min<size_t>(available, length - received));
+        } else {
+            delay(1);
+        }
+    }
+    return received;
+}
+
 std::string UartService::executeByteCode(const std::vector<ByteCode>& bytecodes) {
     std::string result;
     uint32_t timeout = 2000; // 2 secondes
@@ -292,146 +310,76 @@ bool UartService::xmodemReceiveToFile(File& file) {
     return ok;
 }
 
-void IRAM_ATTR UartService::onGpioEdge(void* arg) {
-    uint32_t pin = (uint32_t)arg;
-
-    uint32_t now = micros();
-    if (lastEdgeTimeUs != 0 && intervalCount < 64) {
-        edgeIntervals[intervalCount++] = now - lastEdgeTimeUs;
-    }
-    lastEdgeTimeUs = now;
-
-    if (pin < 50) {
-        edgeCounts[pin]++;
+/*
+IDF driver
+*/
+bool UartService::beginDriver(unsigned long baud, uint32_t config, uint8_t rx, uint8_t tx, bool inverted) {
+    Serial1.end();
+    endDriver();
+
+    // The Arduino config word has the UART_CONF0 layout
+    uart_config_t uartConfig = {};
+    uartConfig.baud_rate = baud;
+    uartConfig.data_bits = (uart_word_length_t)((config >> 2) & 0x3);
+    uartConfig.parity = (uart_parity_t)(config & 0x3);
+    uartConfig.stop_bits = (uart_stop_bits_t)((config >> 4) & 0x3);
+    uartConfig.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    uartConfig.source_clk = UART_SCLK_APB;
+
+    if (uart_driver_install(UART_PORT, DRIVER_RX_BUFFER, DRIVER_TX_BUFFER, DRIVER_QUEUE_SIZE, &eventQueue, 0) != ESP_OK) {
+        eventQueue = nullptr;
+        return false;
     }
-}
-
-UartService::PinActivity UartService::measureUartActivity(uint8_t pin, uint32_t windowMs, bool pullup) {
-    edgeCounts[pin] = 0;
-    lastEdgeTimeUs = 0;
-    intervalCount = 0;
-
-    // Configure GPIO
-    gpio_config_t io = {};
-    io.intr_type = GPIO_INTR_ANYEDGE;
-    io.mode = GPIO_MODE_INPUT;
-    io.pin_bit_mask = (1ULL << pin);
-    io.pull_down_en = GPIO_PULLDOWN_DISABLE;
-    io.pull_up_en = pullup ? GPIO_PULLUP_ENABLE : GPIO_PULLUP_DISABLE;
-    gpio_config(&io);
+    driverRunning = true;
 
-    // Attach ISR and measure
-    gpio_isr_handler_add((gpio_num_t)pin, &UartService::onGpioEdge, (void*)pin);
-    uint32_t start = millis();
-    while ((millis() - start) < windowMs) {
-        delay(1);
-    }
-    gpio_isr_handler_remove((gpio_num_t)pin);
-
-    // Calculate edges per second
-    uint32_t edges = edgeCounts[pin];
-    float eps = (windowMs > 0) ? (edges * 1000.0f / windowMs) : 0.0f;
-
-    // Baud estimating
-    uint32_t approxBaud = 0;
-    if (intervalCount > 8) {
-        std::vector<uint32_t> tmp(edgeIntervals, edgeIntervals + intervalCount);
-        std::sort(tmp.begin(), tmp.end());
-        uint32_t med = tmp[tmp.size() / 2];   // microseconds
-
-        if (med > 0) {
-            approxBaud = 1000000UL / med;
-
-            if (approxBaud < 1200 || approxBaud > 1000000) {
-                approxBaud = 0;
-            } else {
-                approxBaud = (approxBaud / 100) * 100;
-            }
-        }
+    if (uart_param_config(UART_PORT, &uartConfig) != ESP_OK ||
+        uart_set_pin(UART_PORT, tx, rx, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) {
+        endDriver();
+        return false;
     }
+    uart_set_line_inverse(UART_PORT, inverted ? (UART_SIGNAL_RXD_INV | UART_SIGNAL_TXD_INV) : UART_SIGNAL_INV_DISABLE);
 
-    return { pin, edges, eps, approxBaud };
+    // Half the hardware FIFO, leaves room while the interrupt is delayed
+    uart_set_rx_full_threshold(UART_PORT, 64);
+    return true;
 }
 
-std::vector<UartService::PinActivity> UartService::scanUartActivity(const std::vector<uint8_t>& pins,
-                                                                    uint32_t windowMs,
-                                                                    uint32_t minEdges,
-                                                                    bool pullup) {
-    std::vector<PinActivity> out;
-    out.reserve(pins.size());
-
-    for (auto pin : pins) {
-        auto r = measureUartActivity(pin, windowMs, pullup);
-        if (r.edges >= minEdges) {
-            out.push_back(r);
-        }
-    }
-
-    std::sort(out.begin(), out.end(), [](const PinActivity& a, const PinActivity& b) {
-        return a.edges > b.edges;
-    });
-
-    return out;
+void UartService::endDriver() {
+    if (!driverRunning) return;
+    uart_driver_delete(UART_PORT);
+    eventQueue = nullptr;
+    driverRunning = false;
 }
 
-uint32_t UartService::detectBaudByEdge(
-    uint8_t pin,
-    uint32_t totalMs,
-    uint32_t windowMs,
-    uint32_t minEdges,
-    bool pullup
-) {
-    std::map<uint32_t, uint32_t> votes;
-    uint32_t bestBaud = 0;
-    uint32_t bestVotes = 0;
-
-    uint32_t consecutiveBaud = 0;
-    uint32_t consecutiveCount = 0;
-
-    unsigned long start = millis();
-
-    while (millis() - start < totalMs) {
-        auto a = measureUartActivity(pin, windowMs, pullup);
-
-        // not enough edges or no valid baud
-        if (a.edges < minEdges || a.approxBaud == 0) {
-            consecutiveBaud = 0;
-            consecutiveCount = 0;
-            continue;
-        }
-
-        // to closest standard baudrate
-        uint32_t approx = a.approxBaud;
-        uint32_t snapped = kBaudRates[0];
-        uint32_t bestDiff = (approx > snapped) ? (approx - snapped) : (snapped - approx);
-
-        for (size_t i = 1; i < kBaudRatesCount; i++) {
-            uint32_t b = kBaudRates[i];
-            uint32_t diff = (approx > b) ? (approx - b) : (b - approx);
-            if (diff < bestDiff) {
-                bestDiff = diff;
-                snapped = b;
-            }
-        }
+bool UartService::waitEvent(uart_event_t& event, uint32_t timeoutMs) {
+    if (!eventQueue) return false;
+    return xQueueReceive(eventQueue, &event, pdMS_TO_TICKS(timeoutMs)) == pdTRUE;
+}
 
-        votes[snapped]++;
+size_t UartService::readBuffered(uint8_t* buffer, size_t length) {
+    size_t buffered = 0;
+    if (!driverRunning || uart_get_buffered_data_len(UART_PORT, &buffered) != ESP_OK || buffered == 0) return 0;
 
-        // track best
-        if (votes[snapped] > bestVotes) {
-            bestVotes = votes[snapped];
-            bestBaud = snapped;
-        }
+    int n = uart_read_bytes(UART_PORT, buffer, std::min(length, buffered), 0);
+    return n > 0 ? n : 0;
+}
 
-        // check for consecutive agreement
-        if (snapped == consecutiveBaud) consecutiveCount++;
-        else {
-            consecutiveBaud = snapped;
-            consecutiveCount = 1;
-        }
+size_t UartService::readTimeout(uint8_t* buffer, size_t length, uint32_t timeoutMs) {
+    // Returns once `length` bytes came or the timeout ran out
+    if (!driverRunning) return 0;
+    int n = uart_read_bytes(UART_PORT, buffer, length, pdMS_TO_TICKS(timeoutMs));
+    return n > 0 ? n : 0;
+}
 
-        if (consecutiveCount >= 2) return consecutiveBaud;
-        if (bestVotes >= 3) return bestBaud;
-    }
+size_t UartService::writeBuffered(const uint8_t* data, size_t length) {
+    if (!driverRunning) return 0;
+    int n = uart_write_bytes(UART_PORT, data, length);
+    return n > 0 ? n : 0;
+}
 
-    return 0;
-}
\ No newline at end of file
+void UartService::resetInput() {
+    // After an overflow the driver waits for the input to be cleared
+    if (!driverRunning) return;
+    uart_flush_input(UART_PORT);
+    xQueueReset(eventQueue);
+}
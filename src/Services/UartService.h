@@ -16,13 +16,6 @@
 
 class UartService {
 public:
-    struct PinActivity {
-        uint8_t pin;
-        uint32_t edges;
-        float edgesPerSec;
-        uint32_t approxBaud;
-    };
-
     void configure(unsigned long baud, uint32_t config, uint8_t rx, uint8_t tx, bool inverted);
     void print(const std::string& msg);
     void println(const std::string& msg);
@@ -31,6 +24,8 @@ public:
     bool available() const;
     void write(char c);
     void write(const std::string& str);
+    void write(const uint8_t* data, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length, uint32_t timeoutMs);
     std::string executeByteCode(const std::vector<ByteCode>& bytecodes);
     void switchBaudrate(unsigned long newBaud);
     void flush();
@@ -49,12 +44,15 @@ public:
     void setXmodemCrc(bool enabled);
     int32_t getXmodemBlockSize() const;
     int8_t getXmodemIdSize() const;
-    PinActivity measureUartActivity(uint8_t pin, uint32_t windowMs = 100, bool pullup = true);
-    std::vector<PinActivity> scanUartActivity(const std::vector<uint8_t>& pins,
-                                              uint32_t windowMs = 100,
-                                              uint32_t minEdges = 10,
-                                              bool pullup = true);
-    uint32_t detectBaudByEdge(uint8_t pin, uint32_t totalMs = 5000, uint32_t windowMs = 300, uint32_t minEdges = 30, bool pullup = true);
+
+    // IDF driver with its event queue, in place of Serial1 while it runs
+    bool beginDriver(unsigned long baud, uint32_t config, uint8_t rx, uint8_t tx, bool inverted);
+    void endDriver();
+    bool waitEvent(uart_event_t& event, uint32_t timeoutMs);
+    size_t readBuffered(uint8_t* buffer, size_t length);
+    size_t readTimeout(uint8_t* buffer, size_t length, uint32_t timeoutMs);
+    size_t writeBuffered(const uint8_t* data, size_t length);
+    void resetInput();
 
 private:
     XModem xmodem;
@@ -63,32 +61,9 @@ private:
     int8_t xmodemIdSize = 1;
     XModem::ProtocolType xmodemProtocol = XModem::ProtocolType::CRC_XMODEM;
 
-    static void IRAM_ATTR onGpioEdge(void* arg);
-    inline static volatile uint32_t edgeCounts[50] = {0};
-    inline static volatile uint32_t lastEdgeTimeUs = 0;
-    inline static volatile uint32_t edgeIntervals[64] = {0};
-    inline static volatile uint8_t intervalCount = 0;
-
-    inline static constexpr uint32_t kBaudRates[] = {
-        // Legacy 
-        110, 300, 600, 1200, 1800, 2000, 2400, 3600, 4800, 7200,
-        9600, 10400, 14400, 16000, 19200,
-
-        // Mid-range
-        28800, 31250, 32000, 33600, 38400,
-        56000, 57600, 64000, 76800,
-
-        // High 
-        100000, 115200, 125000, 128000, 153600,
-        200000, 230400, 250000, 256000, 307200,
-
-        // Very high
-        460800, 500000, 576000, 614400, 750000,
-        921600, 1000000, 1152000, 1228800, 1500000,
-
-        // Extreme
-        2000000, 2500000, 3000000, 3500000, 4000000
-    };
-
-    static constexpr size_t kBaudRatesCount = sizeof(kBaudRates) / sizeof(kBaudRates[0]);
+    static constexpr size_t DRIVER_RX_BUFFER = 16384; // ~170 ms at 921600
+    static constexpr size_t DRIVER_TX_BUFFER = 4096;
+    static constexpr int DRIVER_QUEUE_SIZE = 32;
+    QueueHandle_t eventQueue = nullptr;
+    bool driverRunning = false;
 };
@@ -183,6 +183,14 @@ void GuideShell::cmdInstructionSyntax() {
     terminalView.println("  [\"AT\" d:10 r:255]");
     terminalView.println("    write AT, wait, read reply");
     terminalView.println("");
+
+    terminalView.println("Macros ( ... ), per mode:");
+    terminalView.println("  (1=[0x50 0x01] [0x50 0x02])  save macro 1");
+    terminalView.println("  (1)                  run macro 1");
+    terminalView.println("  (0)                  list macros");
+    terminalView.println("  (1=)                 delete macro 1");
+    terminalView.println("  Stored on LittleFS, ex: /i2c.macro");
+    terminalView.println("");
 }
 
 void GuideShell::cmdPythonAutomation() {
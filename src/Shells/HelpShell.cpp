@@ -101,9 +101,13 @@ void HelpShell::cmdGeneral() {
         "mode [name]          - Set active mode",
         "man                  - Show firmware guide",
         "system               - Show system infos",
-        "logic <pin>          - Logic analyzer",
-        "analogic <pin>       - Analogic plotter",
-        "wizard <pin>         - Pin activity analyzer",
+        "logic <pin> [...]    - Logic analyzer (up to 8 pins)",
+        "logic sump <pins>    - SUMP mode for PulseView",
+        "logic record <pins>  - Record to a VCD file",
+        "analogic <pin> [...] - Analogic plotter (up to 4 pins)",
+        "wizard <pin> [...]   - Pin activity analyzer",
+        "wizard all           - Survey all free pins",
+        "binary               - Binary host protocol",
         "P                    - Enable pull-up",
         "p                    - Disable pull-up",
         "",
@@ -145,6 +149,8 @@ void HelpShell::cmdUart() {
         "spam <text> <ms>     - Write text every ms",
         "xmodem <send> <path> - Send file via XMODEM",
         "xmodem <recv> <path> - Receive file via XMODEM",
+        "ymodem <send> <path> - Send files via YMODEM",
+        "ymodem <recv> [dir]  - Receive files via YMODEM",
         "config               - Configure settings",
         "swap                 - Swap RX and TX pins",
         "['Hello'] [r:64]...  - Instruction syntax"
@@ -165,11 +171,11 @@ void HelpShell::cmdHdUart() {
 void HelpShell::cmdI2c() {
     printHeader("I2C");
     static const char* const lines[] = {
-        "scan                 - Find devices",
+        "scan [fast]          - Find devices",
         "discovery            - Report on devices",
         "ping <addr>          - Check ACK",
         "identify <addr>      - Identify device",
-        "sniff                - View traffic",
+        "sniff [addr]         - View transactions",
         "slave <addr>         - Emulate I2C device",
         "read <addr> [reg]    - Read register",
         "write <a> [r] [val]  - Write register",
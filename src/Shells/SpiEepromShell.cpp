@@ -171,7 +171,7 @@ void SpiEepromShell::cmdDump(bool raw) {
 
         if (raw) {
             // Mode RAW
-            for (uint32_t i = 0; i < lineSize; i++) terminalView.print(buffer[i]);
+            terminalView.writeBytes(buffer, lineSize);
         } else {
             // Mode ASCII 
             std::vector<uint8_t> line(buffer, buffer + lineSize);
@@ -42,6 +42,7 @@ void SpiFlashShell::run() {
             case 6: cmdDump();    break;
             case 7: cmdDump(true); break;
             case 8: cmdErase();   break;
+            case 9: cmdSpeedTest(); break;
             default:
                 terminalView.println("Unknown action.\n");
                 break;
@@ -72,6 +73,19 @@ void SpiFlashShell::cmdProbe() {
         return;
     }
 
+    // Read capabilities
+    FlashSfdpInfo sfdp;
+    if (spiService.readFlashSfdp(sfdp)) {
+        std::string modes = "SFDP " + std::to_string(sfdp.major) + "." + std::to_string(sfdp.minor) + ": Fast";
+        if (sfdp.dualOutput) modes += ", Dual Out";
+        if (sfdp.dualIo)     modes += ", Dual IO";
+        if (sfdp.quadOutput) modes += ", Quad Out";
+        if (sfdp.quadIo)     modes += ", Quad IO";
+        terminalView.println(modes);
+    }
+    auto mode = spiService.detectFlashReadMode();
+    terminalView.println("Read mode: " + FlashReadModeEnumMapper::toString(mode));
+
     const FlashChipInfo* chip = findFlashInfo(id[0], id[1], id[2]);
 
     // Known in database
@@ -120,7 +134,7 @@ void SpiFlashShell::cmdAnalyze() {
         0,
         flashSize,
         [&](uint32_t addr, uint8_t* buf, uint32_t len) {
-            spiService.readFlashData(addr, buf, len);
+            spiService.readFlashBulk(addr, buf, len);
         }
     );
 
@@ -162,8 +176,8 @@ void SpiFlashShell::cmdStrings() {
     terminalView.println("\nSPI Flash: Extracting strings... Press [ENTER] to stop.\n");
 
 
-    const uint32_t blockSize = 512;
-    uint8_t buffer[blockSize];
+    const uint32_t blockSize = 4096;
+    std::vector<uint8_t> buffer(blockSize);
     std::string currentStr;
     uint32_t currentAddr = 0;
     uint32_t stringStartAddr = 0;
@@ -177,7 +191,7 @@ void SpiFlashShell::cmdStrings() {
 
     // Read flash in chuncks
     for (uint32_t addr = 0; addr < flashSize; addr += blockSize) {
-        spiService.readFlashData(addr, buffer, blockSize);
+        spiService.readFlashBulk(addr, buffer.data(), blockSize);
 
         // Read blocks
         for (uint32_t i = 0; i < blockSize; ++i) {
@@ -199,13 +213,13 @@ void SpiFlashShell::cmdStrings() {
                 currentStr.clear();
                 inString = false;
             }
+        }
 
-            // Quit if user presses ENTER
-            char c = terminalInput.readChar();
-            if (c == '\r' || c == '\n') {
-                terminalView.println("\nSPI Flash: Extraction cancelled by user.");
-                return;
-            }
+        // Quit if user presses ENTER
+        char c = terminalInput.readChar();
+        if (c == '\r' || c == '\n') {
+            terminalView.println("\nSPI Flash: Extraction cancelled by user.");
+            return;
         }
     }
 
@@ -234,9 +248,9 @@ void SpiFlashShell::cmdSearch() {
 
     terminalView.println("\nSearching for \"" + pattern + "\" in SPI flash from 0x" + argTransformer.toHex(startAddr, 6) + "... Press [ENTER] to stop.\n");
 
-    const uint32_t blockSize = 512;
+    const uint32_t blockSize = 4096;
     const uint32_t contextSize = 16;  // characters before and after
-    uint8_t buffer[blockSize + 32];
+    std::vector<uint8_t> buffer(blockSize + pattern.size());
 
     // Get flash size
     uint8_t id[3];
@@ -246,7 +260,7 @@ void SpiFlashShell::cmdSearch() {
 
     // Read flash in chunks
     for (uint32_t addr = startAddr; addr < flashSize; addr += blockSize - pattern.size()) {
-        spiService.readFlashData(addr, buffer, blockSize + pattern.size() - 1);
+        spiService.readFlashBulk(addr, buffer.data(), blockSize + pattern.size() - 1);
         
         // Read block
         for (uint32_t i = 0; i <= blockSize; ++i) {
@@ -289,13 +303,13 @@ void SpiFlashShell::cmdSearch() {
 
                 terminalView.println("0x" + argTransformer.toHex(matchAddr, 6) + ": " + context);
             }
+        }
 
-            // Allow user to interrupt
-            char c = terminalInput.readChar();
-            if (c == '\r' || c == '\n') {
-                terminalView.println("\nSPI Flash Search: Cancelled by user.\n");
-                return;
-            }
+        // Allow user to interrupt
+        char c = terminalInput.readChar();
+        if (c == '\r' || c == '\n') {
+            terminalView.println("\nSPI Flash Search: Cancelled by user.\n");
+            return;
         }
     }
 
@@ -331,7 +345,7 @@ void SpiFlashShell::readFlashInChunks(uint32_t address, uint32_t length) {
     // Display chunks
     while (remaining > 0) {
         uint32_t chunkSize = (remaining > 1024) ? 1024 : remaining;
-        spiService.readFlashData(currentAddr, buffer, chunkSize);
+        spiService.readFlashBulk(currentAddr, buffer, chunkSize);
 
         for (uint32_t i = 0; i < chunkSize; i += 16) {
             std::stringstream line;
@@ -373,16 +387,14 @@ void SpiFlashShell::readFlashInChunks(uint32_t address, uint32_t length) {
 }
 
 void SpiFlashShell::readFlashInChunksRaw(uint32_t address, uint32_t length) {
-    uint8_t buffer[1024];
+    std::vector<uint8_t> buffer(4096);
     uint32_t remaining = length;
     uint32_t current   = address;
 
     while (remaining > 0) {
-        uint32_t n = (remaining > sizeof(buffer)) ? sizeof(buffer) : remaining;
-        spiService.readFlashData(current, buffer, n);
-        for (uint32_t i = 0; i < n; ++i) {
-            terminalView.print(buffer[i]);
-        }
+        uint32_t n = (remaining > buffer.size()) ? buffer.size() : remaining;
+        spiService.readFlashBulk(current, buffer.data(), n);
+        terminalView.writeBytes(buffer.data(), n);
         current   += n;
         remaining -= n;
     }
@@ -501,10 +513,61 @@ void SpiFlashShell::cmdDump(bool raw) {
     uint32_t flashSize = readFlashCapacity();
 
     // Chunk read
+    uint32_t startUs = micros();
     if (raw) readFlashInChunksRaw(0, flashSize); 
     else readFlashInChunks(0, flashSize);
+    terminalView.flush();
+    uint32_t elapsedUs = micros() - startUs;
 
-    terminalView.println("\nSPI Flash Dump: Done.\n");
+    terminalView.println("\nSPI Flash Dump: Done.");
+    terminalView.println("SPI Flash Dump: " + FlashReadModeEnumMapper::toString(spiService.getFlashReadMode()) +
+                         ", " + formatThroughput(flashSize, elapsedUs) + "\n");
+}
+
+/*
+Flash Speed Test
+*/
+void SpiFlashShell::cmdSpeedTest() {
+    if (!checkFlashPresent()) return;
+
+    // Read the same window with each mode, without terminal output
+    const uint32_t blockSize = 4096;
+    uint32_t testSize = std::min<uint32_t>(readFlashCapacity(), 256 * 1024);
+    std::vector<uint8_t> buffer(blockSize);
+
+    terminalView.println("\nSPI Flash Speed Test: Reading " + std::to_string(testSize / 1024) +
+                         " KB at " + std::to_string(state.getSpiFrequency() / 1000000) + " MHz...\n");
+
+    auto bench = [&](FlashReadModeEnum mode) {
+        spiService.setFlashReadMode(mode);
+        uint32_t startUs = micros();
+        for (uint32_t addr = 0; addr < testSize; addr += blockSize) {
+            spiService.readFlashBulk(addr, buffer.data(), std::min(blockSize, testSize - addr));
+        }
+        uint32_t elapsedUs = micros() - startUs;
+        terminalView.println("  " + FlashReadModeEnumMapper::toString(mode) + ": " +
+                             formatThroughput(testSize, elapsedUs));
+    };
+
+    bench(FlashReadModeEnum::Standard);
+    bench(FlashReadModeEnum::Fast);
+
+    // Restore the detected mode
+    auto mode = spiService.detectFlashReadMode();
+    terminalView.println("\nSPI Flash Speed Test: Using " + FlashReadModeEnumMapper::toString(mode) + ".\n");
+}
+
+/*
+Throughput
+*/
+std::string SpiFlashShell::formatThroughput(uint32_t bytes, uint32_t elapsedUs) {
+    if (elapsedUs == 0) elapsedUs = 1;
+    float mbps = (float)bytes / (float)elapsedUs; // bytes/us == MB/s
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2) << mbps << " MB/s ("
+       << bytes << " bytes in " << (elapsedUs / 1000) << " ms)";
+    return ss.str();
 }
 
 
@@ -523,5 +586,7 @@ bool SpiFlashShell::checkFlashPresent() {
         return false;
     }
 
+    // Pick the fastest read opcode the chip answers to
+    spiService.detectFlashReadMode();
     return true;
 }
\ No newline at end of file
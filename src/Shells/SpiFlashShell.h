@@ -33,6 +33,7 @@ private:
         " 🗃️  Dump ASCII",
         " 🗃️  Dump RAW",
         " 💣 Erase Flash",
+        " ⏱️  Read speed test",
         "🚪 Exit Shell"
     };
 
@@ -52,8 +53,10 @@ private:
     void cmdWrite();
     void cmdErase();
     void cmdDump(bool raw = false);
+    void cmdSpeedTest();
     void readFlashInChunks(uint32_t address, uint32_t length);
     void readFlashInChunksRaw(uint32_t address, uint32_t length);
     uint32_t readFlashCapacity();
+    std::string formatThroughput(uint32_t bytes, uint32_t elapsedUs);
     bool checkFlashPresent();
 };
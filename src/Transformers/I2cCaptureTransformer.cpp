@@ -0,0 +1,54 @@
+#include "I2cCaptureTransformer.h"
+#include <algorithm>
+#include <cstring>
+
+static_assert(sizeof(i2c_sniffer_record_t) == 8, "capture files store 8 bytes records");
+
+bool I2cCaptureTransformer::begin(uint8_t sclPin, uint8_t sdaPin, const Sink& newSink) {
+    sink = newSink;
+    used = 0;
+    recordCount = 0;
+    written = 0;
+    ok = true;
+
+    uint8_t header[HEADER_SIZE] = { 'I', '2', 'C', 'S', 'N', 'I', 'F', 'F' };
+    header[8] = VERSION & 0xFF;
+    header[9] = VERSION >> 8;
+    header[10] = sizeof(i2c_sniffer_record_t);
+    header[11] = 0;
+    header[12] = sclPin;
+    header[13] = sdaPin;
+    return put(header, sizeof(header));
+}
+
+bool I2cCaptureTransformer::feed(const i2c_sniffer_record_t* records, size_t count) {
+    // The ESP32 is little endian, records go out as they are in memory
+    if (!put(reinterpret_cast<const uint8_t*>(records), count * sizeof(i2c_sniffer_record_t))) return false;
+    recordCount += count;
+    return true;
+}
+
+bool I2cCaptureTransformer::finish() {
+    return flush();
+}
+
+bool I2cCaptureTransformer::put(const uint8_t* data, size_t length) {
+    while (ok && length > 0) {
+        size_t n = std::min(length, BUFFER_SIZE - used);
+        memcpy(buffer + used, data, n);
+        used += n;
+        data += n;
+        length -= n;
+        if (used == BUFFER_SIZE) flush();
+    }
+    return ok;
+}
+
+bool I2cCaptureTransformer::flush() {
+    if (ok && used > 0) {
+        ok = sink(buffer, used);
+        written += used;
+        used = 0;
+    }
+    return ok;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include "Vendors/i2c_sniffer.h"
+
+/*
+Binary I2C capture file, a 16 bytes header then the sniffer records as is.
+Header: "I2CSNIFF", u16 version (LE), u8 record size, u8 0, u8 SCL pin,
+u8 SDA pin, 2 bytes 0. Records are little endian.
+Records are buffered and handed to the sink in blocks.
+*/
+class I2cCaptureTransformer {
+public:
+    using Sink = std::function<bool(const uint8_t*, size_t)>;
+
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+
+    bool begin(uint8_t sclPin, uint8_t sdaPin, const Sink& sink);
+
+    // Append records, false once the sink failed
+    bool feed(const i2c_sniffer_record_t* records, size_t count);
+
+    // Hand the last records to the sink
+    bool finish();
+
+    uint32_t getRecordCount() const { return recordCount; }
+    uint32_t getBytesWritten() const { return written; }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 4096;
+
+    bool put(const uint8_t* data, size_t length);
+    bool flush();
+
+    Sink sink;
+    uint8_t buffer[BUFFER_SIZE];
+    size_t used = 0;
+    uint32_t recordCount = 0;
+    uint32_t written = 0;
+    bool ok = false;
+};
@@ -0,0 +1,121 @@
+#include "I2cTransactionTransformer.h"
+#include <cstdio>
+
+void I2cTransactionTransformer::reset() {
+    current.clear();
+    done.clear();
+    inTransaction = false;
+    lostBefore = false;
+}
+
+bool I2cTransactionTransformer::feed(const i2c_sniffer_record_t& record) {
+    switch (record.type) {
+        case I2C_SNIFFER_START:
+            // Repeated START, a new segment of the same transaction
+            if (!inTransaction) open(record.time_us);
+            if (current.segmentCount < I2cTransaction::MAX_SEGMENTS) current.segmentCount++;
+            current.segments[current.segmentCount - 1] = I2cTransaction::Segment();
+            current.segments[current.segmentCount - 1].firstByte = current.dataCount;
+            return false;
+
+        case I2C_SNIFFER_ADDR: {
+            // START was missed
+            if (!inTransaction) {
+                open(record.time_us);
+                current.segmentCount = 1;
+                current.segments[0] = I2cTransaction::Segment();
+                current.lost = true;
+            }
+            auto& segment = current.segments[current.segmentCount - 1];
+            segment.address = record.value >> 1;
+            segment.read = record.value & 0x01;
+            segment.addressNack = record.nack;
+            segment.firstByte = current.dataCount;
+            return false;
+        }
+
+        case I2C_SNIFFER_DATA: {
+            if (!inTransaction) return false;
+            auto& segment = current.segments[current.segmentCount - 1];
+            segment.byteCount++;
+            if (current.dataCount < I2cTransaction::MAX_BYTES) {
+                current.data[current.dataCount++] = record.value;
+                segment.keptBytes++;
+            }
+            current.lastNack = record.nack;
+            current.endUs = record.time_us;
+            return false;
+        }
+
+        case I2C_SNIFFER_STOP:
+            return inTransaction && close(record.time_us, true);
+
+        case I2C_SNIFFER_LOST:
+            // What is in progress is incomplete, the next one may be too
+            lostBefore = true;
+            if (!inTransaction) return false;
+            current.lost = true;
+            return close(record.time_us, false);
+
+        default:
+            return false;
+    }
+}
+
+void I2cTransactionTransformer::open(uint32_t timeUs) {
+    current.clear();
+    current.startUs = timeUs;
+    current.endUs = timeUs;
+    current.lost = lostBefore;
+    lostBefore = false;
+    inTransaction = true;
+}
+
+bool I2cTransactionTransformer::close(uint32_t timeUs, bool stopped) {
+    current.endUs = timeUs;
+    current.stopped = stopped;
+    done = current;
+    inTransaction = false;
+    return done.segmentCount > 0;
+}
+
+std::string I2cTransactionTransformer::format(const I2cTransaction& t) const {
+    std::string line;
+    char buf[24];
+
+    snprintf(buf, sizeof(buf), "%4lu.%06lu ", (unsigned long)(t.startUs / 1000000), (unsigned long)(t.startUs % 1000000));
+    line += buf;
+
+    for (uint8_t i = 0; i < t.segmentCount; ++i) {
+        const auto& segment = t.segments[i];
+        if (i > 0) line += " |";
+
+        // First segment carries the address, a repeated START to the same one only the direction
+        if (i == 0 || segment.address != t.segments[i - 1].address) {
+            snprintf(buf, sizeof(buf), " 0x%02X", segment.address);
+            line += buf;
+        }
+        line += segment.read ? " R" : " W";
+        if (segment.addressNack) {
+            line += " NACK";
+            continue;
+        }
+
+        for (uint8_t b = 0; b < segment.keptBytes; ++b) {
+            snprintf(buf, sizeof(buf), " %02X", t.data[segment.firstByte + b]);
+            line += buf;
+        }
+        if (segment.byteCount > segment.keptBytes) {
+            line += " ... (" + std::to_string(segment.byteCount) + " bytes)";
+        }
+    }
+
+    // A read ends with a NACK from the master, only a write NACK is worth showing
+    const auto& last = t.segments[t.segmentCount - 1];
+    if (!last.read && !last.addressNack && last.byteCount && t.lastNack) line += " NACK";
+    if (!t.stopped) line += " (no STOP)";
+    if (t.lost) line += " [LOST]";
+
+    line += "  (" + std::to_string(t.endUs - t.startUs) + " us)";
+    return line;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include "Models/I2cTransaction.h"
+#include "Vendors/i2c_sniffer.h"
+
+/*
+Groups sniffer records into transactions, one summary line each.
+Records are fed in capture order, a STOP (or lost records) closes
+the transaction in progress.
+*/
+class I2cTransactionTransformer {
+public:
+    void reset();
+
+    // True when the record closed a transaction, see getTransaction()
+    bool feed(const i2c_sniffer_record_t& record);
+
+    // Last closed transaction, valid until the next feed
+    const I2cTransaction& getTransaction() const { return done; }
+
+    // "  1.234567  0x3C W 00 AF | R 12 34 NACK  (48 us)"
+    std::string format(const I2cTransaction& transaction) const;
+
+private:
+    void open(uint32_t timeUs);
+    bool close(uint32_t timeUs, bool stopped);
+
+    I2cTransaction current;
+    I2cTransaction done;
+    bool inTransaction = false;
+    bool lostBefore = false;
+};
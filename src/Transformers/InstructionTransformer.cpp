@@ -1,184 +1,127 @@
 #include "InstructionTransformer.h"
 
-std::vector<Instruction> InstructionTransformer::transform(const std::string& raw) {
-    std::vector<Instruction> instructions;
-    if (raw.empty()) return instructions;
+bool InstructionTransformer::compile(const std::string& raw, std::vector<ByteCode>& program) const {
+    program.clear();
+    if (raw.empty()) return true;
+
+    // First pass counts the bytecodes, so the program is allocated once
+    size_t count = 0;
+    scan(raw, [&count](const ByteCode&) { ++count; });
+    if (count > MAX_PROGRAM_SIZE) return false;
+
+    program.reserve(count);
+    scan(raw, [&program](const ByteCode& code) { program.push_back(code); });
+    return true;
+}
 
-    bool inChar = false;
+template <typename Emit>
+void InstructionTransformer::scan(const std::string& raw, Emit&& emit) const {
+    const char* p = raw.data();
+    const char* end = p + raw.size();
+    const char* tokenStart = nullptr;
     bool inBlock = false;
-    bool inString = false;
-    std::string token;
-    std::string currentRaw;
-    Instruction* currentInstruction = nullptr;
+    char prefix = '\0';
 
-    for (char c : raw) {
-        if (inChar) {
-            token += c;
-            currentRaw += c;
-            if (c == '\'') {
-                if (currentInstruction) {
-                    currentInstruction->addToken(token);
-                }
-                token.clear();
-                inChar = false;
-            }
-            continue;
+    auto flushToken = [&](const char* tokenEnd) {
+        if (tokenStart && tokenEnd > tokenStart) {
+            compileToken(Token{tokenStart, tokenEnd}, emit);
         }
-
-        if (inString) {
-            token += c;
-            currentRaw += c;
-            if (c == '"') {
-                if (currentInstruction) {
-                    currentInstruction->addToken(token);
+        tokenStart = nullptr;
+    };
+
+    while (p < end) {
+        char c = *p;
+
+        // Char and string literals, '...' and "...", are written inline
+        if (c == '\'' || c == '"') {
+            flushToken(p);
+            const char* close = p + 1;
+            while (close < end && *close != c) ++close;
+            if (inBlock) {
+                for (const char* s = p + 1; s < close; ++s) {
+                    emit(ByteCode(ByteCodeEnum::Write, static_cast<uint8_t>(*s)));
                 }
-                token.clear();
-                inString = false;
-                continue;
             }
-            continue;
-        }
-
-
-        if (c == '\'') {
-            token = "'";
-            currentRaw += c;
-            inChar = true;
-            continue;
-        }
-
-        if (c == '"') {
-            token = "\"";
-            currentRaw += c;
-            inString = true;
+            p = (close < end) ? close + 1 : end;
             continue;
         }
 
         if (c == '[' || c == '{' || c == '>') {
+            flushToken(p);
             inBlock = true;
-            currentRaw = std::string(1, c);
-            currentInstruction = new Instruction(currentRaw);
-            currentInstruction->prefix = c;
+            prefix = c;
+            if (prefix == '[') emit(ByteCode(ByteCodeEnum::Start));
+            ++p;
             continue;
         }
 
-        if (c == ']') {
-            if (!token.empty() && currentInstruction) {
-                currentInstruction->addToken(token);
-                token.clear();
-            }
-            if (currentInstruction) {
-                currentRaw += c;
-                currentInstruction->raw = currentRaw;
-                instructions.push_back(*currentInstruction);
-                delete currentInstruction;
-                currentInstruction = nullptr;
-            }
+        if (c == ']' || c == '}') {
+            flushToken(p);
+            if (inBlock && prefix == '[') emit(ByteCode(ByteCodeEnum::Stop));
             inBlock = false;
+            prefix = '\0';
+            ++p;
             continue;
         }
 
         if (inBlock) {
-            currentRaw += c;
-            if (std::isspace(c)) {
-                if (!token.empty() && currentInstruction) {
-                    currentInstruction->addToken(token);
-                    token.clear();
-                }
-            } else {
-                token += c;
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                flushToken(p);
+            } else if (!tokenStart) {
+                tokenStart = p;
             }
         }
+        ++p;
     }
 
-    return instructions;
+    // Unterminated block, compile what was typed
+    flushToken(end);
 }
 
-std::vector<ByteCode> InstructionTransformer::transformByteCode(const Instruction& instruction) {
-    std::vector<ByteCode> bytecodes;
-
-    if (instruction.prefix == '[') {
-        bytecodes.emplace_back(ByteCodeEnum::Start);
-    }
-
-    for (const auto& tok : instruction.tokens) {
-        if (isCharLiteral(tok)) {
-            bytecodes.emplace_back(ByteCodeEnum::Write, parseCharLiteral(tok));
-        } 
-        
-        else if (isStringLiteral(tok)) {
-            for (char c : tok.substr(1, tok.size() - 2)) {
-                bytecodes.emplace_back(ByteCodeEnum::Write, static_cast<uint8_t>(c));
-            }
-        } 
-        
-        else if (isHex(tok)) {
-            bytecodes.emplace_back(ByteCodeEnum::Write, parseHex(tok));
-        } 
-        
-        else if (isDecimal(tok)) {
-            bytecodes.emplace_back(ByteCodeEnum::Write, parseDecimal(tok));
-        } 
-        
-        else if (isSymbolWithRepeat(tok)) {
-            std::pair<ByteCodeEnum, uint8_t> result = parseSymbolWithRepeat(tok);
-            ByteCodeEnum sym = result.first;
-            uint8_t repeat = result.second;
-            bytecodes.emplace_back(sym, 0, 8, repeat);
+template <typename Emit>
+void InstructionTransformer::compileToken(const Token& tok, Emit&& emit) const {
+    const char* b = tok.begin;
+    const char* e = tok.end;
+    size_t size = tok.size();
+    uint32_t value = 0;
+
+    // Hex, 0xA5
+    if (size > 2 && b[0] == '0' && (b[1] == 'x' || b[1] == 'X')) {
+        if (parseNumber(b + 2, e, 16, value)) {
+            emit(ByteCode(ByteCodeEnum::Write, static_cast<uint8_t>(value)));
         }
+        return;
+    }
 
-        else if (isRepeatedSymbol(tok)) {
-            char symbol = tok[0];
-            uint8_t repeat = tok.size();
-            bytecodes.emplace_back(parseSymbol(symbol).getCommand(), 0, 8, repeat);
-        }
-        
-        else if (isSymbol(tok)) {
-            bytecodes.push_back(parseSymbol(tok[0]));
+    // Decimal, 165
+    if (std::isdigit(static_cast<unsigned char>(b[0]))) {
+        if (parseNumber(b, e, 10, value)) {
+            emit(ByteCode(ByteCodeEnum::Write, static_cast<uint8_t>(value)));
         }
+        return;
     }
 
-    if (instruction.prefix == '[') {
-        bytecodes.emplace_back(ByteCodeEnum::Stop);
+    if (!isSymbolChar(b[0])) {
+        // Other punctuation is accepted but does nothing
+        return;
     }
 
-    return bytecodes;
-}
-
-std::vector<ByteCode> InstructionTransformer::transformByteCodes(const std::vector<Instruction>& instructions) {
-    std::vector<ByteCode> allByteCodes;
-
-    for (auto& inst : instructions) {
-        std::vector<ByteCode> bytecodes = transformByteCode(inst);
-        allByteCodes.insert(allByteCodes.end(), bytecodes.begin(), bytecodes.end());
+    // Symbol with repeat, r:4
+    if (size > 2 && b[1] == ':') {
+        if (parseNumber(b + 2, e, 10, value)) {
+            emit(parseSymbol(b[0], std::min(value, MAX_REPEAT), true));
+        }
+        return;
     }
 
-    return allByteCodes;
-}
-
-bool InstructionTransformer::isHex(const std::string& token) const {
-    return token.size() > 2 &&
-           token[0] == '0' &&
-           std::tolower(token[1]) == 'x';
-}
-
-bool InstructionTransformer::isDecimal(const std::string& token) const {
-    return !token.empty() && std::all_of(token.begin(), token.end(), ::isdigit);
-}
-
-bool InstructionTransformer::isCharLiteral(const std::string& token) const {
-    return token.size() == 3 && token.front() == '\'' && token.back() == '\'';
-}
-
-bool InstructionTransformer::isStringLiteral(const std::string& token) const {
-    return token.size() >= 2 &&
-           ((token.front() == '"' && token.back() == '"') ||
-            (token.front() == '\'' && token.back() == '\''));
+    // Single or repeated symbol, r / rrrr
+    for (const char* s = b + 1; s < e; ++s) {
+        if (*s != b[0]) return;
+    }
+    emit(parseSymbol(b[0], size, size > 1));
 }
 
-bool InstructionTransformer::isSymbol(const std::string& token) const {
-    if (token.size() != 1) return false;
-    char c = token[0];
+bool InstructionTransformer::isSymbolChar(char c) const {
     switch (c) {
         case 'r':
         case 'd':
@@ -188,90 +131,50 @@ bool InstructionTransformer::isSymbol(const std::string& token) const {
         case 'h':
         case 'l':
             return true;
-        default:
-            return std::ispunct(c);
-    }
-}
-
-bool InstructionTransformer::isSymbolWithRepeat(const std::string& token) const {
-    auto pos = token.find(':');
-    if (pos == std::string::npos) return false;
-    if (pos == 0 || pos == token.size() - 1) return false;
-
-    char symbol = token[0];
-    switch (symbol) {
-        case 'r':
-        case 'd':
-        case 'D':
-        case 's':
-        case 'S':
-        case 'h':
-        case 'l':
-            break;
         default:
             return false;
     }
-
-    std::string repeatStr = token.substr(pos + 1);
-    return std::all_of(repeatStr.begin(), repeatStr.end(), ::isdigit);
 }
 
-
-uint8_t InstructionTransformer::parseHex(const std::string& token) const {
-    return static_cast<uint8_t>(std::stoul(token, nullptr, 16));
-}
-
-uint8_t InstructionTransformer::parseDecimal(const std::string& token) const {
-    return static_cast<uint8_t>(std::stoul(token));
-}
-
-uint8_t InstructionTransformer::parseCharLiteral(const std::string& token) const {
-    return static_cast<uint8_t>(token[1]);
+bool InstructionTransformer::parseNumber(const char* begin, const char* end, uint8_t base, uint32_t& out) const {
+    if (begin >= end) return false;
+
+    uint32_t value = 0;
+    for (const char* p = begin; p < end; ++p) {
+        char c = *p;
+        uint8_t digit;
+        if (c >= '0' && c <= '9') digit = c - '0';
+        else if (base == 16 && c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+        else if (base == 16 && c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+        else return false;
+
+        // Saturate instead of overflowing on absurdly long numbers
+        if (value <= (UINT32_MAX - digit) / base) {
+            value = value * base + digit;
+        } else {
+            value = UINT32_MAX;
+        }
+    }
+    out = value;
+    return true;
 }
 
-ByteCode InstructionTransformer::parseSymbol(char c) const {
+ByteCode InstructionTransformer::parseSymbol(char c, uint32_t repeat, bool withRepeat) const {
+    ByteCodeEnum command;
     switch (c) {
-        case 'r': return ByteCode(ByteCodeEnum::Read, 0, 8, 1);
-        case 'd': return ByteCode(ByteCodeEnum::DelayUs, 0, 8, 1);
-        case 'D': return ByteCode(ByteCodeEnum::DelayMs, 0, 8, 1);
-        case 's': return ByteCode(ByteCodeEnum::Start);
-        case 'S': return ByteCode(ByteCodeEnum::Stop);
-        case 'h': return ByteCode(ByteCodeEnum::AuxHigh);
-        case 'l': return ByteCode(ByteCodeEnum::AuxLow);
-        default: return ByteCode(ByteCodeEnum::None);
+        case 'r': command = ByteCodeEnum::Read;    break;
+        case 'd': command = ByteCodeEnum::DelayUs; break;
+        case 'D': command = ByteCodeEnum::DelayMs; break;
+        case 's': command = ByteCodeEnum::Start;   break;
+        case 'S': command = ByteCodeEnum::Stop;    break;
+        case 'h': command = ByteCodeEnum::AuxHigh; break;
+        case 'l': command = ByteCodeEnum::AuxLow;  break;
+        default:  command = ByteCodeEnum::None;    break;
     }
-}
-
-std::pair<ByteCodeEnum, uint8_t> InstructionTransformer::parseSymbolWithRepeat(const std::string& token) const {
-    char symbol = token[0];
-    size_t colonPos = token.find(':');
-    unsigned long parsed = std::stoul(token.substr(colonPos + 1));
-    uint8_t repeat = std::min(parsed, 255ul);
-
-    return { parseSymbol(symbol).getCommand(), repeat };
-}
 
-bool InstructionTransformer::isRepeatedSymbol(const std::string& token) const {
-    if (token.empty()) return false;
-    char first = token[0];
-
-    // repeat available on 
-    switch (first) {
-        case 'r':
-        case 'd':
-        case 'D':
-        case 'h':
-        case 'l':
-        case 's':
-        case 'S':
-            break;
-        default:
-            return false;
+    // r, d and D always carry their repeat count, like r:1
+    if (withRepeat || c == 'r' || c == 'd' || c == 'D') {
+        return ByteCode(command, 0, 8, repeat);
     }
-
-    // verify each char
-    return std::all_of(token.begin(), token.end(), [first](char c) {
-        return c == first;
-    });
+    return ByteCode(command);
 }
-
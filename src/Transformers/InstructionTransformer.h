@@ -3,29 +3,34 @@
 #include <string>
 #include <vector>
 #include <cctype>
-#include <sstream>
 #include <algorithm>
+#include <cstdint>
 #include "Models/ByteCode.h"
-#include "Models/Instruction.h"
-#include "Arduino.h"
 
 class InstructionTransformer {
 public:
-    std::vector<Instruction> transform(const std::string& raw);
-    std::vector<ByteCode> transformByteCode(const Instruction& instruction);
-    std::vector<ByteCode> transformByteCodes(const std::vector<Instruction>& instructions);
+    // Limits keep the compiled program bounded, whatever the line length
+    static constexpr size_t MAX_PROGRAM_SIZE = 8192;  // bytecodes, 64 KB
+    static constexpr uint32_t MAX_REPEAT = 65535;
+
+    // Compile a raw instruction line ("[0xA5 r:4]") into a contiguous bytecode program
+    bool compile(const std::string& raw, std::vector<ByteCode>& program) const;
 
 private:
-    bool isHex(const std::string& token) const;
-    bool isDecimal(const std::string& token) const;
-    bool isCharLiteral(const std::string& token) const;
-    bool isSymbol(const std::string& token) const;
-    bool isRepeatedSymbol(const std::string& token) const;
-    bool isSymbolWithRepeat(const std::string& token) const;
-    bool isStringLiteral(const std::string& token) const;
-    uint8_t parseHex(const std::string& token) const;
-    uint8_t parseDecimal(const std::string& token) const;
-    uint8_t parseCharLiteral(const std::string& token) const;
-    ByteCode parseSymbol(char c) const;
-    std::pair<ByteCodeEnum, uint8_t> parseSymbolWithRepeat(const std::string& token) const;
+    // A token is a view into the raw line, never copied
+    struct Token {
+        const char* begin;
+        const char* end;
+        size_t size() const { return end - begin; }
+    };
+
+    template <typename Emit>
+    void scan(const std::string& raw, Emit&& emit) const;
+
+    template <typename Emit>
+    void compileToken(const Token& tok, Emit&& emit) const;
+
+    bool isSymbolChar(char c) const;
+    bool parseNumber(const char* begin, const char* end, uint8_t base, uint32_t& out) const;
+    ByteCode parseSymbol(char c, uint32_t repeat, bool withRepeat) const;
 };
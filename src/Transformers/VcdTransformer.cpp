@@ -0,0 +1,115 @@
+#include "VcdTransformer.h"
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+bool VcdTransformer::begin(const std::vector<uint8_t>& pins, uint32_t rate, const std::string& version, const Sink& output) {
+    sink = output;
+    channels = pins.size();
+    sampleRate = rate ? rate : 1;
+    index = 0;
+    written = 0;
+    previous = 0;
+    used = 0;
+    ok = true;
+
+    // Timestamps are in ns, exact up to 1 GHz for rates dividing it
+    put("$version " + version + " $end\n");
+    put("$timescale 1 ns $end\n");
+    put("$scope module logic $end\n");
+    for (size_t i = 0; i < channels; ++i) {
+        put("$var wire 1 " + std::string(1, char('!' + i)) + " GPIO" + std::to_string(pins[i]) + " $end\n");
+    }
+    put("$upscope $end\n");
+    return put("$enddefinitions $end\n");
+}
+
+bool VcdTransformer::feed(const uint8_t* samples, size_t count) {
+    if (!ok || count == 0) return ok;
+
+    size_t i = 0;
+    if (index == 0) {
+        putDumpVars(samples[0]);
+        i = 1;
+    }
+
+    for (; i < count; ++i) {
+        uint8_t changed = samples[i] ^ previous;
+        if (changed) putChanges(index + i, samples[i], changed);
+    }
+
+    index += count;
+    return ok;
+}
+
+bool VcdTransformer::feedRun(uint8_t value, uint64_t length) {
+    if (!ok || length == 0) return ok;
+
+    if (index == 0) {
+        putDumpVars(value);
+    } else if (value != previous) {
+        putChanges(index, value, value ^ previous);
+    }
+
+    index += length;
+    return ok;
+}
+
+void VcdTransformer::putDumpVars(uint8_t sample) {
+    // First sample dumps every wire
+    put("#0\n$dumpvars\n");
+    for (size_t ch = 0; ch < channels; ++ch) {
+        char line[3] = { char('0' + ((sample >> ch) & 1)), char('!' + ch), '\n' };
+        put(line, sizeof(line));
+    }
+    put("$end\n");
+    previous = sample;
+}
+
+void VcdTransformer::putChanges(uint64_t sample, uint8_t value, uint8_t changed) {
+    putTime(sample);
+    for (size_t ch = 0; ch < channels; ++ch) {
+        if (!((changed >> ch) & 1)) continue;
+        char line[3] = { char('0' + ((value >> ch) & 1)), char('!' + ch), '\n' };
+        put(line, sizeof(line));
+    }
+    previous = value;
+}
+
+bool VcdTransformer::finish() {
+    if (!ok) return false;
+    putTime(index);
+    return flush();
+}
+
+bool VcdTransformer::putTime(uint64_t sample) {
+    char line[24];
+    int length = snprintf(line, sizeof(line), "#%llu\n",
+                          (unsigned long long)(sample * 1000000000ULL / sampleRate));
+    return put(line, length);
+}
+
+bool VcdTransformer::put(const std::string& text) {
+    return put(text.data(), text.size());
+}
+
+bool VcdTransformer::put(const char* text, size_t length) {
+    while (ok && length > 0) {
+        size_t n = std::min(length, BUFFER_SIZE - used);
+        memcpy(buffer + used, text, n);
+        used += n;
+        text += n;
+        length -= n;
+        if (used == BUFFER_SIZE) flush();
+    }
+    return ok;
+}
+
+bool VcdTransformer::flush() {
+    if (ok && used > 0) {
+        ok = sink(reinterpret_cast<const uint8_t*>(buffer), used);
+        written += used;
+        used = 0;
+    }
+    return ok;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+/*
+Value Change Dump encoder for logic captures, one wire per pin.
+Samples are fed by blocks and only the changes are written, so memory
+stays constant whatever the capture depth. PulseView and GTKWave read it.
+*/
+class VcdTransformer {
+public:
+    using Sink = std::function<bool(const uint8_t*, size_t)>;
+
+    // Write the header and wait for samples, bit N of a sample is pins[N]
+    bool begin(const std::vector<uint8_t>& pins, uint32_t sampleRate, const std::string& version, const Sink& sink);
+
+    // Append samples right after the previous ones, false once the sink failed
+    bool feed(const uint8_t* samples, size_t count);
+
+    // Append `length` samples of the same value, for run-length captures
+    bool feedRun(uint8_t value, uint64_t length);
+
+    // Close the dump with the end timestamp and hand the last bytes to the sink
+    bool finish();
+
+    uint64_t getSampleCount() const { return index; }
+    uint64_t getBytesWritten() const { return written; }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 1024;
+
+    bool put(const char* text, size_t length);
+    bool put(const std::string& text);
+    bool putTime(uint64_t sample);
+    void putDumpVars(uint8_t sample);
+    void putChanges(uint64_t sample, uint8_t value, uint8_t changed);
+    bool flush();
+
+    Sink sink;
+    size_t channels = 0;
+    uint32_t sampleRate = 1;
+    uint64_t index = 0;
+    uint64_t written = 0;
+    uint8_t previous = 0;
+    bool ok = false;
+
+    char buffer[BUFFER_SIZE];
+    size_t used = 0;
+};
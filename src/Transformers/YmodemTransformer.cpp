@@ -0,0 +1,96 @@
+#include "YmodemTransformer.h"
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+uint16_t YmodemTransformer::crc16(const uint8_t* data, size_t length) {
+    // CRC-16/XMODEM, poly 0x1021, init 0
+    uint16_t crc = 0;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+size_t YmodemTransformer::encodeBlock(uint8_t seq, const uint8_t* data, size_t length, uint8_t* frame) const {
+    size_t blockSize = length > SMALL_BLOCK ? LARGE_BLOCK : SMALL_BLOCK;
+    if (length > blockSize) length = blockSize;
+
+    frame[0] = blockSize == LARGE_BLOCK ? STX : SOH;
+    frame[1] = seq;
+    frame[2] = ~seq;
+    if (length) memcpy(frame + 3, data, length);
+    memset(frame + 3 + length, PAD, blockSize - length);
+
+    uint16_t crc = crc16(frame + 3, blockSize);
+    frame[3 + blockSize] = crc >> 8;
+    frame[4 + blockSize] = crc & 0xFF;
+    return blockSize + OVERHEAD;
+}
+
+size_t YmodemTransformer::encodeHeader(const std::string& name, uint32_t size, uint8_t* frame) const {
+    uint8_t data[SMALL_BLOCK] = {};
+
+    if (!name.empty()) {
+        // "name\0size", the name is cut to leave room for the size
+        std::string sizeStr = std::to_string(size);
+        size_t nameLength = std::min(name.size(), SMALL_BLOCK - sizeStr.size() - 2);
+        memcpy(data, name.data(), nameLength);
+        memcpy(data + nameLength + 1, sizeStr.data(), sizeStr.size());
+    }
+
+    // The header is always a zero padded 128 bytes block
+    frame[0] = SOH;
+    frame[1] = 0;
+    frame[2] = 0xFF;
+    memcpy(frame + 3, data, SMALL_BLOCK);
+    uint16_t crc = crc16(data, SMALL_BLOCK);
+    frame[3 + SMALL_BLOCK] = crc >> 8;
+    frame[4 + SMALL_BLOCK] = crc & 0xFF;
+    return SMALL_BLOCK + OVERHEAD;
+}
+
+size_t YmodemTransformer::blockSizeOf(uint8_t start) {
+    if (start == SOH) return SMALL_BLOCK;
+    if (start == STX) return LARGE_BLOCK;
+    return 0;
+}
+
+bool YmodemTransformer::checkFrame(const uint8_t* frame, size_t frameSize, uint8_t& seq) const {
+    size_t blockSize = blockSizeOf(frame[0]);
+    if (blockSize == 0 || frameSize != blockSize + OVERHEAD) return false;
+    if ((uint8_t)(frame[1] ^ frame[2]) != 0xFF) return false;
+
+    uint16_t crc = ((uint16_t)frame[3 + blockSize] << 8) | frame[4 + blockSize];
+    if (crc16(frame + 3, blockSize) != crc) return false;
+
+    seq = frame[1];
+    return true;
+}
+
+bool YmodemTransformer::decodeHeader(const uint8_t* data, size_t length, std::string& name, uint32_t& size) const {
+    name.clear();
+    size = 0;
+    if (length == 0 || data[0] == 0) return false;
+
+    size_t nameLength = strnlen(reinterpret_cast<const char*>(data), length);
+    name.assign(reinterpret_cast<const char*>(data), nameLength);
+
+    // Size is optional, decimal, followed by a space or NUL
+    if (nameLength + 1 < length) {
+        const uint8_t* p = data + nameLength + 1;
+        const uint8_t* end = data + length;
+        while (p < end && *p >= '0' && *p <= '9') {
+            size = size * 10 + (*p - '0');
+            ++p;
+        }
+    }
+
+    // Senders may send a path, only the file name is kept
+    size_t slash = name.find_last_of("/\\");
+    if (slash != std::string::npos) name = name.substr(slash + 1);
+    return !name.empty();
+}
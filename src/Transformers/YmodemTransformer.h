@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+/*
+YMODEM framing, no I/O.
+A block is [SOH|STX][seq][~seq][128|1024 data][CRC16 hi][CRC16 lo],
+block 0 of each file carries "name\0size" and an empty name ends the batch.
+*/
+class YmodemTransformer {
+public:
+    static constexpr uint8_t SOH = 0x01; // 128 bytes block
+    static constexpr uint8_t STX = 0x02; // 1024 bytes block
+    static constexpr uint8_t EOT = 0x04;
+    static constexpr uint8_t ACK = 0x06;
+    static constexpr uint8_t NAK = 0x15;
+    static constexpr uint8_t CAN = 0x18;
+    static constexpr uint8_t CRC_REQUEST = 'C';
+    static constexpr uint8_t STREAM_REQUEST = 'G'; // YMODEM-g, no ACK per block
+    static constexpr uint8_t PAD = 0x1A;
+
+    static constexpr size_t SMALL_BLOCK = 128;
+    static constexpr size_t LARGE_BLOCK = 1024;
+    static constexpr size_t OVERHEAD = 5; // header 3, CRC 2
+    static constexpr size_t MAX_FRAME = LARGE_BLOCK + OVERHEAD;
+
+    static uint16_t crc16(const uint8_t* data, size_t length);
+
+    // Frame `length` bytes padded to the block size, returns the frame size
+    size_t encodeBlock(uint8_t seq, const uint8_t* data, size_t length, uint8_t* frame) const;
+
+    // Block 0, an empty name makes the end of batch block
+    size_t encodeHeader(const std::string& name, uint32_t size, uint8_t* frame) const;
+
+    // Data size announced by the start byte, 0 if it is not a block start
+    static size_t blockSizeOf(uint8_t start);
+
+    // Sequence and CRC of a full frame, start byte included
+    bool checkFrame(const uint8_t* frame, size_t frameSize, uint8_t& seq) const;
+
+    // Name and size from the block 0 data, false for the end of batch
+    bool decodeHeader(const uint8_t* data, size_t length, std::string& name, uint32_t& size) const;
+};
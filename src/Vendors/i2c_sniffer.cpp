@@ -14,148 +14,230 @@
  * It means there are 600 ESP32 cycles during one I2C clock tick.
  *
  * 
- * The program uses interrupts to detect
+ * The program polls SCL/SDA and detects
  * the raise edge of the SCL - bit transfer 
  * the falling edge of SDA if SCL is HIGH- START
  * the raise edge of SDA if SCL id HIGH - STOP 
  * 
- * In the interrupt routines there is just a few line of code
- * that mainly sets the status and stores the incoming bits.
- * Otherwise the program gets timeout panic in interrupt handler and
- * restart the CPU.
- * 
  * 
  * REWORKED for ESP32 Bus Pirate
  * 
+ * A GPIO interrupt per edge saturates the core at 400kHz and more.
+ * The lines are now polled by a task pinned to the other core, with
+ * interrupts masked during sampling windows (dedicated GPIO on S3).
+ * While WiFi runs, interrupts stay enabled, its MAC and lwIP live on core 0.
+ * The sampler assembles bytes and pushes 8 bytes binary records with a
+ * microsecond timestamp, they are read in batches. Lost records are counted.
+ * 
  *                   https://github.com/WhitehawkTailor/I2C-sniffer/
  */
 
 #include "i2c_sniffer.h"
 #include <Arduino.h>
-#include "driver/gpio.h"
+#include "soc/soc_caps.h"
+#include "soc/gpio_reg.h"
+#include "esp_wifi.h"
 
-// --- Minimal internal notes (added): ISR pushes compact events into an event ring.
-// The main context converts events into ASCII and exposes them via read()/available().
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    #include "driver/dedic_gpio.h"
+    #include "hal/dedic_gpio_cpu_ll.h"
+#endif
 
 static uint8_t sniffer_scl_pin = 1; // override by i2c_sniffer_begin()
 static uint8_t sniffer_sda_pin = 2;
 
-#define I2C_IDLE 0
-#define I2C_TRX  2
+// ---- Line levels, as read by the sampler ----
+#define LINE_SCL 0x1
+#define LINE_SDA 0x2
+
+// ---- Sampling windows, interrupts are masked inside unless WiFi runs ----
+#define WINDOW_US     10000 // ended between transactions when possible
+#define MAX_WINDOW_US 50000
+#define STALL_NS      500   // a pause this long can hide an SCL pulse at 400kHz
+
+// ---- Record ring (sampler -> reader), single producer, single consumer ----
+#define RECORD_RING_ORDER 11
+#define RECORD_RING_SIZE  (1u << RECORD_RING_ORDER)   // 2048 records, 16KB
+#define RECORD_RING_MASK  (RECORD_RING_SIZE - 1u)
+static i2c_sniffer_record_t recordRing[RECORD_RING_SIZE];
+static volatile uint16_t recordW = 0;
+static volatile uint16_t recordR = 0;
+
+// ---- Sampler (other core) ----
+static volatile bool samplerRunning = false;
+static TaskHandle_t samplerTask = nullptr;
+static SemaphoreHandle_t samplerStopped = nullptr; // given by the sampler before it ends
+static uint8_t samplerCore = 0;
+static bool maskInterrupts = true;
+static uint32_t sclReg = GPIO_IN_REG;
+static uint32_t sdaReg = GPIO_IN_REG;
+static uint32_t sclMask = 0;
+static uint32_t sdaMask = 0;
+static bool sameReg = true;
+static bool lostPending = false;
+
+// Microsecond clock, re-anchored on the cycle counter at each window
+static uint32_t cpuMhz = 240;
+static uint32_t baseUs = 0;
+static uint32_t baseCycles = 0;
+
+#if SOC_DEDICATED_GPIO_SUPPORTED
+    static dedic_gpio_bundle_handle_t bundle = nullptr;
+    static uint32_t bundleOffset = 0;
+#endif
+
+// ---- Counters ----
+static volatile uint32_t recordCount = 0;
+static volatile uint32_t droppedCount = 0;
+static volatile uint32_t stallCount = 0;
+static volatile uint32_t sampleRateKhz = 0;
+
+// ---- Sampler helpers (IRAM, run with interrupts masked) ----
+static inline uint32_t IRAM_ATTR cycles_to_us(uint32_t cycles) {
+    return baseUs + (cycles - baseCycles) / cpuMhz;
+}
 
-// ---- Event tags (4 bits) ----
-#define TAG_START 0x1
-#define TAG_STOP  0x2
-#define TAG_DATA  0x3
-#define TAG_ADDR  0x4
-#define TAG_ACK   0x5
+static inline void IRAM_ATTR push_record(uint8_t type, uint8_t value, uint8_t nack, uint32_t timeUs) {
+    uint16_t w = recordW;
+    uint16_t r = __atomic_load_n(&recordR, __ATOMIC_ACQUIRE);
 
-static inline uint16_t PACK_EVENT(uint16_t tag, uint16_t value) {
-    return (uint16_t)((tag << 12) | (value & 0x0FFF));
-}
-static inline uint8_t  EVENT_TAG(uint16_t ev) { return (uint8_t)((ev >> 12) & 0x0F); }
-static inline uint16_t EVENT_VAL(uint16_t ev) { return (uint16_t)(ev & 0x0FFF); }
-
-// ---- Event ring (ISR -> main) ----
-#define EVENT_RING_ORDER 11
-#define EVENT_RING_SIZE  (1u << EVENT_RING_ORDER)   // 2048 events
-#define EVENT_RING_MASK  (EVENT_RING_SIZE - 1u)
-static volatile uint16_t eventRing[EVENT_RING_SIZE];
-static volatile uint16_t eventW = 0;
-static volatile uint16_t eventR = 0;
-
-// ---- Output char ring (main -> user read()) ----
-#define CHAR_RING_ORDER 13
-#define CHAR_RING_SIZE  (1u << CHAR_RING_ORDER)     // 8192 chars
-#define CHAR_RING_MASK  (CHAR_RING_SIZE - 1u)
-static volatile char charRing[CHAR_RING_SIZE];
-static volatile uint16_t charW = 0;
-static volatile uint16_t charR = 0;
-
-// ---- I2C state (ISR) ----
-static volatile uint8_t i2cStatus = I2C_IDLE;
-static volatile uint8_t bitCount = 0;
-static volatile uint8_t currentByte = 0;
-static volatile uint16_t byteCountInFrame = 0;
-static volatile uint8_t expectingAck = 0;
-
-// Optional counters (kept, cheap)
-static volatile uint16_t falseStart = 0;
-static volatile uint16_t sclUpCnt = 0;
-static volatile uint16_t sdaUpCnt = 0;
-static volatile uint16_t sdaDownCnt = 0;
-
-// ---- Helpers (ISR-safe) ----
-static inline void IRAM_ATTR push_event(uint16_t ev) {
-    uint16_t next = (uint16_t)((eventW + 1u) & EVENT_RING_MASK);
-    if (next == eventR) { // full -> drop oldest
-        eventR = (uint16_t)((eventR + 1u) & EVENT_RING_MASK);
+    // Full, the newest is dropped and the reader is told where
+    if (lostPending) {
+        if (((w + 2u) & RECORD_RING_MASK) == r || ((w + 1u) & RECORD_RING_MASK) == r) {
+            droppedCount++;
+            return;
+        }
+        recordRing[w] = { timeUs, I2C_SNIFFER_LOST, 0, 0, 0 };
+        w = (uint16_t)((w + 1u) & RECORD_RING_MASK);
+        lostPending = false;
     }
-    eventRing[eventW] = ev;
-    eventW = next;
-}
 
-static inline uint8_t IRAM_ATTR fast_gpio_read(uint8_t pin) {
-    return (uint8_t)gpio_get_level((gpio_num_t)pin);
+    uint16_t next = (uint16_t)((w + 1u) & RECORD_RING_MASK);
+    if (next == r) {
+        droppedCount++;
+        lostPending = true;
+        __atomic_store_n(&recordW, w, __ATOMIC_RELEASE);
+        return;
+    }
+    recordRing[w] = { timeUs, type, value, nack, 0 };
+    __atomic_store_n(&recordW, next, __ATOMIC_RELEASE); // the record is visible before the index
+    recordCount++;
 }
 
-// ---- ISR handlers ----
-void IRAM_ATTR i2cTriggerOnRaisingSCL() {
-    sclUpCnt++;
+static inline uint8_t IRAM_ATTR read_lines() {
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        // Bundle order is SCL then SDA
+        if (bundle) return (uint8_t)((dedic_gpio_cpu_ll_read_in() >> bundleOffset) & 0x3);
+    #endif
 
-    if (i2cStatus == I2C_IDLE) {
-        falseStart++;
-    }
+    uint32_t sclIn = REG_READ(sclReg);
+    uint32_t sdaIn = sameReg ? sclIn : REG_READ(sdaReg);
+    return (uint8_t)(((sclIn & sclMask) ? LINE_SCL : 0) | ((sdaIn & sdaMask) ? LINE_SDA : 0));
+}
 
-    if (expectingAck) {
-        uint8_t ackBit = fast_gpio_read(sniffer_sda_pin); // 0 = ACK, 1 = NACK
-        push_event(PACK_EVENT(TAG_ACK, (uint16_t)ackBit));
-        expectingAck = 0;
-        bitCount = 0;
-        currentByte = 0;
-        return;
-    }
+static void IRAM_ATTR sampler_loop() {
+    const uint32_t stallCycles = cpuMhz * STALL_NS / 1000;
+    const uint32_t windowCycles = cpuMhz * WINDOW_US;
+    const uint32_t maxWindowCycles = cpuMhz * MAX_WINDOW_US;
+
+    // Byte framing state
+    bool busy = false;
+    uint8_t bitCount = 0;
+    uint8_t currentByte = 0;
+    uint16_t byteCount = 0;
+    uint32_t byteUs = 0;
+
+    uint8_t prev = read_lines();
+    uint32_t last = ESP.getCycleCount();
+
+    while (samplerRunning) {
+        uint32_t start = ESP.getCycleCount();
+        uint32_t samples = 0;
+
+        // Whole microseconds only, the remainder stays in the next span
+        uint32_t elapsedUs = (start - baseCycles) / cpuMhz;
+        baseUs += elapsedUs;
+        baseCycles += elapsedUs * cpuMhz;
+
+        if (maskInterrupts) portDISABLE_INTERRUPTS();
+        while (true) {
+            uint8_t lines = read_lines();
+            uint32_t now = ESP.getCycleCount();
+            samples++;
+
+            // Pauses between windows count as well, last is kept across them
+            if (busy && now - last > stallCycles) stallCount++;
+            last = now;
+
+            uint8_t changed = lines ^ prev;
+            if (changed) {
+                if ((changed & LINE_SCL) && (lines & LINE_SCL)) {
+                    // SCL rise, 8 data bits then the ACK bit
+                    uint8_t bit = (lines & LINE_SDA) ? 1 : 0;
+                    if (busy) {
+                        if (bitCount == 0) byteUs = cycles_to_us(now);
+                        if (bitCount < 8) {
+                            currentByte = (uint8_t)((currentByte << 1) | bit);
+                            bitCount++;
+                        } else {
+                            push_record(byteCount == 0 ? I2C_SNIFFER_ADDR : I2C_SNIFFER_DATA, currentByte, bit, byteUs);
+                            byteCount++;
+                            bitCount = 0;
+                            currentByte = 0;
+                        }
+                    }
+                } else if ((changed & LINE_SDA) && (lines & LINE_SCL) && (prev & LINE_SCL)) {
+                    // SDA change while SCL is high, START (also repeated) or STOP
+                    busy = !(lines & LINE_SDA);
+                    push_record(busy ? I2C_SNIFFER_START : I2C_SNIFFER_STOP, 0, 0, cycles_to_us(now));
+                    bitCount = 0;
+                    currentByte = 0;
+                    byteCount = 0;
+                }
+                prev = lines;
+            }
 
-    uint8_t bit = fast_gpio_read(sniffer_sda_pin);
-    currentByte = (uint8_t)((currentByte << 1) | (bit & 0x01));
-    bitCount++;
+            // Interrupts come back between transactions, or after the max window
+            uint32_t elapsed = now - start;
+            if ((elapsed >= windowCycles && !busy) || elapsed >= maxWindowCycles) break;
+        }
+        if (maskInterrupts) portENABLE_INTERRUPTS();
 
-    if (bitCount >= 8) {
-        uint16_t tag = (byteCountInFrame == 0) ? TAG_ADDR : TAG_DATA;
-        push_event(PACK_EVENT(tag, currentByte));
-        byteCountInFrame++;
-        expectingAck = 1;
+        uint32_t windowUs = (last - start) / cpuMhz;
+        if (windowUs) sampleRateKhz = (uint32_t)((uint64_t)samples * 1000 / windowUs);
     }
 }
 
-void IRAM_ATTR i2cTriggerOnChangeSDA() {
-    uint8_t s1 = fast_gpio_read(sniffer_sda_pin);
-    uint8_t s2 = fast_gpio_read(sniffer_sda_pin);
-    if (s1 != s2) s1 = s2;
-
-    if (s1) {
-        sdaUpCnt++;
-        uint8_t scl = fast_gpio_read(sniffer_scl_pin);
-        if (i2cStatus != I2C_IDLE && scl == 1) {
-            push_event(PACK_EVENT(TAG_STOP, 0));
-            i2cStatus = I2C_IDLE;
-            bitCount = 0;
-            currentByte = 0;
-            expectingAck = 0;
-            byteCountInFrame = 0;
+static void sampler_task(void*) {
+    // Cycle counters of the two cores are not in sync, the time base is taken here
+    baseUs = 0;
+    baseCycles = ESP.getCycleCount();
+
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        // The bundle is read by the core that created it
+        int gpios[2] = { sniffer_scl_pin, sniffer_sda_pin };
+        dedic_gpio_bundle_config_t config = {};
+        config.gpio_array = gpios;
+        config.array_size = 2;
+        config.flags.in_en = 1;
+        if (dedic_gpio_new_bundle(&config, &bundle) != ESP_OK) {
+            bundle = nullptr;
+        } else {
+            dedic_gpio_get_in_offset(bundle, &bundleOffset);
         }
-    } else {
-        sdaDownCnt++;
-        uint8_t scl = fast_gpio_read(sniffer_scl_pin);
-        if (i2cStatus == I2C_IDLE && scl == 1) {
-            push_event(PACK_EVENT(TAG_START, 0));
-            i2cStatus = I2C_TRX;
-            bitCount = 0;
-            currentByte = 0;
-            expectingAck = 0;
-            byteCountInFrame = 0;
+    #endif
+
+    sampler_loop();
+
+    #if SOC_DEDICATED_GPIO_SUPPORTED
+        if (bundle) {
+            dedic_gpio_del_bundle(bundle);
+            bundle = nullptr;
         }
-    }
+    #endif
+
+    xSemaphoreGive(samplerStopped);
+    vTaskDelete(nullptr);
 }
 
 // ---- API ----
@@ -164,142 +246,83 @@ void i2c_sniffer_begin(uint8_t scl, uint8_t sda) {
     sniffer_sda_pin = sda;
 }
 
-static void reset_state_and_buffers() {
-    noInterrupts();
-    // I2C state
-    i2cStatus = I2C_IDLE;
-    bitCount = 0;
-    currentByte = 0;
-    byteCountInFrame = 0;
-    expectingAck = 0;
-    // rings
-    eventW = eventR = 0;
-    charW  = charR  = 0;
-    interrupts();
-}
+bool i2c_sniffer_setup() {
+    if (samplerTask) i2c_sniffer_stop();
 
-void i2c_sniffer_setup() {
     pinMode(sniffer_scl_pin, INPUT_PULLUP);
     pinMode(sniffer_sda_pin, INPUT_PULLUP);
-    reset_state_and_buffers();
-    attachInterrupt(digitalPinToInterrupt(sniffer_scl_pin), i2cTriggerOnRaisingSCL, RISING);
-    attachInterrupt(digitalPinToInterrupt(sniffer_sda_pin), i2cTriggerOnChangeSDA, CHANGE);
-}
 
-void i2c_sniffer_stop() {
-    detachInterrupt(digitalPinToInterrupt(sniffer_scl_pin));
-    detachInterrupt(digitalPinToInterrupt(sniffer_sda_pin));
-    noInterrupts();
-    i2cStatus = I2C_IDLE;
-    interrupts();
-}
-
-// ---- Output char ring helpers (main context) ----
-static inline void char_push(char c) {
-    uint16_t next = (uint16_t)((charW + 1u) & CHAR_RING_MASK);
-    if (next == charR) { // full -> drop oldest
-        charR = (uint16_t)((charR + 1u) & CHAR_RING_MASK);
+    sclReg = sniffer_scl_pin < 32 ? GPIO_IN_REG : GPIO_IN1_REG;
+    sdaReg = sniffer_sda_pin < 32 ? GPIO_IN_REG : GPIO_IN1_REG;
+    sclMask = 1u << (sniffer_scl_pin & 31);
+    sdaMask = 1u << (sniffer_sda_pin & 31);
+    sameReg = sclReg == sdaReg;
+
+    recordW = recordR = 0;
+    lostPending = false;
+    recordCount = droppedCount = stallCount = sampleRateKhz = 0;
+
+    cpuMhz = getCpuFrequencyMhz();
+
+    // The sampler never blocks, the idle task of its core is not watched meanwhile
+    samplerCore = xPortGetCoreID() ^ 1;
+
+    // Masking core 0 would starve the WiFi MAC interrupts, the sampler then only relies on its priority
+    wifi_mode_t wifiMode = WIFI_MODE_NULL;
+    bool wifiActive = esp_wifi_get_mode(&wifiMode) == ESP_OK && wifiMode != WIFI_MODE_NULL;
+    maskInterrupts = samplerCore != 0 || !wifiActive;
+
+    if (!samplerStopped) samplerStopped = xSemaphoreCreateBinary();
+    if (!samplerStopped) return false;
+    samplerRunning = true;
+    if (samplerCore == 0) disableCore0WDT();
+    else                  disableCore1WDT();
+
+    if (xTaskCreatePinnedToCore(sampler_task, "i2cSniffer", 4096, nullptr, 1, &samplerTask, samplerCore) != pdPASS) {
+        samplerTask = nullptr;
+        samplerRunning = false;
+        if (samplerCore == 0) enableCore0WDT();
+        else                  enableCore1WDT();
+        return false;
     }
-    charRing[charW] = c;
-    charW = next;
-}
-
-static void text_push_str(const char* s) {
-    while (*s) { char_push(*s++); }
-}
-
-static void text_push_hex8(uint8_t v) {
-    const char* hex = "0123456789ABCDEF";
-    char_push('0'); char_push('x');
-    char_push(hex[(v >> 4) & 0x0F]);
-    char_push(hex[(v     ) & 0x0F]);
+    return true;
 }
 
-// ---- Convert pending events into ASCII (called on demand) ----
-// Format example:
-//   [S]                      (START)
-//   ADDR 0x3C W <ACK>
-//   0x00 <ACK> 0xAB <ACK>  (DATA ...)
-//   [P]\n                    (STOP + newline)
-static void pump_events_to_text() {
-    // Process a bounded number of events per call to avoid long critical sections
-    // (added) keeps latency low while ensuring steady drain.
-    const uint16_t MAX_EVENTS_PER_PUMP = 128;
-    uint16_t processed = 0;
-
-    while (processed < MAX_EVENTS_PER_PUMP) {
-        uint16_t ev;
-        noInterrupts();
-        if (eventR == eventW) { interrupts(); break; }
-        ev = eventRing[eventR];
-        eventR = (uint16_t)((eventR + 1u) & EVENT_RING_MASK);
-        interrupts();
-
-        uint8_t tag = EVENT_TAG(ev);
-        uint16_t val = EVENT_VAL(ev);
-
-        switch (tag) {
-            case TAG_START:
-                text_push_str("[S] ");
-                break;
-
-            case TAG_STOP:
-                text_push_str("[P]");
-                char_push('\r\n'); // newline to separate frames
-                break;
-
-            case TAG_ADDR: {
-                uint8_t b = (uint8_t)val;
-                uint8_t addr = (uint8_t)((b >> 1) & 0x7F);
-                uint8_t rw   = (uint8_t)(b & 0x01);
-                text_push_str("ADDR ");
-                text_push_hex8(addr);
-                char_push(' ');
-                char_push(rw ? 'R' : 'W');
-                char_push(' ');
-                break;
-            }
-
-            case TAG_DATA: {
-                uint8_t b = (uint8_t)val;
-                text_push_hex8(b);
-                char_push(' ');
-                break;
-            }
+void i2c_sniffer_stop() {
+    if (!samplerTask) return;
 
-            case TAG_ACK:
-                text_push_str((val == 0) ? "<ACK> " : "<NACK> ");
-                break;
+    // The sampler leaves at the end of its window, then gives the semaphore
+    samplerRunning = false;
+    xSemaphoreTake(samplerStopped, portMAX_DELAY);
+    samplerTask = nullptr;
 
-            default:
-                // ignore
-                break;
-        }
-        processed++;
-    }
+    if (samplerCore == 0) enableCore0WDT();
+    else                  enableCore1WDT();
 }
 
-bool i2c_sniffer_available() {
-    // If no chars ready, try pumping events into ASCII
-    if (charR == charW) {
-        pump_events_to_text();
-    }
-    return (charR != charW);
-}
+size_t i2c_sniffer_read_records(i2c_sniffer_record_t* out, size_t max) {
+    // The reader owns recordR, the sampler only moves recordW
+    uint16_t r = recordR;
+    uint16_t w = __atomic_load_n(&recordW, __ATOMIC_ACQUIRE);
+    size_t n = 0;
 
-char i2c_sniffer_read() {
-    // Ensure at least one char is present
-    if (charR == charW) {
-        pump_events_to_text();
-    }
-    char out = '\0';
-    if (charR != charW) {
-        out = charRing[charR];
-        charR = (uint16_t)((charR + 1u) & CHAR_RING_MASK);
+    while (r != w && n < max) {
+        out[n++] = recordRing[r];
+        r = (uint16_t)((r + 1u) & RECORD_RING_MASK);
     }
-    return out;
+    __atomic_store_n(&recordR, r, __ATOMIC_RELEASE);
+    return n;
 }
 
 void i2c_sniffer_reset_buffer() {
-    reset_state_and_buffers();
+    __atomic_store_n(&recordR, __atomic_load_n(&recordW, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+}
+
+void i2c_sniffer_get_stats(i2c_sniffer_stats_t* stats) {
+    if (!stats) return;
+    stats->records = recordCount;
+    stats->dropped = droppedCount;
+    stats->stalls = stallCount;
+    stats->sample_rate_khz = sampleRateKhz;
+    stats->interrupts_masked = maskInterrupts;
 }
@@ -14,15 +14,11 @@
  * It means there are 600 ESP32 cycles during one I2C clock tick.
  *
  * 
- * The program uses interrupts to detect
+ * SCL/SDA are polled by a task on the other core, it detects
  * the raise edge of the SCL - bit transfer 
  * the falling edge of SDA if SCL is HIGH- START
  * the raise edge of SDA if SCL id HIGH - STOP 
- * 
- * In the interrupt routines there is just a few line of code
- * that mainly sets the status and stores the incoming bits.
- * Otherwise the program gets timeout panic in interrupt handler and
- * restart the CPU.
+ * and pushes timestamped START/STOP/byte records, read in batches.
  *                   https://github.com/WhitehawkTailor/I2C-sniffer/
  */
 #include <Arduino.h>
@@ -33,12 +29,36 @@
 extern "C" {
 #endif
 
+// ---- Record types ----
+#define I2C_SNIFFER_START 0x1
+#define I2C_SNIFFER_ADDR  0x2 // value is the address byte, R/W in bit 0
+#define I2C_SNIFFER_DATA  0x3
+#define I2C_SNIFFER_STOP  0x4
+#define I2C_SNIFFER_LOST  0x5 // records were dropped before this one
+
+// Binary capture record, 8 bytes, stored as is in capture files
+typedef struct {
+    uint32_t time_us; // since i2c_sniffer_setup(), wraps after ~71 min
+    uint8_t type;
+    uint8_t value;
+    uint8_t nack;     // ADDR/DATA: 1 when the byte was not acknowledged
+    uint8_t reserved;
+} i2c_sniffer_record_t;
+
+typedef struct {
+    uint32_t records;         // START, STOP and bytes seen on the bus
+    uint32_t dropped;         // records lost, the record ring was full
+    uint32_t stalls;          // sampling paused inside a transaction, bits may be missing
+    uint32_t sample_rate_khz; // measured polling rate of SCL/SDA
+    bool interrupts_masked;   // false while WiFi runs, stalls are then more likely
+} i2c_sniffer_stats_t;
+
 void i2c_sniffer_begin(uint8_t scl, uint8_t sda);
-void i2c_sniffer_setup();
+bool i2c_sniffer_setup();
 void i2c_sniffer_stop();
-bool i2c_sniffer_available();
-char i2c_sniffer_read();
+size_t i2c_sniffer_read_records(i2c_sniffer_record_t* out, size_t max);
 void i2c_sniffer_reset_buffer();
+void i2c_sniffer_get_stats(i2c_sniffer_stats_t* stats);
 
 #ifdef __cplusplus
 }
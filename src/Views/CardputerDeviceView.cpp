@@ -10,4 +10,8 @@ void CardputerDeviceView::drawLogicTrace(uint8_t pin, const std::vector<uint8_t>
 void CardputerDeviceView::drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) {
     M5DeviceView::drawAnalogicTrace(pin, buffer, step);
 }
+
+void CardputerDeviceView::drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) {
+    M5DeviceView::drawAnalogicEnvelope(pin, mins, maxs);
+}
 #endif // DEVICE_CARDPUTER
@@ -22,6 +22,7 @@ public:
     // Only this one is implemented
     void drawLogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) override;
     void drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) override;
+    void drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) override;
 };
 
 #endif // DEVICE_CARDPUTER
@@ -114,6 +114,19 @@ void CardputerTerminalView::printPrompt(const std::string& mode) {
     print(mode + "> ");
 }
 
+void CardputerTerminalView::writeBytes(const uint8_t* data, size_t length) {
+    feedFilteredBytes(data, length);
+    dirty = true;
+    maybeRender();
+}
+
+void CardputerTerminalView::flush() {
+    if (!dirty) return;
+    renderAll();
+    lastRenderMs = millis();
+    dirty = false;
+}
+
 void CardputerTerminalView::waitPress() {
     print("\nPress any key to continue...\n");
 }
@@ -33,6 +33,8 @@ public:
     void print(const uint8_t data) override;
     void println(const std::string& text) override;
     void printPrompt(const std::string& mode = "HIZ") override;
+    void writeBytes(const uint8_t* data, size_t length) override;
+    void flush() override;
     void waitPress() override;
     void clear() override;
 
@@ -348,5 +348,35 @@ void M5DeviceView::drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>& bu
     canvas.deleteSprite();
 }
 
+void M5DeviceView::drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) {
+    static constexpr int canvasWidth = 240;
+    static constexpr int canvasHeight = 65;
+
+    M5Canvas canvas(&M5.Lcd);
+    canvas.setColorDepth(8);
+    canvas.createSprite(canvasWidth, canvasHeight);
+    canvas.fillSprite(BACKGROUND_COLOR);
+
+    // One vertical span per column, joined to the previous one
+    int prevLow = -1, prevHigh = -1;
+    for (size_t x = 0; x < mins.size() && x < maxs.size() && x < canvasWidth; ++x) {
+        int low = canvasHeight - 1 - (mins[x] >> 2);
+        int high = canvasHeight - 1 - (maxs[x] >> 2);
+        if (prevLow >= 0) {
+            low = std::max(low, prevHigh);
+            high = std::min(high, prevLow);
+        }
+        canvas.drawFastVLine(x, high, low - high + 1, PRIMARY_COLOR);
+        prevLow = canvasHeight - 1 - (mins[x] >> 2);
+        prevHigh = canvasHeight - 1 - (maxs[x] >> 2);
+    }
+
+    // Pin num
+    canvas.drawString("Pin " + String(pin), 5, 0);
+
+    canvas.pushSprite(0, 35);
+    canvas.deleteSprite();
+}
+
 
 #endif
\ No newline at end of file
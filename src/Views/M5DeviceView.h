@@ -38,6 +38,7 @@ public:
     void topBar(const std::string& title, bool submenu, bool searchBar) override;
     void drawLogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) override;
     void drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) override;
+    void drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) override;
     void horizontalSelection(
         const std::vector<std::string>& options,
         uint16_t selectedIndex,
@@ -20,6 +20,8 @@ void NoScreenDeviceView::drawLogicTrace(uint8_t pin, const std::vector<uint8_t>&
 
 void NoScreenDeviceView::drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) {}
 
+void NoScreenDeviceView::drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) {}
+
 void NoScreenDeviceView::setRotation(uint8_t rotation) {}
 
 void NoScreenDeviceView::setBrightness(uint8_t brightness) {}
@@ -15,6 +15,7 @@ public:
     void clear() override;
     void drawLogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) override;
     void drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>& buffer, uint8_t step) override;
+    void drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) override;
     void setRotation(uint8_t rotation) override;
     void setBrightness(uint8_t brightness) override;
     uint8_t getBrightness() override;
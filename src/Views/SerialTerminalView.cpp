@@ -5,9 +5,16 @@ void SerialTerminalView::initialize() {
     while (!Serial) {
         delay(10);
     }
+
+    esp_timer_create_args_t args = {};
+    args.callback = &SerialTerminalView::onIdleTimer;
+    args.arg = this;
+    args.name = "termFlush";
+    if (esp_timer_create(&args, &idleTimer) != ESP_OK) idleTimer = nullptr;
 }
 
 void SerialTerminalView::welcome(TerminalTypeEnum& terminalType, std::string& terminalInfos) {
+    flush();
 
     GlobalState& state = GlobalState::getInstance();
     std::string version = state.getVersion();
@@ -36,35 +43,106 @@ void SerialTerminalView::welcome(TerminalTypeEnum& terminalType, std::string& te
 }
 
 void SerialTerminalView::print(const std::string& text) {
-    Serial.print(text.c_str());
+    append(reinterpret_cast<const uint8_t*>(text.data()), text.size());
 }
 
 void SerialTerminalView::print(const uint8_t data) {
-    Serial.write(data);
+    append(&data, 1);
 }
 
 void SerialTerminalView::println(const std::string& text) {
-    Serial.println(text.c_str());
+    append(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    append("\r\n");
 }
 
 void SerialTerminalView::printPrompt(const std::string& mode) {
     if (!mode.empty()) {
-        Serial.print(mode.c_str());
-        Serial.print("> ");
+        append(mode.c_str());
+        append("> ");
     } else {
-        Serial.print("> ");
+        append("> ");
+    }
+    flush();
+}
+
+void SerialTerminalView::writeBytes(const uint8_t* data, size_t length) {
+    // Big blocks skip the buffer, after what is already pending
+    if (length >= OUTPUT_BUFFER_SIZE) {
+        xSemaphoreTakeRecursive(outputMutex, portMAX_DELAY);
+        flush();
+        Serial.write(data, length);
+        lastFlushMs = millis();
+        xSemaphoreGiveRecursive(outputMutex);
+        return;
     }
+    append(data, length);
 }
 
 void SerialTerminalView::clear() {
-    Serial.write(27);  // ESC
-    Serial.print("[2J"); // erase screen
-    Serial.write(27);
-    Serial.print("[H");  // default cursor pos
+    append("\x1B[2J"); // erase screen
+    append("\x1B[H");  // default cursor pos
+    flush();
 }
 
 void SerialTerminalView::waitPress() {
-    Serial.println("\n\n\rPress any key to start...");
+    append("\n\n\rPress any key to start...\r\n");
+    flush();
+}
+
+void SerialTerminalView::flush() {
+    xSemaphoreTakeRecursive(outputMutex, portMAX_DELAY);
+    if (outputLength > 0) {
+        Serial.write(outputBuffer, outputLength);
+        outputLength = 0;
+    }
+    pendingNewlines = 0;
+    lastFlushMs = millis();
+    xSemaphoreGiveRecursive(outputMutex);
+}
+
+void SerialTerminalView::flushIfIdle() {
+    xSemaphoreTakeRecursive(outputMutex, portMAX_DELAY);
+    if (outputLength > 0 && millis() - lastFlushMs >= FLUSH_TIMEOUT_MS) {
+        flush();
+    }
+    xSemaphoreGiveRecursive(outputMutex);
+}
+
+void SerialTerminalView::onIdleTimer(void* arg) {
+    auto* view = static_cast<SerialTerminalView*>(arg);
+
+    // A writer holding the lock is appending, it arms the timer again when done
+    if (xSemaphoreTakeRecursive(view->outputMutex, 0) != pdTRUE) return;
+    view->flush();
+    xSemaphoreGiveRecursive(view->outputMutex);
+}
+
+void SerialTerminalView::append(const char* text) {
+    append(reinterpret_cast<const uint8_t*>(text), strlen(text));
+}
+
+void SerialTerminalView::append(const uint8_t* data, size_t length) {
+    xSemaphoreTakeRecursive(outputMutex, portMAX_DELAY);
+    pendingNewlines += std::count(data, data + length, '\n');
+
+    while (length > 0) {
+        size_t n = std::min(length, OUTPUT_BUFFER_SIZE - outputLength);
+        memcpy(outputBuffer + outputLength, data, n);
+        outputLength += n;
+        data += n;
+        length -= n;
+
+        if (outputLength == OUTPUT_BUFFER_SIZE) flush();
+    }
+
+    // Keep interactive output flowing, a few lines or a few ms at most
+    if (pendingNewlines >= FLUSH_NEWLINES || millis() - lastFlushMs >= FLUSH_TIMEOUT_MS) {
+        flush();
+    }
+
+    // Output followed by blocking work still goes out, fails while already armed
+    if (outputLength > 0 && idleTimer) esp_timer_start_once(idleTimer, FLUSH_TIMEOUT_MS * 1000ULL);
+    xSemaphoreGiveRecursive(outputMutex);
 }
 
 void SerialTerminalView::setBaudrate(unsigned long baud) {
@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <string>
+#include <esp_timer.h>
 #include <Interfaces/ITerminalView.h>
 #include <States/GlobalState.h>
 #include <Enums/TerminalTypeEnum.h>
@@ -15,10 +16,32 @@ public:
     void print(const uint8_t data) override;
     void println(const std::string& text) override;
     void printPrompt(const std::string& mode = "HIZ") override;
+    void writeBytes(const uint8_t* data, size_t length) override;
+    void flush() override;
     void clear() override;
     void waitPress() override;
     void setBaudrate(unsigned long baudrate);
+
+    // Flush pending output if nothing was written for a while
+    void flushIfIdle();
     
 private:
+    // Output is coalesced here and written with large Serial.write() calls
+    static constexpr size_t OUTPUT_BUFFER_SIZE = 1024;
+    static constexpr uint8_t FLUSH_NEWLINES = 16;
+    static constexpr uint32_t FLUSH_TIMEOUT_MS = 20;
+
     unsigned long baudrate = 1152200;
+    uint8_t outputBuffer[OUTPUT_BUFFER_SIZE];
+    size_t outputLength = 0;
+    size_t pendingNewlines = 0;
+    uint32_t lastFlushMs = 0;
+
+    // Armed by the first pending byte, flushes output left behind by blocking work
+    esp_timer_handle_t idleTimer = nullptr;
+    SemaphoreHandle_t outputMutex = xSemaphoreCreateRecursiveMutex();
+
+    void append(const uint8_t* data, size_t length);
+    void append(const char* text);
+    static void onIdleTimer(void* arg);
 };
@@ -2,6 +2,7 @@
 
 #include "TembedDeviceView.h"
 #include <Arduino.h>
+#include <algorithm>
 #include "Data/WelcomeScreen.h"
 
 TembedDeviceView::TembedDeviceView() {
@@ -144,6 +145,42 @@ void TembedDeviceView::drawAnalogicTrace(uint8_t pin, const std::vector<uint8_t>
     canvas.deleteSprite();
 }
 
+void TembedDeviceView::drawAnalogicEnvelope(uint8_t pin, const std::vector<uint8_t>& mins, const std::vector<uint8_t>& maxs) {
+    const int canvasWidth = 320;
+    const int canvasHeight = 135;
+
+    canvas.setColorDepth(8);
+    canvas.createSprite(canvasWidth, canvasHeight);
+    canvas.fillSprite(TFT_BLACK);
+
+    // Pin num
+    canvas.setTextColor(TFT_WHITE, TFT_BLACK);
+    canvas.setTextSize(1);
+    canvas.setCursor(10, 0);
+    canvas.print("Pin ");
+    canvas.print(pin);
+
+    // One vertical span per column, joined to the previous one
+    int prevLow = -1, prevHigh = -1;
+    for (size_t i = 0; i < mins.size() && i < maxs.size(); ++i) {
+        int x = 10 + i;
+        if (x >= canvasWidth) break;
+
+        int low = canvasHeight - 1 - (mins[i] >> 1);
+        int high = canvasHeight - 1 - (maxs[i] >> 1);
+        if (prevLow >= 0) {
+            low = std::max(low, prevHigh);
+            high = std::min(high, prevLow);
+        }
+        canvas.drawFastVLine(x, high, low - high + 1, TFT_GREEN);
+        prevLow = canvasHeight - 1 - (mins[i] >> 1);
+        prevHigh = canvasHeight - 1 - (maxs[i] >> 1);
+    }
+
+    canvas.pushSprite(0, 35);
+    canvas.deleteSprite();
+}
+
 void TembedDeviceView::setRotation(uint8_t rotation) {
     tft.setRotation(rotation);
 }
@@ -15,7 +15,7 @@ void WebTerminalView::print(const std::string& text) {
 }
 
 void WebTerminalView::print(const uint8_t data) {
-    server.sendText(std::to_string(data)); // Convert byte to string
+    server.sendBinary(&data, 1);
 }
 
 void WebTerminalView::println(const std::string& text) {
@@ -25,12 +25,23 @@ void WebTerminalView::println(const std::string& text) {
 void WebTerminalView::printPrompt(const std::string& mode) {
     const std::string prompt = mode + "> ";
     server.sendText(prompt);
+    server.flush();
+}
+
+void WebTerminalView::writeBytes(const uint8_t* data, size_t length) {
+    server.sendBinary(data, length);
+}
+
+void WebTerminalView::flush() {
+    server.flush();
 }
 
 void WebTerminalView::clear() {
     server.sendText("[Screen cleared]\n"); // ph
+    server.flush();
 }
 
 void WebTerminalView::waitPress() {
     server.sendText("\n\nPress any key to start...");
+    server.flush();
 }
\ No newline at end of file
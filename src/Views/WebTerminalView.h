@@ -14,9 +14,11 @@ public:
     void print(const uint8_t data) override;
     void println(const std::string& text) override;
     void printPrompt(const std::string& mode) override;
+    void writeBytes(const uint8_t* data, size_t length) override;
+    void flush() override;
     void clear() override;
     void waitPress() override;
     
 private:
-    WebSocketServer server;
+    WebSocketServer& server;
 };
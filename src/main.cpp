@@ -121,7 +121,7 @@ void setup() {
         case TerminalTypeEnum::Serial: {
             // Serial View/Input
             SerialTerminalView serialView;
-            SerialTerminalInput serialInput;
+            SerialTerminalInput serialInput(serialView);
             
             // Baudrate
             auto baud = std::to_string(state.getSerialTerminalBaudRate());
@@ -144,6 +144,7 @@ void setup() {
             // Configure Server
             httpd_handle_t server = nullptr;
             httpd_config_t config = HTTPD_DEFAULT_CONFIG();
+            config.max_uri_handlers = 12;
             if (httpd_start(&server, &config) != ESP_OK) {
                 return;
             }
@@ -169,6 +170,7 @@ void setup() {
             // too big to fit on the stack anymore, allocated on the heap
             DependencyProvider* provider = new DependencyProvider(webView, deviceView, webInput, deviceInput, 
                                                                   usb.usbService, usb.usbController, littleFsService);
+            httpServer.attachLogicAnalyzer(provider->getLogicAnalyzerService());
             ActionDispatcher dispatcher(*provider);
             
             dispatcher.setup(terminalType, webIp);
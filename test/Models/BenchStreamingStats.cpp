@@ -0,0 +1,112 @@
+// Host benchmark for StreamingStats against the collect-and-sort reports it replaced
+//
+//   g++ -std=gnu++17 -O2 -I src test/Models/BenchStreamingStats.cpp -o bench_stats
+//   ./bench_stats
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+#include "../../src/Models/StreamingStats.h"
+
+static size_t heapAllocs = 0;
+
+void* operator new(size_t size) {
+    heapAllocs++;
+    void* p = std::malloc(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+static volatile float sink = 0.f;
+
+using Clock = std::chrono::steady_clock;
+
+static double nsSince(Clock::time_point start, size_t n) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / n;
+}
+
+// Median, base T and MAD the way the analyzers computed them before
+static uint32_t medianOf(std::vector<uint32_t>& v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return (n & 1) ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+}
+
+static void sortedReport(const std::vector<uint32_t>& pulses) {
+    std::vector<uint32_t> tmp = pulses;
+    uint32_t median = medianOf(tmp);
+
+    std::vector<uint32_t> shortest = pulses;
+    std::sort(shortest.begin(), shortest.end());
+    shortest.resize(std::max<size_t>(8, shortest.size() / 4));
+    uint32_t baseT = medianOf(shortest);
+
+    std::vector<uint32_t> dev;
+    dev.reserve(pulses.size());
+    for (auto p : pulses) dev.push_back(p > baseT ? p - baseT : baseT - p);
+    sink = sink + median + baseT + medianOf(dev);
+}
+
+static void streamingReport(const StreamingStats& stats) {
+    float baseT = stats.shortMedian(8);
+    sink = sink + stats.median() + baseT + stats.deviationQuantile(baseT, 0.5f);
+}
+
+static void bench(const char* name, const std::vector<uint32_t>& pulses, int reports) {
+    StreamingStats stats;
+
+    auto start = Clock::now();
+    for (auto p : pulses) stats.add(p);
+    double addNs = nsSince(start, pulses.size());
+
+    heapAllocs = 0;
+    start = Clock::now();
+    for (int i = 0; i < reports; ++i) streamingReport(stats);
+    double streamUs = nsSince(start, reports) / 1000.0;
+    size_t streamAllocs = heapAllocs;
+
+    heapAllocs = 0;
+    start = Clock::now();
+    for (int i = 0; i < reports; ++i) sortedReport(pulses);
+    double sortUs = nsSince(start, reports) / 1000.0;
+    size_t sortAllocs = heapAllocs;
+
+    std::printf("%-10s %8zu pulses  add %5.1f ns  report %8.2f us %3zu allocs  sort %9.2f us %3zu allocs\n",
+                name, pulses.size(), addNs,
+                streamUs, streamAllocs / reports, sortUs, sortAllocs / reports);
+}
+
+int main() {
+    std::mt19937 rng(42);
+
+    // UART like, 1..5 bit times of 8.68 us with jitter
+    std::vector<uint32_t> uart;
+    std::uniform_int_distribution<int> bits(1, 5);
+    std::normal_distribution<float> jitter(0.f, 0.4f);
+    for (int i = 0; i < 200000; ++i) uart.push_back((uint32_t)(bits(rng) * 8.68f + jitter(rng)));
+
+    // Noise, widths over four decades
+    std::vector<uint32_t> noise;
+    std::lognormal_distribution<float> wide(5.f, 2.f);
+    for (int i = 0; i < 200000; ++i) noise.push_back((uint32_t)wide(rng) + 1);
+
+    std::vector<uint32_t> ring(uart.begin(), uart.begin() + 256);
+
+    bench("ring 256", ring, 20000);
+    bench("uart", uart, 50);
+    bench("noise", noise, 50);
+    std::printf("sizeof(StreamingStats) = %zu B\n", sizeof(StreamingStats));
+    return 0;
+}
@@ -0,0 +1,106 @@
+#ifndef TEST_STREAMING_STATS_H
+#define TEST_STREAMING_STATS_H
+
+#include <unity.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+#include "../../src/Models/StreamingStats.h"
+
+static float sortedQuantile(std::vector<uint32_t> v, float p) {
+    std::sort(v.begin(), v.end());
+    return (float)v[(size_t)(p * (v.size() - 1) + 0.5f)];
+}
+
+void test_streaming_stats_empty() {
+    StreamingStats stats;
+
+    TEST_ASSERT_EQUAL_UINT32(0, stats.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.getMin());
+    TEST_ASSERT_EQUAL_FLOAT(0.f, stats.median());
+    TEST_ASSERT_EQUAL_FLOAT(0.f, stats.getVariance());
+    TEST_ASSERT_EQUAL_FLOAT(0.f, stats.deviationQuantile(100.f, 0.5f));
+}
+
+void test_streaming_stats_moments() {
+    StreamingStats stats;
+    const uint32_t values[] = {2, 4, 4, 4, 5, 5, 7, 9};
+    for (auto v : values) stats.add(v);
+
+    TEST_ASSERT_EQUAL_UINT32(8, stats.getCount());
+    TEST_ASSERT_EQUAL_UINT32(2, stats.getMin());
+    TEST_ASSERT_EQUAL_UINT32(9, stats.getMax());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 5.f, stats.getMean());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, 32.f / 7.f, stats.getVariance());
+}
+
+void test_streaming_stats_small_values_exact() {
+    StreamingStats stats;
+    for (uint32_t v = 1; v <= 31; ++v) stats.add(v);
+
+    TEST_ASSERT_EQUAL_FLOAT(16.f, stats.median());
+    TEST_ASSERT_EQUAL_FLOAT(1.f, stats.quantile(0.f));
+    TEST_ASSERT_EQUAL_FLOAT(31.f, stats.quantile(1.f));
+    TEST_ASSERT_EQUAL_FLOAT(4.f, stats.shortMedian(8));
+}
+
+void test_streaming_stats_quantiles_match_sort() {
+    std::mt19937 rng(1234);
+    std::lognormal_distribution<float> dist(6.f, 1.2f);
+    StreamingStats stats;
+    std::vector<uint32_t> values;
+
+    for (int i = 0; i < 20000; ++i) {
+        uint32_t v = (uint32_t)dist(rng) + 1;
+        stats.add(v);
+        values.push_back(v);
+    }
+
+    const float ps[] = {0.05f, 0.25f, 0.5f, 0.75f, 0.95f};
+    for (float p : ps) {
+        float expected = sortedQuantile(values, p);
+        TEST_ASSERT_FLOAT_WITHIN(expected * 0.04f + 1.f, expected, stats.quantile(p));
+    }
+}
+
+void test_streaming_stats_deviation() {
+    StreamingStats stats;
+    // Bit times of 104 us with +-4 us of jitter, MAD is 2
+    for (int i = 0; i < 400; ++i) stats.add(100 + (i % 9));
+
+    float mad = stats.deviationQuantile(104.f, 0.5f);
+    TEST_ASSERT_FLOAT_WITHIN(1.5f, 2.f, mad);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 20.f / 9.f, stats.meanDeviation(104.f));
+}
+
+void test_streaming_stats_fraction_between() {
+    StreamingStats stats;
+    for (int i = 0; i < 80; ++i) stats.add(20000);
+    for (int i = 0; i < 20; ++i) stats.add(1500);
+
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.8f, stats.fractionBetween(15000.f, 25000.f));
+}
+
+void test_streaming_stats_saturated_bin() {
+    StreamingStats stats;
+    for (uint32_t i = 0; i < 200000; ++i) stats.add(10);
+    for (uint32_t i = 0; i < 100; ++i) stats.add(5000);
+
+    TEST_ASSERT_EQUAL_UINT32(200100, stats.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(10.f, stats.median());
+    TEST_ASSERT_FLOAT_WITHIN(160.f, 5000.f, stats.quantile(1.f));
+}
+
+void test_streaming_stats_reset() {
+    StreamingStats stats;
+    for (uint32_t v = 100; v < 200; ++v) stats.add(v);
+    stats.reset();
+    stats.add(7);
+
+    TEST_ASSERT_EQUAL_UINT32(1, stats.getCount());
+    TEST_ASSERT_EQUAL_FLOAT(7.f, stats.median());
+    TEST_ASSERT_EQUAL_UINT32(7, stats.getMax());
+}
+
+#endif
@@ -0,0 +1,77 @@
+// Host benchmark for InstructionTransformer::compile, parse throughput and peak heap
+//
+//   g++ -std=gnu++17 -O2 -I src test/Transformers/BenchInstructionTransformer.cpp -o bench_instr
+//   ./bench_instr
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+#include "../../src/Transformers/InstructionTransformer.cpp"
+
+static size_t heapCurrent = 0;
+static size_t heapPeak = 0;
+static size_t heapAllocs = 0;
+
+void* operator new(size_t size) {
+    size_t* p = static_cast<size_t*>(std::malloc(size + sizeof(size_t)));
+    if (!p) throw std::bad_alloc();
+    *p = size;
+    heapCurrent += size;
+    heapAllocs++;
+    if (heapCurrent > heapPeak) heapPeak = heapCurrent;
+    return p + 1;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (!ptr) return;
+    size_t* p = static_cast<size_t*>(ptr) - 1;
+    heapCurrent -= *p;
+    std::free(p);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+static void bench(const char* name, const std::string& line, int iterations) {
+    InstructionTransformer transformer;
+    std::vector<ByteCode> program;
+
+    size_t baseline = heapCurrent;
+    heapPeak = heapCurrent;
+    heapAllocs = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        std::vector<ByteCode>().swap(program);
+        transformer.compile(line, program);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double mbps = (double)line.size() * iterations / seconds / (1024.0 * 1024.0);
+
+    std::printf("%-16s %7zu chars %6zu codes %8.2f MB/s  peak %7zu B  %5.2f allocs/line\n",
+                name, line.size(), program.size(), mbps,
+                heapPeak - baseline, (double)heapAllocs / iterations);
+}
+
+int main() {
+    std::string shortLine = "[0x9F r:3]";
+
+    std::string writes = "[";
+    for (int i = 0; i < 4096; ++i) writes += "0xA5 ";
+    writes += "]";
+
+    std::string mixed = "[";
+    for (int i = 0; i < 512; ++i) mixed += "0x03 0 0 0 r:256 d:10 'A' \"hello\" ";
+    mixed += "]";
+
+    bench("short", shortLine, 200000);
+    bench("4096 writes", writes, 500);
+    bench("mixed", mixed, 500);
+    return 0;
+}
@@ -1,8 +1,17 @@
 #include <unity.h>
+#include "Models/TestStreamingStats.cpp"
 
 void setup() {
     UNITY_BEGIN();
     // Tests
+    RUN_TEST(test_streaming_stats_empty);
+    RUN_TEST(test_streaming_stats_moments);
+    RUN_TEST(test_streaming_stats_small_values_exact);
+    RUN_TEST(test_streaming_stats_quantiles_match_sort);
+    RUN_TEST(test_streaming_stats_deviation);
+    RUN_TEST(test_streaming_stats_fraction_between);
+    RUN_TEST(test_streaming_stats_saturated_bin);
+    RUN_TEST(test_streaming_stats_reset);
     UNITY_END();
 }
 
@@ -3,7 +3,7 @@
 inline const char* scripts_js = R"rawliteral(
 
 let socket = null;
-let pendingEchoLines = 0;
+let pendingEchoChars = 0;
 let reconnectInterval = 1000; // ms
 let responseTimeout = null;
 let responseTimeoutDelay = 6000; // ms
@@ -20,19 +20,20 @@ const filePanelOverlay = document.getElementById("file-panel-overlay");
 
 function connectSocket() {
   socket = new WebSocket("ws://" + window.location.host + "/ws");
+  socket.binaryType = "arraybuffer";
 
   socket.onopen = function () {
     hideWsLostPopup();
     bridgeMode = false;
-    pendingEchoLines = 0;
+    pendingEchoChars = 0;
     console.log("[WebSocket] Connected");
   };
 
   socket.onmessage = function (event) {
     const output = document.getElementById("output");
-    const lines = event.data.split("\n");
+    let text = decodeFrame(event.data);
 
-    if (event.data.includes("Bridge: Stopped by user.")) {
+    if (text.includes("Bridge: Stopped by user.")) {
       bridgeMode = false;
       console.log("[WebSocket] Bridge mode exited.");
     }
@@ -40,14 +41,17 @@ function connectSocket() {
     clearTimeout(responseTimeout);
     hideWsLostPopup(); 
 
-    if (pendingEchoLines > 0) {
-      pendingEchoLines -= 1;
-      return;
+    // Frames are batched, so the echo can share a frame with the reply
+    if (pendingEchoChars > 0) {
+      const skip = Math.min(pendingEchoChars, text.length);
+      pendingEchoChars -= skip;
+      text = text.slice(skip);
+      if (text.length === 0) return;
     }
 
-    output.value += lines.join("\n");
+    output.value += text;
     output.scrollTop = output.scrollHeight;
-    console.log("[WebSocket] Recv:", event.data);
+    console.log("[WebSocket] Recv:", text.length, "chars");
   };
 
   socket.onerror = function (error) {
@@ -61,6 +65,18 @@ function connectSocket() {
   };
 }
 
+// Text frames are UTF-8 strings, binary frames carry raw bytes (dumps)
+function decodeFrame(data) {
+  if (typeof data === "string") return data;
+
+  const bytes = new Uint8Array(data);
+  let text = "";
+  for (let i = 0; i < bytes.length; i += 8192) {
+    text += String.fromCharCode.apply(null, bytes.subarray(i, i + 8192));
+  }
+  return text;
+}
+
 function showWsLostPopup() {
   if (bridgeMode) return;
   const popup = document.getElementById("ws-lost-popup");
@@ -83,7 +99,7 @@ function sendCommand() {
     clearTimeout(responseTimeout);
     hideWsLostPopup();
     console.log("[WebSocket] Bridge Mode");
-    pendingEchoLines = cmd.length
+    pendingEchoChars = cmd.length
     socket.send(cmd + "\n");
     input.value = "";
     addToHistory(cmd);
@@ -103,9 +119,9 @@ function sendCommand() {
   if (!bridgeMode && !/^\d+$/.test(cmd)) {
     output.value += cmd;
     addToHistory(cmd);
-    pendingEchoLines = cmd.length;
+    pendingEchoChars = cmd.length;
   } else {
-    pendingEchoLines = 0;
+    pendingEchoChars = 0;
   }
 }
 